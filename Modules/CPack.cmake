@@ -168,6 +168,22 @@ installers.  The most commonly-used variables are:
   Supported algorithms are those listed by the
   :ref:`string(\<HASH\>) <Supported Hash Algorithms>` command.
 
+.. variable:: CPACK_COMPRESSION_LEVEL
+
+  The compression level used by the Archive generators and for the data
+  of Debian packages.  The meaning and the range of the level depend on
+  the compression, e.g. ``1`` to ``9`` for gzip and ``1`` to ``22`` for
+  Zstd.  The default, ``0``, selects the default level of the compression.
+
+.. variable:: CPACK_THREADS
+
+  The number of threads used to compress packages.  Only the XZ
+  compression of the Archive generators and of Debian packages uses more
+  than one thread, and only if CMake uses a liblzma with the multithreaded
+  encoder.  A value of ``0`` uses one thread per processor core.
+  The default is ``1``.  Multithreaded XZ compression splits the data into
+  independently compressed blocks, which costs a little compression ratio.
+
 .. variable:: CPACK_PROJECT_CONFIG_FILE
 
   CPack-time project CPack configuration file.  This file is included at cpack
@@ -545,6 +561,7 @@ if(NOT CPACK_GENERATOR)
       option(CPACK_BINARY_TBZ2 "Enable to build TBZ2 packages"    OFF)
       option(CPACK_BINARY_TGZ  "Enable to build TGZ packages"     ON)
       option(CPACK_BINARY_TXZ  "Enable to build TXZ packages"     OFF)
+      option(CPACK_BINARY_TZST "Enable to build TZST packages"    OFF)
     endif()
   else()
     option(CPACK_BINARY_7Z    "Enable to build 7-Zip packages" OFF)
@@ -573,6 +590,7 @@ if(NOT CPACK_GENERATOR)
   cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_TGZ          TGZ)
   cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_TXZ          TXZ)
   cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_TZ           TZ)
+  cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_TZST         TZST)
   cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_WIX          WIX)
   cpack_optional_append(CPACK_GENERATOR  CPACK_BINARY_ZIP          ZIP)
 
@@ -589,6 +607,7 @@ if(NOT CPACK_SOURCE_GENERATOR)
       option(CPACK_SOURCE_TGZ  "Enable to build TGZ source packages"  ON)
       option(CPACK_SOURCE_TXZ  "Enable to build TXZ source packages"  ON)
       option(CPACK_SOURCE_TZ   "Enable to build TZ source packages"   ON)
+      option(CPACK_SOURCE_TZST "Enable to build TZST source packages" OFF)
       option(CPACK_SOURCE_ZIP  "Enable to build ZIP source packages"  OFF)
     endif()
   else()
@@ -603,6 +622,7 @@ if(NOT CPACK_SOURCE_GENERATOR)
   cpack_optional_append(CPACK_SOURCE_GENERATOR  CPACK_SOURCE_TGZ     TGZ)
   cpack_optional_append(CPACK_SOURCE_GENERATOR  CPACK_SOURCE_TXZ     TXZ)
   cpack_optional_append(CPACK_SOURCE_GENERATOR  CPACK_SOURCE_TZ      TZ)
+  cpack_optional_append(CPACK_SOURCE_GENERATOR  CPACK_SOURCE_TZST    TZST)
   cpack_optional_append(CPACK_SOURCE_GENERATOR  CPACK_SOURCE_ZIP     ZIP)
 endif()
 
@@ -626,6 +646,7 @@ mark_as_advanced(
   CPACK_BINARY_TGZ
   CPACK_BINARY_TXZ
   CPACK_BINARY_TZ
+  CPACK_BINARY_TZST
   CPACK_BINARY_WIX
   CPACK_BINARY_ZIP
   CPACK_SOURCE_7Z
@@ -635,6 +656,7 @@ mark_as_advanced(
   CPACK_SOURCE_TGZ
   CPACK_SOURCE_TXZ
   CPACK_SOURCE_TZ
+  CPACK_SOURCE_TZST
   CPACK_SOURCE_ZIP
   )
 
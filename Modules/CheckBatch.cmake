@@ -0,0 +1,194 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+#[=======================================================================[.rst:
+CheckBatch
+----------
+
+Build the test projects of independent checks concurrently.
+
+Each check of the modules listed below configures, generates and builds
+a small test project with :command:`try_compile`, one after the other.
+This module provides macros to queue checks and build all their test
+projects at once, with as many build tools running at a time as the
+host has processor threads.
+
+.. command:: check_batch_begin
+
+  ::
+
+    check_batch_begin()
+
+  Start queueing checks.  Until :command:`check_batch_end` is called,
+  the checks below configure and generate their test project but do
+  not build it, and leave their result variables unset:
+
+  * :command:`check_c_source_compiles`
+  * :command:`check_cxx_source_compiles`
+  * :command:`check_function_exists`
+  * :command:`check_include_file`
+  * :command:`check_include_file_cxx`
+  * :command:`check_symbol_exists`
+  * :command:`check_cxx_symbol_exists`
+  * :command:`check_type_size`
+
+  Other checks run immediately as usual.
+
+.. command:: check_batch_end
+
+  ::
+
+    check_batch_end()
+
+  Run the queued checks again in the order they were queued, with the
+  ``CMAKE_REQUIRED_FLAGS``, ``CMAKE_REQUIRED_DEFINITIONS``,
+  ``CMAKE_REQUIRED_INCLUDES``, ``CMAKE_REQUIRED_LIBRARIES``,
+  ``CMAKE_REQUIRED_QUIET`` and ``CMAKE_EXTRA_INCLUDE_FILES`` variables
+  they were queued with.  The first check builds the test projects of
+  all queued checks concurrently, and each check then takes the result
+  of its own project, reports it and stores it in the cache as if it
+  had been run alone.
+
+  A check whose test project differs from the one it queued, for
+  example because its source depends on the result of another check
+  of the same batch, builds its project again when it is run.  Its
+  result is then the one it would have without the batch, but it is
+  not built concurrently with the others.
+
+Example:
+
+.. code-block:: cmake
+
+  include(CheckBatch)
+  include(CheckIncludeFile)
+  include(CheckSymbolExists)
+
+  check_batch_begin()
+  check_include_file(unistd.h HAVE_UNISTD_H)
+  check_include_file(sys/mman.h HAVE_SYS_MMAN_H)
+  check_symbol_exists(strlcpy string.h HAVE_STRLCPY)
+  check_batch_end()
+#]=======================================================================]
+
+include_guard(GLOBAL)
+
+# The variables a queued check is run again with.
+set_property(GLOBAL PROPERTY _CMAKE_CHECK_BATCH_VARIABLES
+  CMAKE_REQUIRED_FLAGS
+  CMAKE_REQUIRED_DEFINITIONS
+  CMAKE_REQUIRED_INCLUDES
+  CMAKE_REQUIRED_LIBRARIES
+  CMAKE_REQUIRED_QUIET
+  CMAKE_EXTRA_INCLUDE_FILES
+  )
+
+macro(CHECK_BATCH_BEGIN)
+  if(_CMAKE_CHECK_BATCH)
+    message(FATAL_ERROR "check_batch_begin() called before the previous "
+      "batch was ended with check_batch_end().")
+  endif()
+  set(_CMAKE_CHECK_BATCH 1)
+  set_property(GLOBAL PROPERTY _CMAKE_CHECK_BATCH_SIZE 0)
+endmacro()
+
+# Queue a call of the check macro <name> with the given arguments, to
+# be run again by check_batch_end().  The arguments are stored one by
+# one so that arguments holding lists are replayed unchanged.
+function(_CHECK_BATCH_QUEUE name)
+  get_property(i GLOBAL PROPERTY _CMAKE_CHECK_BATCH_SIZE)
+  set(prefix _CMAKE_CHECK_BATCH_${i})
+  math(EXPR size "${i} + 1")
+  set_property(GLOBAL PROPERTY _CMAKE_CHECK_BATCH_SIZE ${size})
+  set_property(GLOBAL PROPERTY ${prefix}_NAME "${name}")
+  math(EXPR argc "${ARGC} - 1")
+  set_property(GLOBAL PROPERTY ${prefix}_ARGC ${argc})
+  foreach(a RANGE 1 ${argc})
+    set_property(GLOBAL PROPERTY ${prefix}_ARG${a} "${ARGV${a}}")
+  endforeach()
+  get_property(vars GLOBAL PROPERTY _CMAKE_CHECK_BATCH_VARIABLES)
+  set(defined "")
+  foreach(v IN LISTS vars)
+    if(DEFINED ${v})
+      list(APPEND defined ${v})
+      set_property(GLOBAL PROPERTY ${prefix}_${v} "${${v}}")
+    endif()
+  endforeach()
+  set_property(GLOBAL PROPERTY ${prefix}_DEFINED "${defined}")
+endfunction()
+
+macro(CHECK_BATCH_END)
+  if(NOT _CMAKE_CHECK_BATCH)
+    message(FATAL_ERROR "check_batch_end() called without check_batch_begin().")
+  endif()
+  unset(_CMAKE_CHECK_BATCH)
+
+  get_property(_CHECK_BATCH_VARIABLES GLOBAL
+    PROPERTY _CMAKE_CHECK_BATCH_VARIABLES)
+  foreach(_CHECK_BATCH_VAR IN LISTS _CHECK_BATCH_VARIABLES)
+    if(DEFINED ${_CHECK_BATCH_VAR})
+      set(_CHECK_BATCH_SAVED_${_CHECK_BATCH_VAR} "${${_CHECK_BATCH_VAR}}")
+    else()
+      unset(_CHECK_BATCH_SAVED_${_CHECK_BATCH_VAR})
+    endif()
+  endforeach()
+
+  get_property(_CHECK_BATCH_SIZE GLOBAL PROPERTY _CMAKE_CHECK_BATCH_SIZE)
+  set(_CHECK_BATCH_I 0)
+  while(_CHECK_BATCH_I LESS _CHECK_BATCH_SIZE)
+    set(_CHECK_BATCH_PREFIX _CMAKE_CHECK_BATCH_${_CHECK_BATCH_I})
+    get_property(_CHECK_BATCH_DEFINED GLOBAL
+      PROPERTY ${_CHECK_BATCH_PREFIX}_DEFINED)
+    foreach(_CHECK_BATCH_VAR IN LISTS _CHECK_BATCH_VARIABLES)
+      list(FIND _CHECK_BATCH_DEFINED ${_CHECK_BATCH_VAR} _CHECK_BATCH_FOUND)
+      if(_CHECK_BATCH_FOUND GREATER -1)
+        get_property(${_CHECK_BATCH_VAR} GLOBAL
+          PROPERTY ${_CHECK_BATCH_PREFIX}_${_CHECK_BATCH_VAR})
+      else()
+        unset(${_CHECK_BATCH_VAR})
+      endif()
+    endforeach()
+
+    # Call the check through a file naming its arguments by variable.
+    get_property(_CHECK_BATCH_NAME GLOBAL PROPERTY ${_CHECK_BATCH_PREFIX}_NAME)
+    get_property(_CHECK_BATCH_ARGC GLOBAL PROPERTY ${_CHECK_BATCH_PREFIX}_ARGC)
+    set(_CHECK_BATCH_FILE
+      "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckBatch/${_CHECK_BATCH_NAME}-${_CHECK_BATCH_ARGC}.cmake")
+    set(_CHECK_BATCH_CALL "${_CHECK_BATCH_NAME}(")
+    foreach(_CHECK_BATCH_A RANGE 1 ${_CHECK_BATCH_ARGC})
+      get_property(_CHECK_BATCH_ARG${_CHECK_BATCH_A} GLOBAL
+        PROPERTY ${_CHECK_BATCH_PREFIX}_ARG${_CHECK_BATCH_A})
+      string(APPEND _CHECK_BATCH_CALL " \"\${_CHECK_BATCH_ARG${_CHECK_BATCH_A}}\"")
+    endforeach()
+    if(NOT EXISTS "${_CHECK_BATCH_FILE}")
+      file(WRITE "${_CHECK_BATCH_FILE}" "${_CHECK_BATCH_CALL})\n")
+    endif()
+    include("${_CHECK_BATCH_FILE}" NO_POLICY_SCOPE)
+    foreach(_CHECK_BATCH_A RANGE 1 ${_CHECK_BATCH_ARGC})
+      unset(_CHECK_BATCH_ARG${_CHECK_BATCH_A})
+    endforeach()
+
+    math(EXPR _CHECK_BATCH_I "${_CHECK_BATCH_I} + 1")
+  endwhile()
+  set_property(GLOBAL PROPERTY _CMAKE_CHECK_BATCH_SIZE 0)
+
+  foreach(_CHECK_BATCH_VAR IN LISTS _CHECK_BATCH_VARIABLES)
+    if(DEFINED _CHECK_BATCH_SAVED_${_CHECK_BATCH_VAR})
+      set(${_CHECK_BATCH_VAR} "${_CHECK_BATCH_SAVED_${_CHECK_BATCH_VAR}}")
+    else()
+      unset(${_CHECK_BATCH_VAR})
+    endif()
+    unset(_CHECK_BATCH_SAVED_${_CHECK_BATCH_VAR})
+  endforeach()
+  unset(_CHECK_BATCH_VARIABLES)
+  unset(_CHECK_BATCH_VAR)
+  unset(_CHECK_BATCH_DEFINED)
+  unset(_CHECK_BATCH_FOUND)
+  unset(_CHECK_BATCH_SIZE)
+  unset(_CHECK_BATCH_I)
+  unset(_CHECK_BATCH_PREFIX)
+  unset(_CHECK_BATCH_NAME)
+  unset(_CHECK_BATCH_ARGC)
+  unset(_CHECK_BATCH_FILE)
+  unset(_CHECK_BATCH_CALL)
+  unset(_CHECK_BATCH_A)
+endmacro()
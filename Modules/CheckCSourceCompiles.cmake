@@ -93,9 +93,10 @@ macro(CHECK_C_SOURCE_COMPILES SOURCE VAR)
     file(WRITE "${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c"
       "${SOURCE}\n")
 
-    if(NOT CMAKE_REQUIRED_QUIET)
+    if(NOT CMAKE_REQUIRED_QUIET AND NOT _CMAKE_CHECK_BATCH)
       message(STATUS "Performing Test ${VAR}")
     endif()
+    set(_CMAKE_TRY_COMPILE_QUEUE ${_CMAKE_CHECK_BATCH})
     try_compile(${VAR}
       ${CMAKE_BINARY_DIR}
       ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/src.c
@@ -104,31 +105,36 @@ macro(CHECK_C_SOURCE_COMPILES SOURCE VAR)
       CMAKE_FLAGS -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_FUNCTION_DEFINITIONS}
       "${CHECK_C_SOURCE_COMPILES_ADD_INCLUDES}"
       OUTPUT_VARIABLE OUTPUT)
+    unset(_CMAKE_TRY_COMPILE_QUEUE)
 
-    foreach(_regex ${_FAIL_REGEX})
-      if("${OUTPUT}" MATCHES "${_regex}")
-        set(${VAR} 0)
-      endif()
-    endforeach()
-
-    if(${VAR})
-      set(${VAR} 1 CACHE INTERNAL "Test ${VAR}")
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Performing Test ${VAR} - Success")
-      endif()
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Performing C SOURCE FILE Test ${VAR} succeeded with the following output:\n"
-        "${OUTPUT}\n"
-        "Source file was:\n${SOURCE}\n")
+    if(_CMAKE_CHECK_BATCH)
+      _check_batch_queue(CHECK_C_SOURCE_COMPILES "${SOURCE}" "${VAR}" ${ARGN})
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Performing Test ${VAR} - Failed")
+      foreach(_regex ${_FAIL_REGEX})
+        if("${OUTPUT}" MATCHES "${_regex}")
+          set(${VAR} 0)
+        endif()
+      endforeach()
+
+      if(${VAR})
+        set(${VAR} 1 CACHE INTERNAL "Test ${VAR}")
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Performing Test ${VAR} - Success")
+        endif()
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+          "Performing C SOURCE FILE Test ${VAR} succeeded with the following output:\n"
+          "${OUTPUT}\n"
+          "Source file was:\n${SOURCE}\n")
+      else()
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Performing Test ${VAR} - Failed")
+        endif()
+        set(${VAR} "" CACHE INTERNAL "Test ${VAR}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+          "Performing C SOURCE FILE Test ${VAR} failed with the following output:\n"
+          "${OUTPUT}\n"
+          "Source file was:\n${SOURCE}\n")
       endif()
-      set(${VAR} "" CACHE INTERNAL "Test ${VAR}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Performing C SOURCE FILE Test ${VAR} failed with the following output:\n"
-        "${OUTPUT}\n"
-        "Source file was:\n${SOURCE}\n")
     endif()
   endif()
 endmacro()
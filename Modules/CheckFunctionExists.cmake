@@ -50,7 +50,7 @@ macro(CHECK_FUNCTION_EXISTS FUNCTION VARIABLE)
   if(NOT DEFINED "${VARIABLE}" OR "x${${VARIABLE}}" STREQUAL "x${VARIABLE}")
     set(MACRO_CHECK_FUNCTION_DEFINITIONS
       "-DCHECK_FUNCTION_EXISTS=${FUNCTION} ${CMAKE_REQUIRED_FLAGS}")
-    if(NOT CMAKE_REQUIRED_QUIET)
+    if(NOT CMAKE_REQUIRED_QUIET AND NOT _CMAKE_CHECK_BATCH)
       message(STATUS "Looking for ${FUNCTION}")
     endif()
     if(CMAKE_REQUIRED_LIBRARIES)
@@ -75,6 +75,7 @@ macro(CHECK_FUNCTION_EXISTS FUNCTION VARIABLE)
       message(FATAL_ERROR "CHECK_FUNCTION_EXISTS needs either C or CXX language enabled")
     endif()
 
+    set(_CMAKE_TRY_COMPILE_QUEUE ${_CMAKE_CHECK_BATCH})
     try_compile(${VARIABLE}
       ${CMAKE_BINARY_DIR}
       ${_cfe_source}
@@ -83,24 +84,29 @@ macro(CHECK_FUNCTION_EXISTS FUNCTION VARIABLE)
       CMAKE_FLAGS -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_FUNCTION_DEFINITIONS}
       "${CHECK_FUNCTION_EXISTS_ADD_INCLUDES}"
       OUTPUT_VARIABLE OUTPUT)
+    unset(_CMAKE_TRY_COMPILE_QUEUE)
     unset(_cfe_source)
 
-    if(${VARIABLE})
-      set(${VARIABLE} 1 CACHE INTERNAL "Have function ${FUNCTION}")
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${FUNCTION} - found")
-      endif()
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the function ${FUNCTION} exists passed with the following output:\n"
-        "${OUTPUT}\n\n")
+    if(_CMAKE_CHECK_BATCH)
+      _check_batch_queue(CHECK_FUNCTION_EXISTS "${FUNCTION}" "${VARIABLE}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${FUNCTION} - not found")
+      if(${VARIABLE})
+        set(${VARIABLE} 1 CACHE INTERNAL "Have function ${FUNCTION}")
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${FUNCTION} - found")
+        endif()
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+          "Determining if the function ${FUNCTION} exists passed with the following output:\n"
+          "${OUTPUT}\n\n")
+      else()
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${FUNCTION} - not found")
+        endif()
+        set(${VARIABLE} "" CACHE INTERNAL "Have function ${FUNCTION}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+          "Determining if the function ${FUNCTION} exists failed with the following output:\n"
+          "${OUTPUT}\n\n")
       endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have function ${FUNCTION}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the function ${FUNCTION} exists failed with the following output:\n"
-        "${OUTPUT}\n\n")
     endif()
   endif()
 endmacro()
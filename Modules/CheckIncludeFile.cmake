@@ -50,7 +50,7 @@ macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
     set(CHECK_INCLUDE_FILE_VAR ${INCLUDE})
     configure_file(${CMAKE_ROOT}/Modules/CheckIncludeFile.c.in
       ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c)
-    if(NOT CMAKE_REQUIRED_QUIET)
+    if(NOT CMAKE_REQUIRED_QUIET AND NOT _CMAKE_CHECK_BATCH)
       message(STATUS "Looking for ${INCLUDE}")
     endif()
     if(${ARGC} EQUAL 3)
@@ -81,6 +81,7 @@ macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
       unset(_CIF_CMP0075)
     endif()
 
+    set(_CMAKE_TRY_COMPILE_QUEUE ${_CMAKE_CHECK_BATCH})
     try_compile(${VARIABLE}
       ${CMAKE_BINARY_DIR}
       ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeTmp/CheckIncludeFile.c
@@ -90,30 +91,35 @@ macro(CHECK_INCLUDE_FILE INCLUDE VARIABLE)
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_INCLUDE_FILE_FLAGS}
       "${CHECK_INCLUDE_FILE_C_INCLUDE_DIRS}"
       OUTPUT_VARIABLE OUTPUT)
+    unset(_CMAKE_TRY_COMPILE_QUEUE)
     unset(_CIF_LINK_LIBRARIES)
 
     if(${ARGC} EQUAL 3)
       set(CMAKE_C_FLAGS ${CMAKE_C_FLAGS_SAVE})
     endif()
 
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${INCLUDE} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the include file ${INCLUDE} "
-        "exists passed with the following output:\n"
-        "${OUTPUT}\n\n")
+    if(_CMAKE_CHECK_BATCH)
+      _check_batch_queue(CHECK_INCLUDE_FILE "${INCLUDE}" "${VARIABLE}" ${ARGN})
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${INCLUDE} - not found")
+      if(${VARIABLE})
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${INCLUDE} - found")
+        endif()
+        set(${VARIABLE} 1 CACHE INTERNAL "Have include ${INCLUDE}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+          "Determining if the include file ${INCLUDE} "
+          "exists passed with the following output:\n"
+          "${OUTPUT}\n\n")
+      else()
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${INCLUDE} - not found")
+        endif()
+        set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+          "Determining if the include file ${INCLUDE} "
+          "exists failed with the following output:\n"
+          "${OUTPUT}\n\n")
       endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have include ${INCLUDE}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the include file ${INCLUDE} "
-        "exists failed with the following output:\n"
-        "${OUTPUT}\n\n")
     endif()
   endif()
 endmacro()
@@ -84,9 +84,10 @@ macro(__CHECK_SYMBOL_EXISTS_IMPL SOURCEFILE SYMBOL FILES VARIABLE)
     configure_file("${CMAKE_ROOT}/Modules/CMakeConfigurableFile.in"
       "${SOURCEFILE}" @ONLY)
 
-    if(NOT CMAKE_REQUIRED_QUIET)
+    if(NOT CMAKE_REQUIRED_QUIET AND NOT _CMAKE_CHECK_BATCH)
       message(STATUS "Looking for ${SYMBOL}")
     endif()
+    set(_CMAKE_TRY_COMPILE_QUEUE ${_CMAKE_CHECK_BATCH})
     try_compile(${VARIABLE}
       ${CMAKE_BINARY_DIR}
       "${SOURCEFILE}"
@@ -96,26 +97,32 @@ macro(__CHECK_SYMBOL_EXISTS_IMPL SOURCEFILE SYMBOL FILES VARIABLE)
       -DCOMPILE_DEFINITIONS:STRING=${MACRO_CHECK_SYMBOL_EXISTS_FLAGS}
       "${CMAKE_SYMBOL_EXISTS_INCLUDES}"
       OUTPUT_VARIABLE OUTPUT)
-    if(${VARIABLE})
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - found")
-      endif()
-      set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
-        "Determining if the ${SYMBOL} "
-        "exist passed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
+    unset(_CMAKE_TRY_COMPILE_QUEUE)
+    if(_CMAKE_CHECK_BATCH)
+      _check_batch_queue(__CHECK_SYMBOL_EXISTS_IMPL "${SOURCEFILE}" "${SYMBOL}"
+        "${FILES}" "${VARIABLE}")
     else()
-      if(NOT CMAKE_REQUIRED_QUIET)
-        message(STATUS "Looking for ${SYMBOL} - not found")
+      if(${VARIABLE})
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${SYMBOL} - found")
+        endif()
+        set(${VARIABLE} 1 CACHE INTERNAL "Have symbol ${SYMBOL}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeOutput.log
+          "Determining if the ${SYMBOL} "
+          "exist passed with the following output:\n"
+          "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+          "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
+      else()
+        if(NOT CMAKE_REQUIRED_QUIET)
+          message(STATUS "Looking for ${SYMBOL} - not found")
+        endif()
+        set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
+        file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
+          "Determining if the ${SYMBOL} "
+          "exist failed with the following output:\n"
+          "${OUTPUT}\nFile ${SOURCEFILE}:\n"
+          "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
       endif()
-      set(${VARIABLE} "" CACHE INTERNAL "Have symbol ${SYMBOL}")
-      file(APPEND ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CMakeError.log
-        "Determining if the ${SYMBOL} "
-        "exist failed with the following output:\n"
-        "${OUTPUT}\nFile ${SOURCEFILE}:\n"
-        "${CMAKE_CONFIGURABLE_FILE_CONTENT}\n")
     endif()
   endif()
 endmacro()
@@ -82,7 +82,7 @@ cmake_policy(SET CMP0054 NEW)
 #-----------------------------------------------------------------------------
 # Helper function.  DO NOT CALL DIRECTLY.
 function(__check_type_size_impl type var map builtin language)
-  if(NOT CMAKE_REQUIRED_QUIET)
+  if(NOT CMAKE_REQUIRED_QUIET AND NOT _CMAKE_CHECK_BATCH)
     message(STATUS "Check size of ${type}")
   endif()
 
@@ -114,6 +114,7 @@ function(__check_type_size_impl type var map builtin language)
   endif()
   set(bin ${CMAKE_BINARY_DIR}${CMAKE_FILES_DIRECTORY}/CheckTypeSize/${var}.bin)
   configure_file(${__check_type_size_dir}/CheckTypeSize.c.in ${src} @ONLY)
+  set(_CMAKE_TRY_COMPILE_QUEUE ${_CMAKE_CHECK_BATCH})
   try_compile(HAVE_${var} ${CMAKE_BINARY_DIR} ${src}
     COMPILE_DEFINITIONS ${CMAKE_REQUIRED_DEFINITIONS}
     LINK_LIBRARIES ${CMAKE_REQUIRED_LIBRARIES}
@@ -123,6 +124,10 @@ function(__check_type_size_impl type var map builtin language)
     OUTPUT_VARIABLE output
     COPY_FILE ${bin}
     )
+  unset(_CMAKE_TRY_COMPILE_QUEUE)
+  if(_CMAKE_CHECK_BATCH)
+    return()
+  endif()
 
   if(HAVE_${var})
     # The check compiled.  Load information from the binary.
@@ -240,6 +245,9 @@ macro(CHECK_TYPE_SIZE TYPE VARIABLE)
   set(_map_file ${CMAKE_BINARY_DIR}/${CMAKE_FILES_DIRECTORY}/CheckTypeSize/${VARIABLE}.cmake)
   if(NOT DEFINED HAVE_${VARIABLE})
     __check_type_size_impl(${TYPE} ${VARIABLE} ${_map_file} ${_builtin} ${_language})
+    if(_CMAKE_CHECK_BATCH)
+      _check_batch_queue(CHECK_TYPE_SIZE "${TYPE}" "${VARIABLE}" ${ARGN})
+    endif()
   endif()
   include(${_map_file} OPTIONAL)
   set(_map_file)
@@ -110,7 +110,13 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
                     << (filename) << ">." << std::endl);                      \
     return 0;                                                                 \
   }                                                                           \
-  cmArchiveWrite archive(gf, this->Compress, this->ArchiveFormat);            \
+  int compressionLevel;                                                       \
+  int numThreads;                                                             \
+  if (!this->GetCompressionSettings(compressionLevel, numThreads)) {          \
+    return 0;                                                                 \
+  }                                                                           \
+  cmArchiveWrite archive(gf, this->Compress, this->ArchiveFormat,             \
+                         compressionLevel, numThreads);                       \
   if (!(archive)) {                                                           \
     cmCPackLogger(cmCPackLog::LOG_ERROR,                                      \
                   "Problem to create archive <"                               \
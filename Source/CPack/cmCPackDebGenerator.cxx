@@ -26,8 +26,8 @@ public:
   DebGenerator(cmCPackLog* logger, std::string const& outputName,
                std::string const& workDir, std::string const& topLevelDir,
                std::string const& temporaryDir,
-               const char* debianCompressionType,
-               const char* debianArchiveType,
+               const char* debianCompressionType, int compressionLevel,
+               int numThreads, const char* debianArchiveType,
                std::map<std::string, std::string> const& controlValues,
                bool genShLibs, std::string const& shLibsFilename,
                bool genPostInst, std::string const& postInst, bool genPostRm,
@@ -63,13 +63,15 @@ private:
   const bool PermissionStrictPolicy;
   const std::vector<std::string> PackageFiles;
   cmArchiveWrite::Compress TarCompressionType;
+  const int CompressionLevel;
+  const int NumThreads;
 };
 
 DebGenerator::DebGenerator(
   cmCPackLog* logger, std::string const& outputName,
   std::string const& workDir, std::string const& topLevelDir,
   std::string const& temporaryDir, const char* debianCompressionType,
-  const char* debianArchiveType,
+  int compressionLevel, int numThreads, const char* debianArchiveType,
   std::map<std::string, std::string> const& controlValues, bool genShLibs,
   std::string const& shLibsFilename, bool genPostInst,
   std::string const& postInst, bool genPostRm, std::string const& postRm,
@@ -91,6 +93,8 @@ DebGenerator::DebGenerator(
   , ControlExtra(controlExtra)
   , PermissionStrictPolicy(permissionStrictPolicy)
   , PackageFiles(packageFiles)
+  , CompressionLevel(compressionLevel)
+  , NumThreads(numThreads)
 {
   if (!debianCompressionType) {
     debianCompressionType = "gzip";
@@ -105,6 +109,9 @@ DebGenerator::DebGenerator(
   } else if (!strcmp(debianCompressionType, "bzip2")) {
     CompressionSuffix = ".bz2";
     TarCompressionType = cmArchiveWrite::CompressBZip2;
+  } else if (!strcmp(debianCompressionType, "zstd")) {
+    CompressionSuffix = ".zst";
+    TarCompressionType = cmArchiveWrite::CompressZstd;
   } else if (!strcmp(debianCompressionType, "gzip")) {
     CompressionSuffix = ".gz";
     TarCompressionType = cmArchiveWrite::CompressGZip;
@@ -174,7 +181,7 @@ bool DebGenerator::generateDataTar() const
     return false;
   }
   cmArchiveWrite data_tar(fileStream_data_tar, TarCompressionType,
-                          DebianArchiveType);
+                          DebianArchiveType, CompressionLevel, NumThreads);
 
   // uid/gid should be the one of the root user, and this root user has
   // always uid/gid equal to 0.
@@ -787,12 +794,19 @@ int cmCPackDebGenerator::createDeb()
            "fi\n";
   }
 
+  int compressionLevel;
+  int numThreads;
+  if (!this->GetCompressionSettings(compressionLevel, numThreads)) {
+    return 0;
+  }
+
   DebGenerator gen(
     Logger, this->GetOption("GEN_CPACK_OUTPUT_FILE_NAME"), strGenWDIR,
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
-    this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
-    this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, gen_shibs,
+    this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"), compressionLevel,
+    numThreads, this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"),
+    controlValues, gen_shibs,
     shlibsfilename, this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTINST"), postinst,
     this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTRM"), postrm,
     this->GetOption("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_EXTRA"),
@@ -842,14 +856,21 @@ int cmCPackDebGenerator::createDbgsymDDeb()
     controlValues["Build-Ids"] = debian_build_ids;
   }
 
+  int compressionLevel;
+  int numThreads;
+  if (!this->GetCompressionSettings(compressionLevel, numThreads)) {
+    return 0;
+  }
+
   DebGenerator gen(
     Logger, this->GetOption("GEN_CPACK_DBGSYM_OUTPUT_FILE_NAME"),
     this->GetOption("GEN_DBGSYMDIR"),
 
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
-    this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
-    this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, false, "",
+    this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"), compressionLevel,
+    numThreads, this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"),
+    controlValues, false, "",
     false, "", false, "", nullptr,
     this->IsSet("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_STRICT_PERMISSION"),
     packageFiles);
@@ -1144,6 +1144,34 @@ bool cmCPackGenerator::IsSet(const std::string& name) const
   return this->MakefileMap->IsSet(name);
 }
 
+bool cmCPackGenerator::GetCompressionSettings(int& compressionLevel,
+                                              int& numThreads)
+{
+  compressionLevel = 0;
+  numThreads = 1;
+  unsigned long value;
+  const char* level = this->GetOption("CPACK_COMPRESSION_LEVEL");
+  if (level && *level) {
+    if (!cmSystemTools::StringToULong(level, &value) || value > 99) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Invalid CPACK_COMPRESSION_LEVEL: " << level
+                                                        << std::endl);
+      return false;
+    }
+    compressionLevel = static_cast<int>(value);
+  }
+  const char* threads = this->GetOption("CPACK_THREADS");
+  if (threads && *threads) {
+    if (!cmSystemTools::StringToULong(threads, &value) || value > 4096) {
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Invalid CPACK_THREADS: " << threads << std::endl);
+      return false;
+    }
+    numThreads = static_cast<int>(value);
+  }
+  return true;
+}
+
 bool cmCPackGenerator::IsOn(const std::string& name) const
 {
   return cmSystemTools::IsOn(GetOption(name));
@@ -165,6 +165,15 @@ protected:
    *       the list of packages generated by the specific generator.
    */
   virtual int PackageFiles();
+
+  /**
+   * Get the compression level and the number of threads to compress
+   * with from CPACK_COMPRESSION_LEVEL and CPACK_THREADS.  The level is 0
+   * and the thread count 1 if the variables are not set.
+   * @return false if one of the values is not a non-negative integer
+   */
+  bool GetCompressionSettings(int& compressionLevel, int& numThreads);
+
   virtual const char* GetInstallPath();
   virtual const char* GetPackagingInstallPrefix();
 
@@ -20,6 +20,7 @@
 #include "cmCPackSTGZGenerator.h"
 #include "cmCPackTGZGenerator.h"
 #include "cmCPackTXZGenerator.h"
+#include "cmCPackTZSTGenerator.h"
 #include "cmCPackTarBZip2Generator.h"
 #include "cmCPackTarCompressGenerator.h"
 #include "cmCPackZIPGenerator.h"
@@ -56,6 +57,10 @@ cmCPackGeneratorFactory::cmCPackGeneratorFactory()
     this->RegisterGenerator("TXZ", "Tar XZ compression",
                             cmCPackTXZGenerator::CreateGenerator);
   }
+  if (cmCPackTZSTGenerator::CanGenerate()) {
+    this->RegisterGenerator("TZST", "Tar Zstd compression",
+                            cmCPackTZSTGenerator::CreateGenerator);
+  }
   if (cmCPackSTGZGenerator::CanGenerate()) {
     this->RegisterGenerator("STGZ", "Self extracting Tar GZip compression",
                             cmCPackSTGZGenerator::CreateGenerator);
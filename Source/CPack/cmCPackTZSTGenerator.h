@@ -0,0 +1,31 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCPackTZSTGenerator_h
+#define cmCPackTZSTGenerator_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmCPackArchiveGenerator.h"
+#include "cmCPackGenerator.h"
+
+/** \class cmCPackTZSTGenerator
+ * \brief A generator for TZST files
+ *
+ */
+class cmCPackTZSTGenerator : public cmCPackArchiveGenerator
+{
+public:
+  cmCPackTypeMacro(cmCPackTZSTGenerator, cmCPackArchiveGenerator);
+  /**
+   * Construct generator
+   */
+  cmCPackTZSTGenerator();
+  ~cmCPackTZSTGenerator() override;
+
+  static bool CanGenerate();
+
+protected:
+  const char* GetOutputExtension() override { return ".tar.zst"; }
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include "cmMakefile.h"
 #include "cmProcessOutput.h"
 #include "cmSystemTools.h"
+#include "cmWorkerPool.h"
 #include "cmXMLWriter.h"
 
 #include "cmsys/Directory.hxx"
@@ -184,14 +185,13 @@ void cmCTestBuildHandler::Initialize()
   this->ReallyCustomWarningExceptions.clear();
   this->ErrorWarningFileLineRegex.clear();
 
-  this->ErrorMatchRegex.clear();
-  this->ErrorExceptionRegex.clear();
-  this->WarningMatchRegex.clear();
-  this->WarningExceptionRegex.clear();
+  this->ErrorMatchRegex.Clear();
+  this->ErrorExceptionRegex.Clear();
+  this->WarningMatchRegex.Clear();
+  this->WarningExceptionRegex.Clear();
   this->BuildProcessingQueue.clear();
   this->BuildProcessingErrorQueue.clear();
   this->BuildOutputLogSize = 0;
-  this->CurrentProcessingLine.clear();
 
   this->SimplifySourceDir.clear();
   this->SimplifyBuildDir.clear();
@@ -357,13 +357,13 @@ int cmCTestBuildHandler::ProcessHandler()
   // Pre-compile regular expressions objects for all regular expressions
 
 #define cmCTestBuildHandlerPopulateRegexVector(strings, regexes)              \
-  regexes.clear();                                                            \
+  (regexes).Clear();                                                          \
   cmCTestOptionalLog(this->CTest, DEBUG,                                      \
                      this << "Add " #regexes << std::endl, this->Quiet);      \
   for (std::string const& s : (strings)) {                                    \
     cmCTestOptionalLog(this->CTest, DEBUG,                                    \
                        "Add " #strings ": " << s << std::endl, this->Quiet);  \
-    (regexes).push_back(s.c_str());                                           \
+    (regexes).Add(s);                                                         \
   }
   cmCTestBuildHandlerPopulateRegexVector(this->CustomErrorMatches,
                                          this->ErrorMatchRegex);
@@ -835,6 +835,22 @@ int cmCTestBuildHandler::RunMakeCommand(const char* command, int* retVal,
   this->WarningQuotaReached = false;
   this->ErrorQuotaReached = false;
 
+  // Scrape the output on a separate thread so that reading it from the
+  // build process rarely waits for the regular expressions.  The single
+  // worker processes the chunks in the order they are read.  Reading
+  // waits once too many chunks are queued, so the memory they take
+  // stays bounded when the build writes faster than it is scraped.
+  cmWorkerPool scraper(1);
+  size_t const maxQueuedChunks = 64;
+  auto processChunk = [&](std::string chunk,
+                          t_BuildProcessingQueueType* queue) {
+    scraper.WaitForQueueSize(maxQueuedChunks - 1);
+    scraper.PushJob([this, chunk, queue, &tick, tick_len, &ofs]() {
+      this->ProcessBuffer(chunk.c_str(), chunk.size(), tick, tick_len, ofs,
+                          queue);
+    });
+  };
+
   // For every chunk of data
   int res;
   while ((res = cmsysProcess_WaitForData(cp, &data, &length, nullptr))) {
@@ -849,24 +865,21 @@ int cmCTestBuildHandler::RunMakeCommand(const char* command, int* retVal,
     // Process the chunk of data
     if (res == cmsysProcess_Pipe_STDERR) {
       processOutput.DecodeText(data, length, strdata, 1);
-      this->ProcessBuffer(strdata.c_str(), strdata.size(), tick, tick_len, ofs,
-                          &this->BuildProcessingErrorQueue);
+      processChunk(strdata, &this->BuildProcessingErrorQueue);
     } else {
       processOutput.DecodeText(data, length, strdata, 2);
-      this->ProcessBuffer(strdata.c_str(), strdata.size(), tick, tick_len, ofs,
-                          &this->BuildProcessingQueue);
+      processChunk(strdata, &this->BuildProcessingQueue);
     }
   }
   processOutput.DecodeText(std::string(), strdata, 1);
   if (!strdata.empty()) {
-    this->ProcessBuffer(strdata.c_str(), strdata.size(), tick, tick_len, ofs,
-                        &this->BuildProcessingErrorQueue);
+    processChunk(strdata, &this->BuildProcessingErrorQueue);
   }
   processOutput.DecodeText(std::string(), strdata, 2);
   if (!strdata.empty()) {
-    this->ProcessBuffer(strdata.c_str(), strdata.size(), tick, tick_len, ofs,
-                        &this->BuildProcessingQueue);
+    processChunk(strdata, &this->BuildProcessingQueue);
   }
+  scraper.WaitForJobs();
 
   this->ProcessBuffer(nullptr, 0, tick, tick_len, ofs,
                       &this->BuildProcessingQueue);
@@ -946,21 +959,19 @@ void cmCTestBuildHandler::ProcessBuffer(const char* data, size_t length,
                                         t_BuildProcessingQueueType* queue)
 {
   const std::string::size_type tick_line_len = 50;
-  const char* ptr;
-  for (ptr = data; ptr < data + length; ptr++) {
-    queue->push_back(*ptr);
+  // Only the new data can complete a line, so start looking for the end
+  // of line where it was appended.
+  std::string::size_type pos = queue->size();
+  if (length > 0) {
+    queue->append(data, length);
   }
   this->BuildOutputLogSize += length;
 
   // until there are any lines left in the buffer
+  std::string::size_type start = 0;
   while (true) {
     // Find the end of line
-    t_BuildProcessingQueueType::iterator it;
-    for (it = queue->begin(); it != queue->end(); ++it) {
-      if (*it == '\n') {
-        break;
-      }
-    }
+    std::string::size_type const end = queue->find('\n', pos);
 
     // Once certain number of errors or warnings reached, ignore future errors
     // or warnings.
@@ -972,20 +983,17 @@ void cmCTestBuildHandler::ProcessBuffer(const char* data, size_t length,
     }
 
     // If the end of line was found
-    if (it != queue->end()) {
-      // Create a contiguous array for the line
-      this->CurrentProcessingLine.clear();
-      this->CurrentProcessingLine.insert(this->CurrentProcessingLine.end(),
-                                         queue->begin(), it);
-      this->CurrentProcessingLine.push_back(0);
-      const char* line = &*this->CurrentProcessingLine.begin();
+    if (end != std::string::npos) {
+      // Terminate the line in place; the queue is not used as a whole
+      // until the processed lines are erased below.
+      (*queue)[end] = 0;
+      const char* line = queue->c_str() + start;
+      start = end + 1;
+      pos = start;
 
       // Process the line
       int lineType = this->ProcessSingleLine(line);
 
-      // Erase the line from the queue
-      queue->erase(queue->begin(), it + 1);
-
       // Depending on the line type, produce error or warning, or nothing
       cmCTestBuildErrorWarning errorwarning;
       bool found = false;
@@ -1047,6 +1055,9 @@ void cmCTestBuildHandler::ProcessBuffer(const char* data, size_t length,
     }
   }
 
+  // Erase the processed lines from the queue
+  queue->erase(0, start);
+
   // Now that the buffer is processed, display missing ticks
   int tickDisplayed = false;
   while (this->BuildOutputLogSize > (tick * tick_len)) {
@@ -1088,27 +1099,24 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
   int warningLine = 0;
   int errorLine = 0;
 
-  // Check for regular expressions
+  // Check for regular expressions.  The exceptions can only change the
+  // result for a line that matched, so they are not checked otherwise.
+  cmCTestBuildMatcher::Line const line(data);
 
   if (!this->ErrorQuotaReached) {
     // Errors
-    int wrxCnt = 0;
-    for (cmsys::RegularExpression& rx : this->ErrorMatchRegex) {
-      if (rx.find(data)) {
-        errorLine = 1;
-        cmCTestOptionalLog(this->CTest, DEBUG,
-                           "  Error Line: " << data << " (matches: "
-                                            << this->CustomErrorMatches[wrxCnt]
-                                            << ")" << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
-    }
-    // Error exceptions
-    wrxCnt = 0;
-    for (cmsys::RegularExpression& rx : this->ErrorExceptionRegex) {
-      if (rx.find(data)) {
+    int wrxCnt = this->ErrorMatchRegex.Find(line);
+    if (wrxCnt >= 0) {
+      errorLine = 1;
+      cmCTestOptionalLog(this->CTest, DEBUG,
+                         "  Error Line: " << data << " (matches: "
+                                          << this->CustomErrorMatches[wrxCnt]
+                                          << ")" << std::endl,
+                         this->Quiet);
+
+      // Error exceptions
+      wrxCnt = this->ErrorExceptionRegex.Find(line);
+      if (wrxCnt >= 0) {
         errorLine = 0;
         cmCTestOptionalLog(this->CTest, DEBUG,
                            "  Not an error Line: "
@@ -1116,32 +1124,24 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
                              << this->CustomErrorExceptions[wrxCnt] << ")"
                              << std::endl,
                            this->Quiet);
-        break;
       }
-      wrxCnt++;
     }
   }
   if (!this->WarningQuotaReached) {
     // Warnings
-    int wrxCnt = 0;
-    for (cmsys::RegularExpression& rx : this->WarningMatchRegex) {
-      if (rx.find(data)) {
-        warningLine = 1;
-        cmCTestOptionalLog(this->CTest, DEBUG,
-                           "  Warning Line: "
-                             << data << " (matches: "
-                             << this->CustomWarningMatches[wrxCnt] << ")"
-                             << std::endl,
-                           this->Quiet);
-        break;
-      }
-      wrxCnt++;
-    }
+    int wrxCnt = this->WarningMatchRegex.Find(line);
+    if (wrxCnt >= 0) {
+      warningLine = 1;
+      cmCTestOptionalLog(this->CTest, DEBUG,
+                         "  Warning Line: "
+                           << data << " (matches: "
+                           << this->CustomWarningMatches[wrxCnt] << ")"
+                           << std::endl,
+                         this->Quiet);
 
-    wrxCnt = 0;
-    // Warning exceptions
-    for (cmsys::RegularExpression& rx : this->WarningExceptionRegex) {
-      if (rx.find(data)) {
+      // Warning exceptions
+      wrxCnt = this->WarningExceptionRegex.Find(line);
+      if (wrxCnt >= 0) {
         warningLine = 0;
         cmCTestOptionalLog(this->CTest, DEBUG,
                            "  Not a warning Line: "
@@ -1149,9 +1149,7 @@ int cmCTestBuildHandler::ProcessSingleLine(const char* data)
                              << this->CustomWarningExceptions[wrxCnt] << ")"
                              << std::endl,
                            this->Quiet);
-        break;
       }
-      wrxCnt++;
     }
   }
   if (errorLine) {
@@ -7,6 +7,7 @@
 
 #include "cmCTestGenericHandler.h"
 
+#include "cmCTestBuildMatcher.h"
 #include "cmDuration.h"
 #include "cmProcessOutput.h"
 #include "cmsys/RegularExpression.hxx"
@@ -105,12 +106,12 @@ private:
   std::vector<std::string> ReallyCustomWarningExceptions;
   std::vector<cmCTestCompileErrorWarningRex> ErrorWarningFileLineRegex;
 
-  std::vector<cmsys::RegularExpression> ErrorMatchRegex;
-  std::vector<cmsys::RegularExpression> ErrorExceptionRegex;
-  std::vector<cmsys::RegularExpression> WarningMatchRegex;
-  std::vector<cmsys::RegularExpression> WarningExceptionRegex;
+  cmCTestBuildMatcher ErrorMatchRegex;
+  cmCTestBuildMatcher ErrorExceptionRegex;
+  cmCTestBuildMatcher WarningMatchRegex;
+  cmCTestBuildMatcher WarningExceptionRegex;
 
-  typedef std::deque<char> t_BuildProcessingQueueType;
+  typedef std::string t_BuildProcessingQueueType;
 
   void ProcessBuffer(const char* data, size_t length, size_t& tick,
                      size_t tick_len, std::ostream& ofs,
@@ -120,7 +121,6 @@ private:
   t_BuildProcessingQueueType BuildProcessingQueue;
   t_BuildProcessingQueueType BuildProcessingErrorQueue;
   size_t BuildOutputLogSize;
-  std::vector<char> CurrentProcessingLine;
 
   std::string SimplifySourceDir;
   std::string SimplifyBuildDir;
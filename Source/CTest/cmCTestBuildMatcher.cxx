@@ -0,0 +1,111 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCTestBuildMatcher.h"
+
+#include <cstring>
+#include <utility>
+
+cmCTestBuildMatcher::Line::Line(const char* text)
+  : Text(text)
+{
+  for (const char* c = text; *c; ++c) {
+    this->Chars.set(static_cast<unsigned char>(*c));
+  }
+}
+
+void cmCTestBuildMatcher::Add(std::string const& regex)
+{
+  Entry entry;
+  entry.Regex.compile(regex);
+  entry.Literal = cmCTestBuildMatcher::RequiredLiteral(regex);
+  for (char c : entry.Literal) {
+    entry.Chars.set(static_cast<unsigned char>(c));
+  }
+  this->Entries.push_back(std::move(entry));
+}
+
+int cmCTestBuildMatcher::Find(Line const& line)
+{
+  int index = 0;
+  for (Entry& entry : this->Entries) {
+    if ((entry.Chars & ~line.Chars).none() &&
+        (entry.Literal.empty() ||
+         strstr(line.Text, entry.Literal.c_str()) != nullptr) &&
+        entry.Regex.find(line.Text)) {
+      return index;
+    }
+    ++index;
+  }
+  return -1;
+}
+
+std::string cmCTestBuildMatcher::RequiredLiteral(std::string const& regex)
+{
+  // Walk the top level of the expression and keep the longest run of
+  // characters that are matched literally and exactly once.  Anything
+  // else ends the current run, so the result is conservative.
+  std::string best;
+  std::string run;
+  auto endRun = [&best, &run]() {
+    if (run.size() > best.size()) {
+      best = run;
+    }
+    run.clear();
+  };
+
+  std::string::size_type const n = regex.size();
+  int depth = 0;
+  std::string::size_type i = 0;
+  while (i < n) {
+    char const c = regex[i];
+    char literal;
+    std::string::size_type len = 1;
+    if (c == '\\') {
+      if (i + 1 == n) {
+        break;
+      }
+      literal = regex[i + 1];
+      len = 2;
+    } else if (c == '[') {
+      // Skip the bracket expression; a ']' right after the opening
+      // '[' or '[^' is part of the set.
+      endRun();
+      ++i;
+      if (i < n && regex[i] == '^') {
+        ++i;
+      }
+      if (i < n && regex[i] == ']') {
+        ++i;
+      }
+      while (i < n && regex[i] != ']') {
+        ++i;
+      }
+      ++i;
+      continue;
+    } else if (c == '|' && depth == 0) {
+      // Top level alternatives have no common literal.
+      return std::string();
+    } else if (strchr("()|.^$*+?", c)) {
+      if (c == '(') {
+        ++depth;
+      } else if (c == ')') {
+        --depth;
+      }
+      endRun();
+      ++i;
+      continue;
+    } else {
+      literal = c;
+    }
+    i += len;
+
+    // A repeated or optional character may not appear exactly once.
+    if (depth != 0 || (i < n && strchr("*+?", regex[i]))) {
+      endRun();
+    } else {
+      run += literal;
+    }
+  }
+  endRun();
+  return best;
+}
@@ -0,0 +1,58 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCTestBuildMatcher_h
+#define cmCTestBuildMatcher_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmsys/RegularExpression.hxx"
+#include <bitset>
+#include <string>
+#include <vector>
+
+/** \class cmCTestBuildMatcher
+ * \brief Find the first of a list of regular expressions in a line.
+ *
+ * For each expression the longest literal that any match must contain
+ * is extracted when it is added.  A line is only handed to the
+ * expressions whose literal characters all occur in it and whose
+ * literal it contains, so most lines of build output are rejected
+ * without running any expression.
+ */
+class cmCTestBuildMatcher
+{
+public:
+  /** A line of output with the set of characters it contains,
+      computed once and shared by all matchers.  */
+  class Line
+  {
+  public:
+    Line(const char* text);
+    const char* Text;
+    std::bitset<256> Chars;
+  };
+
+  void Clear() { this->Entries.clear(); }
+
+  /** Compile \a regex and append it to the list.  */
+  void Add(std::string const& regex);
+
+  /** Return the index of the first expression found in the line, or -1
+      if none of them is found.  */
+  int Find(Line const& line);
+
+  /** Return the literal every match of \a regex must contain, or an
+      empty string if there is none.  */
+  static std::string RequiredLiteral(std::string const& regex);
+
+private:
+  struct Entry
+  {
+    cmsys::RegularExpression Regex;
+    std::string Literal;
+    std::bitset<256> Chars;
+  };
+  std::vector<Entry> Entries;
+};
+
+#endif
@@ -13,10 +13,11 @@
 #include "cmParseJacocoCoverage.h"
 #include "cmParsePHPCoverage.h"
 #include "cmSystemTools.h"
+#include "cmUVProcessPool.h"
 #include "cmWorkingDirectory.h"
 #include "cmXMLWriter.h"
 #include "cmake.h"
-
+#include "cmsys/Directory.hxx"
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 #include "cmsys/Process.h"
@@ -26,6 +27,7 @@
 #include <cstring>
 #include <iomanip>
 #include <iterator>
+#include <map>
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
@@ -113,6 +115,44 @@ private:
   cmDuration TimeOut;
 };
 
+/** Result of a gcov run made ahead of the processing of its file.  */
+struct cmCTestGCovResult
+{
+  cmCTestGCovResult()
+    : Started(false)
+    , RetVal(0)
+  {
+  }
+  bool Started;
+  int RetVal;
+  std::string Output;
+  std::string Errors;
+  std::map<std::string, std::string> GCovFiles;
+};
+
+/** Read the .gcov files written to a directory into a result, and
+    remove them so that the directory can be used by the next run.  */
+static void cmCTestCoverageHandlerTakeGCovFiles(std::string const& directory,
+                                                cmCTestGCovResult& result)
+{
+  cmsys::Directory dir;
+  dir.Load(directory);
+  for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i) {
+    std::string const name = dir.GetFile(i);
+    if (cmSystemTools::GetFilenameLastExtension(name) != ".gcov") {
+      continue;
+    }
+    std::string const path = directory + "/" + name;
+    cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (fin) {
+      result.GCovFiles[name].assign(std::istreambuf_iterator<char>(fin),
+                                    std::istreambuf_iterator<char>());
+    }
+    fin.close();
+    cmSystemTools::RemoveFile(path);
+  }
+}
+
 cmCTestCoverageHandler::cmCTestCoverageHandler()
 {
 }
@@ -1012,16 +1052,26 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   // These are binary files that you give as input to gcov so that it will
   // give us text output we can analyze to summarize coverage.
   //
+  std::vector<std::vector<std::string>> commands;
   for (std::string const& f : files) {
+    std::vector<std::string> covargs = basecovargs;
+    covargs.push_back(cmSystemTools::GetFilenamePath(f));
+    covargs.push_back(f);
+    commands.push_back(std::move(covargs));
+  }
+
+  // Process the output of gcov for each file, and the .gcov files it
+  // wrote, in the order of the files.
+  std::vector<cmCTestGCovResult> results;
+  auto processFile = [&](size_t i) {
+    std::string const& f = files[i];
     cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
                        this->Quiet);
 
     // Call gcov to get coverage data for this *.gcda file:
     //
     std::string fileDir = cmSystemTools::GetFilenamePath(f);
-    std::vector<std::string> covargs = basecovargs;
-    covargs.push_back(fileDir);
-    covargs.push_back(f);
+    std::vector<std::string> const& covargs = commands[i];
     const std::string command = joinCommandLine(covargs);
 
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
@@ -1032,9 +1082,23 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     int retVal = 0;
     *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
     *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(covargs, &output, &errors, &retVal,
-                                      tempDir.c_str(),
-                                      cmDuration::zero() /*this->TimeOut*/);
+    bool res;
+    if (results.empty()) {
+      res = this->CTest->RunCommand(covargs, &output, &errors, &retVal,
+                                    tempDir.c_str(),
+                                    cmDuration::zero() /*this->TimeOut*/);
+    } else {
+      res = results[i].Started;
+      retVal = results[i].RetVal;
+      output.swap(results[i].Output);
+      errors.swap(results[i].Errors);
+      // Leave the .gcov files where gcov writes them in a serial run.
+      for (auto const& g : results[i].GCovFiles) {
+        cmsys::ofstream fout((tempDir + "/" + g.first).c_str(),
+                             std::ios::out | std::ios::binary);
+        fout << g.second;
+      }
+    }
 
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
@@ -1044,7 +1108,7 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
       cmCTestLog(this->CTest, ERROR_MESSAGE,
                  "Command produced error: " << errors << std::endl);
       cont->Error++;
-      continue;
+      return;
     }
     if (retVal != 0) {
       cmCTestLog(this->CTest, ERROR_MESSAGE,
@@ -1206,14 +1270,30 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
                            "   in gcovFile: " << gcovFile << std::endl,
                            this->Quiet);
 
-        cmsys::ifstream ifile(gcovFile.c_str());
-        if (!ifile) {
+        cmsys::ifstream gcovStream;
+        std::istringstream gcovContent;
+        std::istream* ifile = &gcovStream;
+        if (results.empty()) {
+          gcovStream.open(gcovFile.c_str());
+        } else {
+          std::map<std::string, std::string> const& gcovFiles =
+            results[i].GCovFiles;
+          auto const g =
+            gcovFiles.find(cmSystemTools::GetFilenameName(gcovFile));
+          ifile = &gcovContent;
+          if (g != gcovFiles.end()) {
+            gcovContent.str(g->second);
+          } else {
+            gcovContent.setstate(std::ios::failbit);
+          }
+        }
+        if (!*ifile) {
           cmCTestLog(this->CTest, ERROR_MESSAGE,
                      "Cannot open file: " << gcovFile << std::endl);
         } else {
           long cnt = -1;
           std::string nl;
-          while (cmSystemTools::GetLineFromStream(ifile, nl)) {
+          while (cmSystemTools::GetLineFromStream(*ifile, nl)) {
             cnt++;
 
             // TODO: Handle gcov 3.0 non-coverage lines
@@ -1316,6 +1396,61 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
                          this->Quiet);
       cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "    ", this->Quiet);
     }
+  };
+
+  // With a parallel level run gcov for several files at a time.  The
+  // result of each run is processed as soon as those of all files
+  // before it were, so only results that finished out of order are held
+  // back.  Otherwise each file is run when it is processed.
+  //
+  // Each run uses a scratch directory of the slot it runs in, so that
+  // the .gcov files written for the same source by different runs do
+  // not overwrite each other.
+  int const parallelLevel = this->CTest->GetParallelLevel();
+  if (parallelLevel > 1 && files.size() > 1) {
+    std::string const scratchDir = tempDir + "/gcov";
+    results.resize(commands.size());
+    std::vector<bool> finished(commands.size(), false);
+    size_t nextToProcess = 0;
+    cmUVProcessPool pool(
+      commands.size(),
+      [&commands, &scratchDir](size_t index, size_t slot,
+                               std::vector<std::string>& command,
+                               std::string& directory) {
+        command = commands[index];
+        directory = scratchDir + "/" + std::to_string(slot);
+      },
+      [&](size_t index, size_t slot, cmUVProcessPool::Result& poolResult) {
+        cmCTestGCovResult& result = results[index];
+        result.Started = poolResult.Started;
+        result.RetVal = poolResult.RetVal;
+        result.Output = std::move(poolResult.Output);
+        result.Errors = std::move(poolResult.Errors);
+        if (poolResult.TermSignal != 0) {
+          result.Errors += "Terminated by signal ";
+          result.Errors += std::to_string(poolResult.TermSignal);
+        }
+        cmCTestCoverageHandlerTakeGCovFiles(
+          scratchDir + "/" + std::to_string(slot), result);
+        finished[index] = true;
+        for (; nextToProcess < finished.size() && finished[nextToProcess];
+             ++nextToProcess) {
+          processFile(nextToProcess);
+          results[nextToProcess] = cmCTestGCovResult();
+        }
+      });
+    size_t const jobs = static_cast<size_t>(parallelLevel);
+    for (size_t slot = 0; slot < pool.GetSlotCount(jobs); ++slot) {
+      std::string const slotDir = scratchDir + "/" + std::to_string(slot);
+      cmSystemTools::RemoveADirectory(slotDir);
+      cmSystemTools::MakeDirectory(slotDir);
+    }
+    pool.Run(jobs);
+    cmSystemTools::RemoveADirectory(scratchDir);
+  } else {
+    for (size_t i = 0; i < files.size(); ++i) {
+      processFile(i);
+    }
   }
 
   return file_count;
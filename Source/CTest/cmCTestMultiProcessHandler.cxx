@@ -118,11 +118,27 @@ void cmCTestMultiProcessHandler::RunTests()
 #endif
   this->TestHandler->SetMaxIndex(this->FindMaxIndex());
 
+  // Compare the schedule to what the cost data predicts, if shown.
+  double const predicted =
+    this->CTest->GetVerbose() && !this->Quiet ? this->PredictMakespan() : 0;
+  auto const start = std::chrono::steady_clock::now();
+
   uv_loop_init(&this->Loop);
   this->StartNextTests();
   uv_run(&this->Loop, UV_RUN_DEFAULT);
   uv_loop_close(&this->Loop);
 
+  if (predicted > 0) {
+    std::chrono::duration<double> const achieved =
+      std::chrono::steady_clock::now() - start;
+    cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                       "Predicted time to run the tests in parallel: "
+                         << std::fixed << std::setprecision(2) << predicted
+                         << " sec, achieved: " << achieved.count()
+                         << " sec" << std::endl,
+                       this->Quiet);
+  }
+
   this->MarkFinished();
   this->UpdateCostData();
 }
@@ -643,25 +659,123 @@ void cmCTestMultiProcessHandler::CreateParallelTestCostList()
   priorityStack.pop_back();
 
   // Reverse iterate over the different dependency levels (deepest first).
-  // Sort tests within each level by COST and append them to the cost list.
+  TestList levelOrder;
   for (std::list<TestSet>::reverse_iterator i = priorityStack.rbegin();
        i != priorityStack.rend(); ++i) {
     TestSet const& currentSet = *i;
-    TestComparator comp(this);
+    for (auto const& j : currentSet) {
+      if (alreadySortedTests.find(j) == alreadySortedTests.end()) {
+        levelOrder.push_back(j);
+        alreadySortedTests.insert(j);
+      }
+    }
+  }
 
-    TestList sortedCopy;
+  // Start the tests on the longest chains of dependent tests first so
+  // that they do not stretch the total time at the end of the run.
+  // Tests needing more processors go first among equal chains.  Without
+  // cost data this keeps the order of the dependency levels.
+  std::map<int, double> criticalPaths;
+  this->ComputeCriticalPaths(criticalPaths);
+  std::stable_sort(levelOrder.begin(), levelOrder.end(),
+                   [this, &criticalPaths](int a, int b) {
+                     if (criticalPaths[a] != criticalPaths[b]) {
+                       return criticalPaths[a] > criticalPaths[b];
+                     }
+                     return this->GetProcessorsUsed(a) >
+                       this->GetProcessorsUsed(b);
+                   });
+  this->SortedTests.insert(this->SortedTests.end(), levelOrder.begin(),
+                           levelOrder.end());
+}
+
+void cmCTestMultiProcessHandler::ComputeCriticalPaths(
+  std::map<int, double>& criticalPaths)
+{
+  TestMap dependents;
+  for (auto const& t : this->Tests) {
+    for (int dep : t.second) {
+      dependents[dep].insert(t.first);
+    }
+  }
+  for (auto const& t : this->Tests) {
+    this->ComputeCriticalPath(t.first, dependents, criticalPaths);
+  }
+}
 
-    sortedCopy.insert(sortedCopy.end(), currentSet.begin(), currentSet.end());
+double cmCTestMultiProcessHandler::ComputeCriticalPath(
+  int test, TestMap const& dependents, std::map<int, double>& criticalPaths)
+{
+  std::map<int, double>::iterator known = criticalPaths.find(test);
+  if (known != criticalPaths.end()) {
+    return known->second;
+  }
+  // The dependency graph has no cycles, see CheckCycles.
+  double longest = 0;
+  TestMap::const_iterator d = dependents.find(test);
+  if (d != dependents.end()) {
+    for (int dependent : d->second) {
+      longest = std::max(longest,
+                         this->ComputeCriticalPath(dependent, dependents,
+                                                   criticalPaths));
+    }
+  }
+  double const path = this->Properties[test]->Cost + longest;
+  criticalPaths[test] = path;
+  return path;
+}
 
-    std::stable_sort(sortedCopy.begin(), sortedCopy.end(), comp);
+double cmCTestMultiProcessHandler::PredictMakespan()
+{
+  // Start the sorted tests whenever StartNextTests would, assuming each
+  // takes its average time from the cost data.  RESOURCE_LOCK and the
+  // test load are not modeled.
+  bool haveCosts = false;
+  for (int test : this->SortedTests) {
+    haveCosts = haveCosts || this->Properties[test]->PreviousRuns > 0;
+  }
+  if (this->ParallelLevel < 2 || !haveCosts) {
+    return 0;
+  }
 
-    for (auto const& j : sortedCopy) {
-      if (alreadySortedTests.find(j) == alreadySortedTests.end()) {
-        this->SortedTests.push_back(j);
-        alreadySortedTests.insert(j);
+  TestMap waiting = this->Tests;
+  TestList pending = this->SortedTests;
+  std::multimap<double, int> running;
+  size_t runningCount = 0;
+  bool serialRunning = false;
+  double now = 0;
+  for (;;) {
+    for (TestList::iterator i = pending.begin(); i != pending.end();) {
+      int const test = *i;
+      size_t const processors = this->GetProcessorsUsed(test);
+      bool const runSerial = this->Properties[test]->RunSerial;
+      if (serialRunning || runningCount >= this->ParallelLevel) {
+        break;
+      }
+      if (runningCount + processors > this->ParallelLevel ||
+          !waiting[test].empty() || (runSerial && runningCount > 0)) {
+        ++i;
+        continue;
       }
+      running.emplace(now + this->Properties[test]->Cost, test);
+      runningCount += processors;
+      serialRunning = runSerial;
+      i = pending.erase(i);
+    }
+    if (running.empty()) {
+      break;
+    }
+    std::multimap<double, int>::iterator first = running.begin();
+    now = first->first;
+    int const test = first->second;
+    running.erase(first);
+    runningCount -= this->GetProcessorsUsed(test);
+    serialRunning = false;
+    for (auto& w : waiting) {
+      w.second.erase(test);
     }
   }
+  return now;
 }
 
 void cmCTestMultiProcessHandler::GetAllTestDependencies(int test,
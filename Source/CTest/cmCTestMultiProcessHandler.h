@@ -97,6 +97,15 @@ protected:
 
   void CreateParallelTestCostList();
 
+  // Estimate for each test the time needed to run it and the longest
+  // chain of tests that depend on it, directly or indirectly.
+  void ComputeCriticalPaths(std::map<int, double>& criticalPaths);
+  double ComputeCriticalPath(int test, TestMap const& dependents,
+                             std::map<int, double>& criticalPaths);
+
+  // Simulate running the sorted tests with their estimated cost.
+  double PredictMakespan();
+
   // Removes the checkpoint file
   void MarkFinished();
   void EraseTest(int index);
@@ -12,6 +12,7 @@
 #include "cm_zlib.h"
 #include "cmsys/Base64.h"
 #include "cmsys/RegularExpression.hxx"
+#include <algorithm>
 #include <chrono>
 #include <cmAlgorithms.h>
 #include <cstring>
@@ -21,6 +22,10 @@
 #include <stdio.h>
 #include <utility>
 
+// The cost of a test approximates the average duration of its last
+// runs.  Older runs weigh less and less.
+static int const MaxCostHistory = 9;
+
 cmCTestRunTest::cmCTestRunTest(cmCTestMultiProcessHandler& multiHandler)
   : MultiTestHandler(multiHandler)
 {
@@ -394,7 +399,10 @@ bool cmCTestRunTest::NeedsToRerun()
 }
 void cmCTestRunTest::ComputeWeightedCost()
 {
-  double prev = static_cast<double>(this->TestProperties->PreviousRuns);
+  // Weigh the history as if it had at most MaxCostHistory runs so that
+  // the average follows tests whose duration changes over time.
+  double prev = static_cast<double>(
+    std::min(this->TestProperties->PreviousRuns, MaxCostHistory));
   double avgcost = static_cast<double>(this->TestProperties->Cost);
   double current = this->TestResult.ExecutionTime.count();
 
@@ -9,6 +9,7 @@
 #include "cmsys/Directory.hxx"
 #include "cmsys/Encoding.hxx"
 #include "cmsys/FStream.hxx"
+#include <errno.h>
 #include <iostream>
 #include <sstream>
 #include <string.h>
@@ -73,13 +74,16 @@ struct cmArchiveWrite::Callback
 };
 
 cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
-                               std::string const& format)
+                               std::string const& format,
+                               int compressionLevel, int numThreads)
   : Stream(os)
   , Archive(archive_write_new())
   , Disk(archive_read_disk_new())
   , Verbose(false)
   , Format(format)
 {
+  // The name of the filter taking the compression level and threads.
+  const char* filter = nullptr;
   switch (c) {
     case CompressNone:
       if (archive_write_add_filter_none(this->Archive) != ARCHIVE_OK) {
@@ -101,6 +105,7 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
         this->Error += cm_archive_error_string(this->Archive);
         return;
       }
+      filter = "gzip";
       std::string source_date_epoch;
       cmSystemTools::GetEnv("SOURCE_DATE_EPOCH", source_date_epoch);
       if (!source_date_epoch.empty()) {
@@ -120,6 +125,7 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
         this->Error += cm_archive_error_string(this->Archive);
         return;
       }
+      filter = "bzip2";
       break;
     case CompressLZMA:
       if (archive_write_add_filter_lzma(this->Archive) != ARCHIVE_OK) {
@@ -127,6 +133,7 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
         this->Error += cm_archive_error_string(this->Archive);
         return;
       }
+      filter = "lzma";
       break;
     case CompressXZ:
       if (archive_write_add_filter_xz(this->Archive) != ARCHIVE_OK) {
@@ -134,8 +141,35 @@ cmArchiveWrite::cmArchiveWrite(std::ostream& os, Compress c,
         this->Error += cm_archive_error_string(this->Archive);
         return;
       }
+      filter = "xz";
+      break;
+    case CompressZstd:
+      if (!cmArchiveWrite::CanCompressZstd()) {
+        this->Error = "Zstd compression needs libzstd or the zstd program";
+        return;
+      }
+      // Without libzstd this runs the zstd program and warns about it.
+      if (archive_write_add_filter_zstd(this->Archive) < ARCHIVE_WARN) {
+        this->Error = "archive_write_add_filter_zstd: ";
+        this->Error += cm_archive_error_string(this->Archive);
+        return;
+      }
+      filter = "zstd";
       break;
   };
+  if (filter && compressionLevel != 0 &&
+      !this->SetFilterOption(filter, "compression-level", compressionLevel)) {
+    return;
+  }
+  // Only the xz filter takes a number of threads.  It falls back to one
+  // thread without lzma_stream_encoder_mt.  It checks errno to detect an
+  // invalid value, so clear it first.
+  if (c == CompressXZ && numThreads != 1) {
+    errno = 0;
+    if (!this->SetFilterOption(filter, "threads", numThreads)) {
+      return;
+    }
+  }
 #if !defined(_WIN32) || defined(__CYGWIN__)
   if (archive_read_disk_set_standard_lookup(this->Disk) != ARCHIVE_OK) {
     this->Error = "archive_read_disk_set_standard_lookup: ";
@@ -174,6 +208,29 @@ cmArchiveWrite::~cmArchiveWrite()
   archive_write_free(this->Archive);
 }
 
+bool cmArchiveWrite::CanCompressZstd()
+{
+  struct archive* a = archive_write_new();
+  int const r = archive_write_add_filter_zstd(a);
+  archive_write_free(a);
+  // The filter warns that it will run the zstd program without libzstd.
+  return r == ARCHIVE_OK ||
+    (r == ARCHIVE_WARN && !cmSystemTools::FindProgram("zstd").empty());
+}
+
+bool cmArchiveWrite::SetFilterOption(const char* filter, const char* key,
+                                     int value)
+{
+  std::string const v = std::to_string(value);
+  if (archive_write_set_filter_option(this->Archive, filter, key,
+                                      v.c_str()) != ARCHIVE_OK) {
+    this->Error = "archive_write_set_filter_option: ";
+    this->Error += cm_archive_error_string(this->Archive);
+    return false;
+  }
+  return true;
+}
+
 bool cmArchiveWrite::Add(std::string path, size_t skip, const char* prefix,
                          bool recursive)
 {
@@ -52,15 +52,30 @@ public:
     CompressGZip,
     CompressBZip2,
     CompressLZMA,
-    CompressXZ
+    CompressXZ,
+    CompressZstd
   };
 
-  /** Construct with output stream to which to write archive.  */
+  /**
+   * Construct with output stream to which to write archive.  A
+   * "compressionLevel" of 0 selects the default level of the
+   * compression.  The "numThreads" value is the number of threads used
+   * to compress, with 0 meaning one per processor core.  Only the XZ
+   * compression runs on more than one thread, and only if liblzma has
+   * the multithreaded encoder.
+   */
   cmArchiveWrite(std::ostream& os, Compress c = CompressNone,
-                 std::string const& format = "paxr");
+                 std::string const& format = "paxr",
+                 int compressionLevel = 0, int numThreads = 1);
 
   ~cmArchiveWrite();
 
+  /**
+   * Return whether Zstd compression is available, either through
+   * libzstd or by running the zstd program.
+   */
+  static bool CanCompressZstd();
+
   /**
    * Add a path (file or directory) to the archive.  Directories are
    * added recursively.  The "path" must be readable on disk, either
@@ -143,6 +158,7 @@ public:
 
 private:
   bool Okay() const { return this->Error.empty(); }
+  bool SetFilterOption(const char* filter, const char* key, int value);
   bool AddPath(const char* path, size_t skip, const char* prefix,
                bool recursive = true);
   bool AddFile(const char* file, size_t skip, const char* prefix);
@@ -0,0 +1,67 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmBinaryCodec.h"
+
+void cmBinaryWriter::WriteSize(size_t n)
+{
+  for (int i = 0; i < 4; ++i) {
+    this->Out += static_cast<char>((n >> (8 * i)) & 0xff);
+  }
+}
+
+void cmBinaryWriter::WriteString(std::string const& s)
+{
+  this->WriteSize(s.size());
+  this->Out += s;
+}
+
+void cmBinaryWriter::WriteList(std::vector<std::string> const& l)
+{
+  this->WriteSize(l.size());
+  for (std::string const& s : l) {
+    this->WriteString(s);
+  }
+}
+
+bool cmBinaryReader::ReadSize(size_t& n)
+{
+  if (this->GetRemaining() < 4) {
+    return false;
+  }
+  n = 0;
+  for (int i = 0; i < 4; ++i) {
+    n |= static_cast<size_t>(
+           static_cast<unsigned char>(this->Data[this->Pos++]))
+      << (8 * i);
+  }
+  return true;
+}
+
+bool cmBinaryReader::ReadString(std::string& s)
+{
+  size_t n;
+  if (!this->ReadSize(n) || this->GetRemaining() < n) {
+    return false;
+  }
+  s.assign(this->Data, this->Pos, n);
+  this->Pos += n;
+  return true;
+}
+
+bool cmBinaryReader::ReadList(std::vector<std::string>& l)
+{
+  // Each string takes at least the four bytes of its size.
+  size_t n;
+  if (!this->ReadSize(n) || this->GetRemaining() / 4 < n) {
+    return false;
+  }
+  l.clear();
+  l.reserve(n);
+  for (; n > 0; --n) {
+    l.emplace_back();
+    if (!this->ReadString(l.back())) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,63 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmBinaryCodec_h
+#define cmBinaryCodec_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** \class cmBinaryWriter
+ * \brief Append sizes, strings and lists of strings to a buffer.
+ *
+ * Sizes are stored as 32-bit little-endian numbers, and strings and
+ * lists as their size followed by their content.  cmBinaryReader reads
+ * them back.
+ */
+class cmBinaryWriter
+{
+public:
+  explicit cmBinaryWriter(std::string& out)
+    : Out(out)
+  {
+  }
+
+  void WriteSize(size_t n);
+  void WriteString(std::string const& s);
+  void WriteList(std::vector<std::string> const& l);
+
+private:
+  std::string& Out;
+};
+
+/** \class cmBinaryReader
+ * \brief Read what cmBinaryWriter wrote.
+ *
+ * Each method fails if the data end before the value does, so damaged
+ * data never make a reader allocate more than the data hold.
+ */
+class cmBinaryReader
+{
+public:
+  explicit cmBinaryReader(std::string const& data, size_t pos = 0)
+    : Data(data)
+    , Pos(pos)
+  {
+  }
+
+  bool ReadSize(size_t& n);
+  bool ReadString(std::string& s);
+  bool ReadList(std::vector<std::string>& l);
+
+  /** Number of bytes not read yet.  */
+  size_t GetRemaining() const { return this->Data.size() - this->Pos; }
+  bool AtEnd() const { return this->Pos == this->Data.size(); }
+
+private:
+  std::string const& Data;
+  size_t Pos;
+};
+
+#endif
@@ -17,10 +17,27 @@
 #include "cmVersion.h"
 #include "cmake.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmBinaryCodec.h"
+#  include "cmCryptoHash.h"
+#endif
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+namespace {
+char const CacheMirrorMagic[] = "CMakeCacheMirror 2\n";
+
+std::string HashCacheContent(std::string const& content)
+{
+  return cmCryptoHash(cmCryptoHash::AlgoSHA256).HashString(content);
+}
+}
+#endif
+
 cmCacheManager::cmCacheManager()
 {
   this->CacheMajorVersion = 0;
   this->CacheMinorVersion = 0;
+  this->LoadedFromMirror = false;
 }
 
 void cmCacheManager::CleanCMakeFiles(const std::string& path)
@@ -40,6 +57,7 @@ bool cmCacheManager::LoadCache(const std::string& path, bool internal,
 {
   std::string cacheFile = path;
   cacheFile += "/CMakeCache.txt";
+  this->LoadedFromMirror = false;
   // clear the old cache, if we are reading in internal values
   if (internal) {
     this->Cache.clear();
@@ -53,78 +71,65 @@ bool cmCacheManager::LoadCache(const std::string& path, bool internal,
   if (!fin) {
     return false;
   }
-  const char* realbuffer;
-  std::string buffer;
-  std::string entryKey;
-  unsigned int lineno = 0;
-  while (fin) {
-    // Format is key:type=value
-    std::string helpString;
-    CacheEntry e;
-    cmSystemTools::GetLineFromStream(fin, buffer);
-    lineno++;
-    realbuffer = buffer.c_str();
-    while (*realbuffer != '0' &&
-           (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
-            *realbuffer == '\n')) {
-      if (*realbuffer == '\n') {
-        lineno++;
-      }
-      realbuffer++;
-    }
-    // skip blank lines and comment lines
-    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
-      continue;
-    }
-    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
-      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
-        helpString += "\n";
-        helpString += &realbuffer[4];
-      } else {
-        helpString += &realbuffer[2];
-      }
-      cmSystemTools::GetLineFromStream(fin, buffer);
-      lineno++;
-      realbuffer = buffer.c_str();
-      if (!fin) {
-        continue;
-      }
-    }
-    e.SetProperty("HELPSTRING", helpString.c_str());
-    if (cmState::ParseCacheEntry(realbuffer, entryKey, e.Value, e.Type)) {
-      if (excludes.find(entryKey) == excludes.end()) {
-        // Load internal values if internal is set.
-        // If the entry is not internal to the cache being loaded
-        // or if it is in the list of internal entries to be
-        // imported, load it.
-        if (internal || (e.Type != cmStateEnums::INTERNAL) ||
-            (includes.find(entryKey) != includes.end())) {
-          // If we are loading the cache from another project,
-          // make all loaded entries internal so that it is
-          // not visible in the gui
-          if (!internal) {
-            e.Type = cmStateEnums::INTERNAL;
-            helpString = "DO NOT EDIT, ";
-            helpString += entryKey;
-            helpString += " loaded from external file.  "
-                          "To change this value edit this file: ";
-            helpString += path;
-            helpString += "/CMakeCache.txt";
-            e.SetProperty("HELPSTRING", helpString.c_str());
-          }
-          if (!this->ReadPropertyEntry(entryKey, e)) {
-            e.Initialized = true;
-            this->Cache[entryKey] = e;
+  std::vector<FileEntry> entries;
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Parsing a large cache takes much longer than hashing it, so the
+  // parsed entries may be kept in a binary mirror.  The mirror is used
+  // without reading the file while its time stamp and size match, or
+  // else as long as the content of the file still matches.
+  std::string const mirrorFile = GetCacheMirrorFile(path);
+  Mirror mirror;
+  bool const haveMirror = ReadCacheMirror(mirrorFile, mirror);
+  long const mtime = cmSystemTools::ModifiedTime(cacheFile);
+  unsigned long const size = cmSystemTools::FileLength(cacheFile);
+  bool const sameStat =
+    haveMirror && mirror.MTime == mtime && mirror.Size == size;
+  // A file modified no earlier than the mirror was written may have
+  // changed again within the resolution of its time stamp.
+  if (sameStat && mtime < cmSystemTools::ModifiedTime(mirrorFile)) {
+    entries.swap(mirror.Entries);
+    this->LoadedFromMirror = true;
+  } else {
+    std::ostringstream contentStream;
+    contentStream << fin.rdbuf();
+    std::string const content = contentStream.str();
+    std::string const hash = HashCacheContent(content);
+    if (haveMirror && mirror.Hash == hash) {
+      // Write the mirror again so that its time stamp becomes reliable.
+      mirror.MTime = mtime;
+      mirror.Size = size;
+      WriteCacheMirror(mirrorFile, mirror);
+      entries.swap(mirror.Entries);
+      this->LoadedFromMirror = true;
+    } else {
+      std::istringstream fileStream(content);
+      if (ReadCacheFile(fileStream, cacheFile, entries)) {
+        bool enabled = false;
+        for (FileEntry const& fe : entries) {
+          if (fe.Key == "CMAKE_CACHE_BINARY_MIRROR") {
+            enabled = cmSystemTools::IsOn(fe.Value);
+            break;
           }
         }
+        // Do not leave a stale copy behind once the mirror is turned off.
+        if (enabled) {
+          mirror.MTime = mtime;
+          mirror.Size = size;
+          mirror.Hash = hash;
+          mirror.Entries = entries;
+          WriteCacheMirror(mirrorFile, mirror);
+        } else if (cmSystemTools::FileExists(mirrorFile)) {
+          cmSystemTools::RemoveFile(mirrorFile);
+        }
       }
-    } else {
-      std::ostringstream error;
-      error << "Parse error in cache file " << cacheFile;
-      error << " on line " << lineno << ". Offending entry: " << realbuffer;
-      cmSystemTools::Error(error.str().c_str());
     }
   }
+#else
+  ReadCacheFile(fin, cacheFile, entries);
+#endif
+  for (FileEntry const& fe : entries) {
+    this->LoadCacheEntry(path, internal, excludes, includes, fe);
+  }
   this->CacheMajorVersion = 0;
   this->CacheMinorVersion = 0;
   if (const std::string* cmajor =
@@ -176,6 +181,175 @@ bool cmCacheManager::LoadCache(const std::string& path, bool internal,
   return true;
 }
 
+bool cmCacheManager::ReadCacheFile(std::istream& fin,
+                                   std::string const& cacheFile,
+                                   std::vector<FileEntry>& entries)
+{
+  bool parsed = true;
+  const char* realbuffer;
+  std::string buffer;
+  unsigned int lineno = 0;
+  while (fin) {
+    // Format is key:type=value
+    FileEntry fe;
+    cmSystemTools::GetLineFromStream(fin, buffer);
+    lineno++;
+    realbuffer = buffer.c_str();
+    while (*realbuffer != '0' &&
+           (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
+            *realbuffer == '\n')) {
+      if (*realbuffer == '\n') {
+        lineno++;
+      }
+      realbuffer++;
+    }
+    // skip blank lines and comment lines
+    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
+      continue;
+    }
+    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
+      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
+        fe.HelpString += "\n";
+        fe.HelpString += &realbuffer[4];
+      } else {
+        fe.HelpString += &realbuffer[2];
+      }
+      cmSystemTools::GetLineFromStream(fin, buffer);
+      lineno++;
+      realbuffer = buffer.c_str();
+      if (!fin) {
+        continue;
+      }
+    }
+    if (cmState::ParseCacheEntry(realbuffer, fe.Key, fe.Value, fe.Type)) {
+      entries.push_back(std::move(fe));
+    } else {
+      std::ostringstream error;
+      error << "Parse error in cache file " << cacheFile;
+      error << " on line " << lineno << ". Offending entry: " << realbuffer;
+      cmSystemTools::Error(error.str().c_str());
+      parsed = false;
+    }
+  }
+  return parsed;
+}
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+std::string cmCacheManager::GetCacheMirrorFile(std::string const& path)
+{
+  std::string mirrorFile = path;
+  mirrorFile += cmake::GetCMakeFilesDirectory();
+  mirrorFile += "/CMakeCache.bin";
+  return mirrorFile;
+}
+
+bool cmCacheManager::ReadCacheMirror(std::string const& mirrorFile,
+                                     Mirror& mirror)
+{
+  std::string in;
+  {
+    cmsys::ifstream fin(mirrorFile.c_str(), std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    std::ostringstream inStream;
+    inStream << fin.rdbuf();
+    in = inStream.str();
+  }
+  size_t const magicSize = sizeof(CacheMirrorMagic) - 1;
+  if (in.compare(0, magicSize, CacheMirrorMagic) != 0) {
+    return false;
+  }
+  // The time stamp and size may not fit a size, so they are stored as
+  // decimal strings.
+  cmBinaryReader reader(in, magicSize);
+  std::string mtime;
+  std::string size;
+  size_t count;
+  if (!reader.ReadString(mtime) ||
+      !cmSystemTools::StringToLong(mtime.c_str(), &mirror.MTime) ||
+      !reader.ReadString(size) ||
+      !cmSystemTools::StringToULong(size.c_str(), &mirror.Size) ||
+      !reader.ReadString(mirror.Hash) || !reader.ReadSize(count) ||
+      count > reader.GetRemaining() / 16) { // four sizes per entry
+    return false;
+  }
+  mirror.Entries.resize(count);
+  for (FileEntry& fe : mirror.Entries) {
+    size_t type;
+    if (!reader.ReadString(fe.Key) || !reader.ReadString(fe.Value) ||
+        !reader.ReadString(fe.HelpString) || !reader.ReadSize(type) ||
+        type > cmStateEnums::UNINITIALIZED) {
+      return false;
+    }
+    fe.Type = static_cast<cmStateEnums::CacheEntryType>(type);
+  }
+  return reader.AtEnd();
+}
+
+void cmCacheManager::WriteCacheMirror(std::string const& mirrorFile,
+                                      Mirror const& mirror)
+{
+  std::string out = CacheMirrorMagic;
+  cmBinaryWriter writer(out);
+  writer.WriteString(std::to_string(mirror.MTime));
+  writer.WriteString(std::to_string(mirror.Size));
+  writer.WriteString(mirror.Hash);
+  writer.WriteSize(mirror.Entries.size());
+  for (FileEntry const& fe : mirror.Entries) {
+    writer.WriteString(fe.Key);
+    writer.WriteString(fe.Value);
+    writer.WriteString(fe.HelpString);
+    writer.WriteSize(fe.Type);
+  }
+
+  // The mirror is only an optimization, so failing to write it is fine.
+  cmSystemTools::MakeDirectory(cmSystemTools::GetFilenamePath(mirrorFile));
+  cmGeneratedFileStream fout;
+  fout.Open(mirrorFile, true, true);
+  fout.write(out.data(), static_cast<std::streamsize>(out.size()));
+  fout.Close();
+}
+#endif
+
+void cmCacheManager::LoadCacheEntry(std::string const& path, bool internal,
+                                    std::set<std::string>& excludes,
+                                    std::set<std::string>& includes,
+                                    FileEntry const& fe)
+{
+  if (excludes.find(fe.Key) != excludes.end()) {
+    return;
+  }
+  // Load internal values if internal is set.
+  // If the entry is not internal to the cache being loaded
+  // or if it is in the list of internal entries to be
+  // imported, load it.
+  if (internal || (fe.Type != cmStateEnums::INTERNAL) ||
+      (includes.find(fe.Key) != includes.end())) {
+    CacheEntry e;
+    e.Value = fe.Value;
+    e.Type = fe.Type;
+    e.SetProperty("HELPSTRING", fe.HelpString.c_str());
+    // If we are loading the cache from another project,
+    // make all loaded entries internal so that it is
+    // not visible in the gui
+    if (!internal) {
+      e.Type = cmStateEnums::INTERNAL;
+      std::string helpString = "DO NOT EDIT, ";
+      helpString += fe.Key;
+      helpString += " loaded from external file.  "
+                    "To change this value edit this file: ";
+      helpString += path;
+      helpString += "/CMakeCache.txt";
+      e.SetProperty("HELPSTRING", helpString.c_str());
+    }
+    if (!this->ReadPropertyEntry(fe.Key, e)) {
+      e.Initialized = true;
+      this->Cache[fe.Key] = e;
+    }
+  }
+}
+
 const char* cmCacheManager::PersistentProperties[] = { "ADVANCED", "MODIFIED",
                                                        "STRINGS", nullptr };
 
@@ -358,6 +532,18 @@ bool cmCacheManager::SaveCache(const std::string& path, cmMessenger* messenger)
   }
   fout << "\n";
   fout.Close();
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // The mirror is written on the next load, but a stale one must not
+  // stay behind once it is turned off.
+  std::string const* mirror =
+    this->GetInitializedCacheValue("CMAKE_CACHE_BINARY_MIRROR");
+  if (!mirror || !cmSystemTools::IsOn(*mirror)) {
+    std::string const mirrorFile = GetCacheMirrorFile(path);
+    if (cmSystemTools::FileExists(mirrorFile)) {
+      cmSystemTools::RemoveFile(mirrorFile);
+    }
+  }
+#endif
   std::string checkCacheFile = path;
   checkCacheFile += cmake::GetCMakeFilesDirectory();
   cmSystemTools::MakeDirectory(checkCacheFile);
@@ -202,6 +202,9 @@ public:
   unsigned int GetCacheMajorVersion() const { return this->CacheMajorVersion; }
   unsigned int GetCacheMinorVersion() const { return this->CacheMinorVersion; }
 
+  /** Whether the last load used the binary mirror of the cache file.  */
+  bool IsLoadedFromMirror() const { return this->LoadedFromMirror; }
+
 protected:
   ///! Add an entry into the cache
   void AddCacheEntry(const std::string& key, const char* value,
@@ -216,6 +219,7 @@ protected:
   // Cache version info
   unsigned int CacheMajorVersion;
   unsigned int CacheMinorVersion;
+  bool LoadedFromMirror;
 
 private:
   typedef std::map<std::string, CacheEntry> CacheEntryMap;
@@ -233,6 +237,36 @@ private:
   static void OutputValueNoNewlines(std::ostream& fout,
                                     std::string const& value);
 
+  // An entry as written in a cache file.
+  struct FileEntry
+  {
+    std::string Key;
+    std::string Value;
+    std::string HelpString;
+    cmStateEnums::CacheEntryType Type;
+  };
+  static bool ReadCacheFile(std::istream& fin, std::string const& cacheFile,
+                            std::vector<FileEntry>& entries);
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  static std::string GetCacheMirrorFile(std::string const& path);
+  // The binary mirror of a cache file, with the time stamp, size and
+  // hash of the file content the entries were parsed from.
+  struct Mirror
+  {
+    long MTime;
+    unsigned long Size;
+    std::string Hash;
+    std::vector<FileEntry> Entries;
+  };
+  static bool ReadCacheMirror(std::string const& mirrorFile, Mirror& mirror);
+  static void WriteCacheMirror(std::string const& mirrorFile,
+                               Mirror const& mirror);
+#endif
+  void LoadCacheEntry(std::string const& path, bool internal,
+                      std::set<std::string>& excludes,
+                      std::set<std::string>& includes,
+                      FileEntry const& fe);
+
   static const char* PersistentProperties[];
   bool ReadPropertyEntry(std::string const& key, CacheEntry& e);
   void WritePropertyEntries(std::ostream& os, CacheIterator i,
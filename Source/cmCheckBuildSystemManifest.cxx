@@ -0,0 +1,85 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmCheckBuildSystemManifest.h"
+
+#include "cmBinaryCodec.h"
+#include "cmFileTimeComparison.h"
+#include "cmGeneratedFileStream.h"
+
+#include "cmsys/FStream.hxx"
+#include <iterator>
+#include <stddef.h>
+
+namespace {
+char const Magic[] = "CMakeCheckBuildSystemManifest 1\n";
+}
+
+std::string cmCheckBuildSystemManifest::GetManifestFile(
+  std::string const& checkFile)
+{
+  return checkFile + ".manifest";
+}
+
+bool cmCheckBuildSystemManifest::Write(std::string const& checkFile) const
+{
+  std::string stamp;
+  if (!cmFileTimeComparison::FileTimeStamp(checkFile.c_str(), stamp)) {
+    return false;
+  }
+  std::string out = Magic;
+  cmBinaryWriter writer(out);
+  writer.WriteString(stamp);
+  writer.WriteList(this->Products);
+  writer.WriteList(this->Depends);
+  writer.WriteList(this->Outputs);
+  writer.WriteList(this->DependHashes);
+
+  cmGeneratedFileStream fout;
+  fout.Open(GetManifestFile(checkFile), false, true);
+  fout.write(out.data(), static_cast<std::streamsize>(out.size()));
+  return fout.Close();
+}
+
+bool cmCheckBuildSystemManifest::Read(std::string const& checkFile)
+{
+  std::string data;
+  {
+    cmsys::ifstream fin(GetManifestFile(checkFile).c_str(),
+                        std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(fin),
+                std::istreambuf_iterator<char>());
+  }
+  size_t const magicSize = sizeof(Magic) - 1;
+  if (data.compare(0, magicSize, Magic) != 0) {
+    return false;
+  }
+
+  // The check file is rewritten on every generate step, so a different
+  // stamp means it was written without this manifest.
+  cmBinaryReader reader(data, magicSize);
+  std::string stamp;
+  std::string current;
+  if (!reader.ReadString(stamp) ||
+      !cmFileTimeComparison::FileTimeStamp(checkFile.c_str(), current) ||
+      stamp != current) {
+    return false;
+  }
+  std::vector<std::string> products;
+  std::vector<std::string> depends;
+  std::vector<std::string> outputs;
+  std::vector<std::string> dependHashes;
+  if (!reader.ReadList(products) || !reader.ReadList(depends) ||
+      !reader.ReadList(outputs) || !reader.ReadList(dependHashes) ||
+      !reader.AtEnd() ||
+      (!dependHashes.empty() && dependHashes.size() != depends.size())) {
+    return false;
+  }
+  this->Products.swap(products);
+  this->Depends.swap(depends);
+  this->Outputs.swap(outputs);
+  this->DependHashes.swap(dependHashes);
+  return true;
+}
@@ -0,0 +1,44 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmCheckBuildSystemManifest_h
+#define cmCheckBuildSystemManifest_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <vector>
+
+/** \class cmCheckBuildSystemManifest
+ * \brief Compact copy of the lists read by cmake --check-build-system.
+ *
+ * The file given to --check-build-system sets the byproducts, the
+ * dependencies and the outputs of the generate step in CMake language,
+ * which takes a full interpreter to read.  A generator that writes it
+ * also writes the same lists to a binary manifest next to it, with the
+ * time stamp of the file when the manifest was written.  The check
+ * reads the manifest instead as long as the file did not change since.
+ */
+class cmCheckBuildSystemManifest
+{
+public:
+  std::vector<std::string> Products;
+  std::vector<std::string> Depends;
+  std::vector<std::string> Outputs;
+
+  /** Hashes of the content of the dependencies when the build system
+      was generated, if recorded, in the order of Depends.  An empty
+      hash marks a dependency whose time stamp alone counts.  */
+  std::vector<std::string> DependHashes;
+
+  /** Write the manifest of the complete, closed check file.  */
+  bool Write(std::string const& checkFile) const;
+
+  /** Read the manifest of the check file.  Fails if there is none or if
+      the check file was modified after the manifest was written.  */
+  bool Read(std::string const& checkFile);
+
+private:
+  static std::string GetManifestFile(std::string const& checkFile);
+};
+
+#endif
@@ -194,6 +194,9 @@ cmComputeLinkDepends::cmComputeLinkDepends(const cmGeneratorTarget* target,
   // Assume no compatibility until set.
   this->OldLinkDirMode = false;
 
+  // The result may be shared until it depends on the target itself.
+  this->TargetSpecific = false;
+
   // No computation has been done.
   this->CCG = nullptr;
 }
@@ -212,6 +215,21 @@ void cmComputeLinkDepends::SetOldLinkDirMode(bool b)
 std::vector<cmComputeLinkDepends::LinkEntry> const&
 cmComputeLinkDepends::Compute()
 {
+  // Targets in the same directory that link the same items usually get
+  // the same result, so share it between them.
+  std::string const sharedKey = this->GetSharedKey();
+  std::map<std::string, EntryVector>* shared = nullptr;
+  if (!sharedKey.empty()) {
+    cmGlobalGenerator* gg =
+      this->Target->GetLocalGenerator()->GetGlobalGenerator();
+    shared = &gg->GetSharedLinkDepends();
+    std::map<std::string, EntryVector>::const_iterator i =
+      shared->find(sharedKey);
+    if (i != shared->end() && !this->IsListedIn(i->second)) {
+      return i->second;
+    }
+  }
+
   // Follow the link dependencies of the target to be linked.
   this->AddDirectLinkEntries();
 
@@ -277,9 +295,58 @@ cmComputeLinkDepends::Compute()
     this->DisplayFinalEntries();
   }
 
+  if (shared && !this->TargetSpecific) {
+    shared->insert(std::make_pair(sharedKey, this->FinalLinkEntries));
+  }
+
   return this->FinalLinkEntries;
 }
 
+std::string cmComputeLinkDepends::GetSharedKey() const
+{
+  // Share results only once the targets do not change any more.  Debug
+  // output and CMake 2.4 compatibility are specific to each target.
+  cmLocalGenerator* lg = this->Target->GetLocalGenerator();
+  cmGlobalGenerator* gg = lg->GetGlobalGenerator();
+  if (!gg->GetGeneratorExpressionMemo().IsEnabled() || this->DebugMode ||
+      this->OldLinkDirMode) {
+    return std::string();
+  }
+
+  // Items are looked up in the scope of the directory, so the result
+  // depends on it, the configuration and the items linked directly.
+  std::string key = lg->GetCurrentBinaryDirectory();
+  key += '\0';
+  key += this->Config;
+  cmLinkImplementation const* impl =
+    this->Target->GetLinkImplementation(this->Config);
+  for (cmLinkImplItem const& lib : impl->Libraries) {
+    key += '\0';
+    key += lib.Target ? gg->IndexGeneratorTargetUniquely(lib.Target)
+                      : lib.AsStr();
+  }
+  return key;
+}
+
+bool cmComputeLinkDepends::IsListedIn(EntryVector const& entries) const
+{
+  // The target would have skipped itself while following the items.
+  std::string const& name = this->Target->GetName();
+  for (LinkEntry const& e : entries) {
+    if (e.Item == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void cmComputeLinkDepends::CheckHeadSensitive(cmLinkInterface const* iface)
+{
+  if (iface->HadHeadSensitiveCondition) {
+    this->TargetSpecific = true;
+  }
+}
+
 std::map<cmLinkItem, int>::iterator cmComputeLinkDepends::AllocateLinkEntry(
   cmLinkItem const& item)
 {
@@ -347,6 +414,7 @@ void cmComputeLinkDepends::FollowLinkEntry(BFSEntry qe)
     // Follow the target dependencies.
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      this->CheckHeadSensitive(iface);
       const bool isIface =
         entry.Target->GetType() == cmStateEnums::INTERFACE_LIBRARY;
       // This target provides its own link interface information.
@@ -365,7 +433,9 @@ void cmComputeLinkDepends::FollowLinkEntry(BFSEntry qe)
       }
     }
   } else {
-    // Follow the old-style dependency list.
+    // Follow the old-style dependency list.  Its items are resolved
+    // with the policies of the target.
+    this->TargetSpecific = true;
     this->AddVarLinkEntries(depender_index, qe.LibDepends);
   }
 }
@@ -427,6 +497,7 @@ void cmComputeLinkDepends::HandleSharedDependency(SharedDepEntry const& dep)
   if (entry.Target) {
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      this->CheckHeadSensitive(iface);
       // Follow public and private dependencies transitively.
       this->FollowSharedDeps(index, iface, true);
     }
@@ -515,7 +586,11 @@ void cmComputeLinkDepends::AddLinkEntries(int depender_index,
     // Skip entries that will resolve to the target getting linked or
     // are empty.
     cmLinkItem const& item = l;
-    if (item.AsStr() == this->Target->GetName() || item.AsStr().empty()) {
+    if (item.AsStr() == this->Target->GetName()) {
+      this->TargetSpecific = true;
+      continue;
+    }
+    if (item.AsStr().empty()) {
       continue;
     }
 
@@ -816,6 +891,7 @@ int cmComputeLinkDepends::ComputeComponentCount(NodeList const& nl)
     if (cmGeneratorTarget const* target = this->EntryList[ni].Target) {
       if (cmLinkInterface const* iface =
             target->GetLinkInterface(this->Config, this->Target)) {
+        this->CheckHeadSensitive(iface);
         if (iface->Multiplicity > count) {
           count = iface->Multiplicity;
         }
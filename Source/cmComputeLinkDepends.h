@@ -162,11 +162,17 @@ private:
   std::set<cmGeneratorTarget const*> OldWrongConfigItems;
   void CheckWrongConfigItem(cmLinkItem const& item);
 
+  // Sharing of results between targets linking the same items.
+  std::string GetSharedKey() const;
+  bool IsListedIn(EntryVector const& entries) const;
+  void CheckHeadSensitive(cmLinkInterface const* iface);
+
   int ComponentOrderId;
   cmTargetLinkLibraryType LinkType;
   bool HasConfig;
   bool DebugMode;
   bool OldLinkDirMode;
+  bool TargetSpecific;
 };
 
 #endif
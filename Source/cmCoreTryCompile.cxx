@@ -3,6 +3,8 @@
 #include "cmCoreTryCompile.h"
 
 #include "cmsys/Directory.hxx"
+#include "cmsys/FStream.hxx"
+#include <iterator>
 #include <set>
 #include <sstream>
 #include <stdio.h>
@@ -21,6 +23,10 @@
 #include "cmVersion.h"
 #include "cmake.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmTryCompileResultCache.h"
+#endif
+
 static std::string const kCMAKE_C_COMPILER_EXTERNAL_TOOLCHAIN =
   "CMAKE_C_COMPILER_EXTERNAL_TOOLCHAIN";
 static std::string const kCMAKE_C_COMPILER_TARGET = "CMAKE_C_COMPILER_TARGET";
@@ -67,11 +73,101 @@ std::string cmCoreTryCompile::LookupStdVar(std::string const& var,
   return value;
 }
 
+std::string cmCoreTryCompile::ComputeProjectKey(
+  std::string const& targetName, std::vector<std::string> const& sources,
+  std::vector<std::string> const& cmakeFlags) const
+{
+  // The project files name the directory and the target of the project,
+  // which differ between a queued project and the same one run directly,
+  // and may name files of the build tree, which differ between trees.
+  std::string const& buildDirectory =
+    this->Makefile->GetHomeOutputDirectory();
+  std::string key =
+    this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
+  key += '\0';
+  std::vector<std::string> files;
+  files.push_back(this->BinaryDirectory + "/CMakeLists.txt");
+  std::string const targetsFile =
+    this->BinaryDirectory + "/" + targetName + "Targets.cmake";
+  if (cmSystemTools::FileExists(targetsFile)) {
+    files.push_back(targetsFile);
+  }
+  files.insert(files.end(), sources.begin(), sources.end());
+  for (std::string const& f : files) {
+    // ReplaceString stops at a null character, so the name and the
+    // content are rewritten before they are joined.
+    std::string name = f;
+    cmSystemTools::ReplaceString(name, this->BinaryDirectory, "<DIR>");
+    cmSystemTools::ReplaceString(name, buildDirectory, "<BUILD>");
+    cmsys::ifstream fin(f.c_str(), std::ios::in | std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(fin)),
+                        std::istreambuf_iterator<char>());
+    cmSystemTools::ReplaceString(content, this->BinaryDirectory, "<DIR>");
+    cmSystemTools::ReplaceString(content, buildDirectory, "<BUILD>");
+    cmSystemTools::ReplaceString(content, targetName, "<TARGET>");
+    key += name;
+    key += '\0';
+    key += content;
+    key += '\0';
+  }
+  for (std::string const& flag : cmakeFlags) {
+    key += flag;
+    key += '\0';
+  }
+  return key;
+}
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+std::unique_ptr<cmTryCompileResultCache> cmCoreTryCompile::CreateResultCache(
+  std::string const& projectKey, std::set<std::string> const& langs) const
+{
+  std::unique_ptr<cmTryCompileResultCache> cache;
+  std::string dir =
+    this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CACHE_DIR");
+  if (dir.empty()) {
+    cmSystemTools::GetEnv("CMAKE_TRY_COMPILE_CACHE_DIR", dir);
+  }
+  if (dir.empty()) {
+    return cache;
+  }
+
+  // Besides the project itself, the build depends on the toolchain.
+  cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
+  std::vector<std::string> inputs;
+  inputs.push_back(projectKey);
+  inputs.push_back(gg->GetName());
+  std::string const toolchainFile =
+    this->Makefile->GetSafeDefinition("CMAKE_TOOLCHAIN_FILE");
+  inputs.push_back(toolchainFile);
+  if (!toolchainFile.empty()) {
+    cmsys::ifstream fin(toolchainFile.c_str(),
+                        std::ios::in | std::ios::binary);
+    inputs.emplace_back(std::istreambuf_iterator<char>(fin),
+                        std::istreambuf_iterator<char>());
+  }
+  for (std::string const& lang : langs) {
+    std::string const compiler =
+      this->Makefile->GetSafeDefinition("CMAKE_" + lang + "_COMPILER");
+    inputs.push_back(lang);
+    inputs.push_back(compiler);
+    for (char const* suffix : { "_COMPILER_ARG1", "_COMPILER_ID",
+                                "_COMPILER_VERSION" }) {
+      inputs.push_back(
+        this->Makefile->GetSafeDefinition("CMAKE_" + lang + suffix));
+    }
+    inputs.push_back(gg->GetTryCompileToolHash(compiler));
+  }
+  cache = cm::make_unique<cmTryCompileResultCache>(dir, inputs);
+  return cache;
+}
+#endif
+
 int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
                                      bool isTryRun)
 {
   this->BinaryDirectory = argv[1];
   this->OutputFile.clear();
+  this->QueuedInBatch = false;
   // which signature were we called with ?
   this->SrcFileSignature = true;
 
@@ -138,6 +234,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   bool didCudaExtensions = false;
   bool useSources = argv[2] == "SOURCES";
   std::vector<std::string> sources;
+  std::set<std::string> testLangs;
 
   enum Doing
   {
@@ -374,11 +471,25 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     return -1;
   }
 
+  // A check queued in a batch of checks generates its test project in a
+  // directory of its own, to be built later with the other queued ones.
+  cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
+  bool const queue = this->SrcFileSignature && !isTryRun &&
+    this->Makefile->IsOn("_CMAKE_TRY_COMPILE_QUEUE");
+  std::string tmpDirectory;
+
   // compute the binary dir when TRY_COMPILE is called with a src file
   // signature
   if (this->SrcFileSignature) {
     this->BinaryDirectory += cmake::GetCMakeFilesDirectory();
-    this->BinaryDirectory += "/CMakeTmp";
+    tmpDirectory = this->BinaryDirectory + "/CMakeTmp";
+    if (queue) {
+      this->BinaryDirectory += "/CMakeTmpBatch/";
+      this->BinaryDirectory += std::to_string(gg->GetQueuedTryCompileCount());
+      cmSystemTools::RemoveADirectory(this->BinaryDirectory);
+    } else {
+      this->BinaryDirectory = tmpDirectory;
+    }
   } else {
     // only valid for srcfile signatures
     if (!compileDefs.empty()) {
@@ -418,9 +529,22 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       sources.push_back(argv[2]);
     }
 
+    // The temporary sources of a queued project may be replaced by the
+    // next check before it is built, so it gets copies of them.
+    if (queue) {
+      std::string const prefix = tmpDirectory + "/";
+      for (std::string& si : sources) {
+        if (cmSystemTools::StringStartsWith(si, prefix.c_str())) {
+          std::string const copy =
+            this->BinaryDirectory + "/" + si.substr(prefix.size());
+          cmSystemTools::MakeDirectory(cmSystemTools::GetFilenamePath(copy));
+          cmSystemTools::CopyFileAlways(si, copy);
+          si = copy;
+        }
+      }
+    }
+
     // Detect languages to enable.
-    cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
-    std::set<std::string> testLangs;
     for (std::string const& si : sources) {
       std::string ext = cmSystemTools::GetFilenameLastExtension(si);
       std::string lang = gg->GetLanguageFromExtension(ext.c_str());
@@ -818,14 +942,86 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     projectName = "CMAKE_TRY_COMPILE";
   }
 
+  std::string projectKey;
+  if (this->SrcFileSignature) {
+    projectKey = this->ComputeProjectKey(targetName, sources, cmakeFlags);
+  }
+
+  // A project with the same content may have been built before, maybe
+  // in another build tree.
+  bool cacheHit = false;
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  std::unique_ptr<cmTryCompileResultCache> resultCache;
+  cmTryCompileResultCache::Entry cached;
+  if (!projectKey.empty()) {
+    resultCache = this->CreateResultCache(projectKey, testLangs);
+  }
+  if (resultCache && resultCache->Load(cached)) {
+    cacheHit = true;
+    if (!cached.OutputFile.empty()) {
+      cmSystemTools::ReplaceString(cached.OutputFile, "<TARGET>", targetName);
+      cacheHit = resultCache->LoadOutputFile(this->BinaryDirectory + "/" +
+                                             cached.OutputFile);
+    }
+  }
+  if (queue && cacheHit) {
+    // The check finds its result in the cache when it is run again.
+    return 0;
+  }
+  if (resultCache && !queue) {
+    gg->CountTryCompileCacheLookup(cacheHit);
+  }
+#endif
+
+  // A project queued before with the same content may have been built
+  // already, or may be built now together with the other queued ones.
+  std::string batchKey;
+  if (!isTryRun && (queue || gg->HasQueuedTryCompiles())) {
+    batchKey = projectKey;
+  }
+
   bool erroroc = cmSystemTools::GetErrorOccuredFlag();
   cmSystemTools::ResetErrorOccuredFlag();
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(
-    sourceDirectory, this->BinaryDirectory, projectName, targetName,
-    this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL, &cmakeFlags,
-    output);
+  int res;
+  if (queue) {
+    // Leave the result unset until the check is run again.
+    res = this->Makefile->GenerateTryCompile(
+      sourceDirectory, this->BinaryDirectory, this->SrcFileSignature,
+      &cmakeFlags);
+    if (res == 0) {
+      gg->QueueTryCompile(batchKey, this->BinaryDirectory, projectName,
+                          targetName, this->SrcFileSignature, this->Makefile);
+      this->QueuedInBatch = true;
+    }
+    if (erroroc) {
+      cmSystemTools::SetErrorOccured();
+    }
+    return res;
+  }
+  std::string batchDirectory;
+  std::string batchTarget;
+  if (cacheHit) {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    res = cached.Result;
+    output = cached.Output;
+    cmSystemTools::ReplaceString(output, "<DIR>", this->BinaryDirectory);
+    cmSystemTools::ReplaceString(output, "<BUILD>",
+                                 this->Makefile->GetHomeOutputDirectory());
+    cmSystemTools::ReplaceString(output, "<TARGET>", targetName);
+#endif
+  } else if (!batchKey.empty() &&
+             gg->TakeTryCompileResult(batchKey, batchDirectory, batchTarget,
+                                      res, output)) {
+    this->BinaryDirectory = batchDirectory;
+    targetName = batchTarget;
+  } else {
+    // actually do the try compile now that everything is setup
+    res = this->Makefile->TryCompile(
+      sourceDirectory, this->BinaryDirectory, projectName, targetName,
+      this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL, &cmakeFlags,
+      output);
+  }
   if (erroroc) {
     cmSystemTools::SetErrorOccured();
   }
@@ -843,6 +1039,29 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     std::string copyFileErrorMessage;
     this->FindOutputFile(targetName, targetType);
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    // Remember the result, and the file built if the build succeeded.
+    std::string const prefix = this->BinaryDirectory + "/";
+    if (resultCache && !cacheHit &&
+        (res != 0 ||
+         cmSystemTools::StringStartsWith(this->OutputFile, prefix.c_str()))) {
+      cmTryCompileResultCache::Entry entry;
+      entry.Result = res;
+      entry.Output = output;
+      cmSystemTools::ReplaceString(entry.Output, this->BinaryDirectory,
+                                   "<DIR>");
+      cmSystemTools::ReplaceString(
+        entry.Output, this->Makefile->GetHomeOutputDirectory(), "<BUILD>");
+      cmSystemTools::ReplaceString(entry.Output, targetName, "<TARGET>");
+      if (res == 0) {
+        entry.OutputFile = this->OutputFile.substr(prefix.size());
+        cmSystemTools::ReplaceString(entry.OutputFile, targetName,
+                                     "<TARGET>");
+      }
+      resultCache->Store(entry, this->OutputFile);
+    }
+#endif
+
     if ((res == 0) && !copyFile.empty()) {
       if (this->OutputFile.empty() ||
           !cmSystemTools::CopyFileAlways(this->OutputFile, copyFile)) {
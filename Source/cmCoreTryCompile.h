@@ -5,6 +5,8 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -17,6 +19,10 @@
  * cmCoreTryCompile implements the functionality to build a program.
  * It is the base class for cmTryCompileCommand and cmTryRunCommand.
  */
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+class cmTryCompileResultCache;
+#endif
+
 class cmCoreTryCompile : public cmCommand
 {
 public:
@@ -48,9 +54,20 @@ protected:
   std::string FindErrorMessage;
   bool SrcFileSignature = false;
 
+  /** Whether the last TryCompileCode call queued its test project in a
+      batch of checks instead of building it.  */
+  bool QueuedInBatch = false;
+
 private:
   std::vector<std::string> WarnCMP0067;
   std::string LookupStdVar(std::string const& var, bool warnCMP0067);
+  std::string ComputeProjectKey(
+    std::string const& targetName, std::vector<std::string> const& sources,
+    std::vector<std::string> const& cmakeFlags) const;
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  std::unique_ptr<cmTryCompileResultCache> CreateResultCache(
+    std::string const& projectKey, std::set<std::string> const& langs) const;
+#endif
 };
 
 #endif
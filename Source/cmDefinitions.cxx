@@ -3,12 +3,76 @@
 #include "cmDefinitions.h"
 
 #include <assert.h>
-#include <set>
+#include <unordered_set>
 #include <utility>
 
+namespace {
+struct KeyTable
+{
+  std::unordered_map<std::string, unsigned int> Ids;
+  // Point to the keys of Ids, which never move.
+  std::vector<std::string const*> Names;
+  // Number of live cmState instances whose scopes hold ids.
+  unsigned int Users = 0;
+};
+
+KeyTable& GetKeyTable()
+{
+  static KeyTable table;
+  return table;
+}
+}
+
 cmDefinitions::Def cmDefinitions::NoDef;
 
-cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
+cmDefinitions::KeyId cmDefinitions::Intern(const std::string& key)
+{
+  KeyTable& table = GetKeyTable();
+  auto const inserted =
+    table.Ids.emplace(key, static_cast<KeyId>(table.Names.size()));
+  if (inserted.second) {
+    table.Names.push_back(&inserted.first->first);
+  }
+  return inserted.first->second;
+}
+
+bool cmDefinitions::Lookup(const std::string& key, KeyId& id)
+{
+  KeyTable& table = GetKeyTable();
+  auto const i = table.Ids.find(key);
+  if (i == table.Ids.end()) {
+    return false;
+  }
+  id = i->second;
+  return true;
+}
+
+std::string const& cmDefinitions::KeyName(KeyId id)
+{
+  KeyTable& table = GetKeyTable();
+  assert(id < table.Names.size());
+  return *table.Names[id];
+}
+
+void cmDefinitions::AcquireKeyTable()
+{
+  KeyTable& table = GetKeyTable();
+  ++table.Users;
+}
+
+void cmDefinitions::ReleaseKeyTable()
+{
+  KeyTable& table = GetKeyTable();
+  assert(table.Users > 0);
+  if (--table.Users == 0) {
+    // No scope is left to refer to an id, so start over with the names
+    // of the next instance instead of keeping every name ever seen.
+    table.Names.clear();
+    table.Ids.clear();
+  }
+}
+
+cmDefinitions::Def const& cmDefinitions::GetInternal(KeyId key,
                                                      StackIter begin,
                                                      StackIter end, bool raise)
 {
@@ -33,21 +97,30 @@ cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
 const std::string* cmDefinitions::Get(const std::string& key, StackIter begin,
                                       StackIter end)
 {
-  Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
-  return def.Exists ? &def : nullptr;
+  KeyId id;
+  if (!cmDefinitions::Lookup(key, id)) {
+    // The name was never set or raised in any scope.
+    return nullptr;
+  }
+  Def const& def = cmDefinitions::GetInternal(id, begin, end, false);
+  return def.Value.get();
 }
 
 void cmDefinitions::Raise(const std::string& key, StackIter begin,
                           StackIter end)
 {
-  cmDefinitions::GetInternal(key, begin, end, true);
+  cmDefinitions::GetInternal(cmDefinitions::Intern(key), begin, end, true);
 }
 
 bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
                            StackIter end)
 {
+  KeyId id;
+  if (!cmDefinitions::Lookup(key, id)) {
+    return false;
+  }
   for (StackIter it = begin; it != end; ++it) {
-    MapType::const_iterator i = it->Map.find(key);
+    MapType::const_iterator i = it->Map.find(id);
     if (i != it->Map.end()) {
       return true;
     }
@@ -58,7 +131,7 @@ bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
 void cmDefinitions::Set(const std::string& key, const char* value)
 {
   Def def(value);
-  this->Map[key] = def;
+  this->Map[cmDefinitions::Intern(key)] = std::move(def);
 }
 
 std::vector<std::string> cmDefinitions::UnusedKeys() const
@@ -68,7 +141,7 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
   // Consider local definitions.
   for (auto const& mi : this->Map) {
     if (!mi.second.Used) {
-      keys.push_back(mi.first);
+      keys.push_back(cmDefinitions::KeyName(mi.first));
     }
   }
   return keys;
@@ -77,14 +150,14 @@ std::vector<std::string> cmDefinitions::UnusedKeys() const
 cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 {
   cmDefinitions closure;
-  std::set<std::string> undefined;
+  std::unordered_set<KeyId> undefined;
   for (StackIter it = begin; it != end; ++it) {
     // Consider local definitions.
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
       if (closure.Map.find(mi.first) == closure.Map.end() &&
           undefined.find(mi.first) == undefined.end()) {
-        if (mi.second.Exists) {
+        if (mi.second.Exists()) {
           closure.Map.insert(mi);
         } else {
           undefined.insert(mi.first);
@@ -98,15 +171,15 @@ cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
                                                     StackIter end)
 {
-  std::set<std::string> bound;
+  std::unordered_set<KeyId> bound;
   std::vector<std::string> defined;
 
   for (StackIter it = begin; it != end; ++it) {
     defined.reserve(defined.size() + it->Map.size());
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
-      if (bound.insert(mi.first).second && mi.second.Exists) {
-        defined.push_back(mi.first);
+      if (bound.insert(mi.first).second && mi.second.Exists()) {
+        defined.push_back(cmDefinitions::KeyName(mi.first));
       }
     }
   }
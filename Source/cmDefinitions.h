@@ -5,6 +5,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -39,42 +40,46 @@ public:
 
   static cmDefinitions MakeClosure(StackIter begin, StackIter end);
 
+  /** Register and unregister an owner of scopes.  The table of variable
+      names is cleared when the last owner goes away.  */
+  static void AcquireKeyTable();
+  static void ReleaseKeyTable();
+
 private:
-  // String with existence boolean.
-  struct Def : public std::string
+  // Variable names are interned once in a global table so that the
+  // scopes are keyed by integer instead of hashing the name per scope.
+  // The table lives as long as any owner.  It is not locked: variables
+  // are only read and set on the thread that configures the project, and
+  // the nested instances of try_compile run on that thread too.
+  typedef unsigned int KeyId;
+  static KeyId Intern(const std::string& key);
+  static bool Lookup(const std::string& key, KeyId& id);
+  static std::string const& KeyName(KeyId id);
+
+  // Shared string with existence boolean.  Values raised into another
+  // scope or copied into a closure share storage with the original.
+  struct Def
   {
-  private:
-    typedef std::string std_string;
-
-  public:
     Def()
-      : std_string()
-      , Exists(false)
-      , Used(false)
+      : Used(false)
     {
     }
     Def(const char* v)
-      : std_string(v ? v : "")
-      , Exists(v ? true : false)
-      , Used(false)
-    {
-    }
-    Def(const std_string& v)
-      : std_string(v)
-      , Exists(true)
+      : Value(v ? std::make_shared<std::string const>(v) : nullptr)
       , Used(false)
     {
     }
-    bool Exists;
+    bool Exists() const { return this->Value != nullptr; }
+    std::shared_ptr<std::string const> Value;
     bool Used;
   };
   static Def NoDef;
 
-  typedef std::unordered_map<std::string, Def> MapType;
+  typedef std::unordered_map<KeyId, Def> MapType;
   MapType Map;
 
-  static Def const& GetInternal(const std::string& key, StackIter begin,
-                                StackIter end, bool raise);
+  static Def const& GetInternal(KeyId key, StackIter begin, StackIter end,
+                                bool raise);
 };
 
 #endif
@@ -51,6 +51,7 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
     std::string const& obj = *si++;
     dependencies[obj].insert(src);
   }
+  this->PrepareDependencies(dependencies);
   for (auto const& d : dependencies) {
 
     // Write the dependencies for this pair.
@@ -63,6 +64,11 @@ bool cmDepends::Write(std::ostream& makeDepends, std::ostream& internalDepends)
   return this->Finalize(makeDepends, internalDepends);
 }
 
+void cmDepends::PrepareDependencies(
+  std::map<std::string, std::set<std::string>> const& /*unused*/)
+{
+}
+
 bool cmDepends::Finalize(std::ostream& /*unused*/, std::ostream& /*unused*/)
 {
   return true;
@@ -74,6 +74,12 @@ public:
   }
 
 protected:
+  // Called with every object file and its sources before the
+  // dependencies of each one are written in order.  Subclasses may
+  // compute them all ahead of time.
+  virtual void PrepareDependencies(
+    std::map<std::string, std::set<std::string>> const& dependencies);
+
   // Write dependencies for the target file to the given stream.
   // Return true for success and false for failure.
   virtual bool WriteDependencies(const std::set<std::string>& sources,
@@ -3,7 +3,11 @@
 #include "cmDependsC.h"
 
 #include "cmsys/FStream.hxx"
+#include <algorithm>
+#include <queue>
+#include <string.h>
 #include <utility>
+#include <vector>
 
 #include "cmAlgorithms.h"
 #include "cmFileTimeComparison.h"
@@ -11,6 +15,14 @@
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmCryptoHash.h"
+#  include "cmWorkerPool.h"
+#  include "cm_uv.h"
+
+#  include <sstream>
+#endif
+
 #define INCLUDE_REGEX_LINE                                                    \
   "^[ \t]*[#%][ \t]*(include|import)[ \t]*[<\"]([^\">]+)([\">])"
 
@@ -19,8 +31,149 @@
 #define INCLUDE_REGEX_COMPLAIN_MARKER "#IncludeRegexComplain: "
 #define INCLUDE_REGEX_TRANSFORM_MARKER "#IncludeRegexTransform: "
 
+namespace {
+// Find the lines matched by INCLUDE_REGEX_LINE in the content of a file
+// without running the regular expression on every line.  Most lines do
+// not contain a '#' or '%' at all, so search for those in bulk and only
+// look at the lines that do.
+class IncludeLineScanner
+{
+public:
+  IncludeLineScanner(std::string const& content)
+    : Content(content)
+    , Pos(0)
+    , NextHash(content.find('#'))
+    , NextPercent(content.find('%'))
+  {
+  }
+
+  // Get the file name and the closing delimiter of the next include
+  // line.  Returns false at the end of the content.
+  bool Next(std::string& fileName, char& delim)
+  {
+    std::string::size_type const npos = std::string::npos;
+    for (;;) {
+      if (this->NextHash < this->Pos) {
+        this->NextHash = this->Content.find('#', this->Pos);
+      }
+      if (this->NextPercent < this->Pos) {
+        this->NextPercent = this->Content.find('%', this->Pos);
+      }
+      std::string::size_type const pos =
+        std::min(this->NextHash, this->NextPercent);
+      if (pos == npos) {
+        this->Pos = this->Content.size();
+        return false;
+      }
+
+      // Skip the rest of the line after looking at it.
+      std::string::size_type const eol = this->Content.find('\n', pos);
+      std::string::size_type const end =
+        eol == npos ? this->Content.size() : eol;
+      this->Pos = eol == npos ? end : eol + 1;
+
+      if (this->AtLineStart(pos) &&
+          this->Match(pos + 1, end, fileName, delim)) {
+        return true;
+      }
+    }
+  }
+
+private:
+  // Whether only blanks precede the character at pos on its line.
+  bool AtLineStart(std::string::size_type pos) const
+  {
+    while (pos > 0) {
+      char const c = this->Content[--pos];
+      if (c == '\n') {
+        return true;
+      }
+      if (c != ' ' && c != '\t') {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Match the rest of an include line after the '#' or '%'.  A NUL
+  // character ends the line as it does for the regular expression.
+  bool Match(std::string::size_type pos, std::string::size_type end,
+             std::string& fileName, char& delim) const
+  {
+    char const* c = this->Content.c_str() + pos;
+    char const* const e = this->Content.c_str() + end;
+    while (c != e && (*c == ' ' || *c == '\t')) {
+      ++c;
+    }
+    static char const include[] = "include";
+    static char const import[] = "import";
+    if (static_cast<size_t>(e - c) >= sizeof(include) - 1 &&
+        memcmp(c, include, sizeof(include) - 1) == 0) {
+      c += sizeof(include) - 1;
+    } else if (static_cast<size_t>(e - c) >= sizeof(import) - 1 &&
+               memcmp(c, import, sizeof(import) - 1) == 0) {
+      c += sizeof(import) - 1;
+    } else {
+      return false;
+    }
+    while (c != e && (*c == ' ' || *c == '\t')) {
+      ++c;
+    }
+    if (c == e || (*c != '<' && *c != '"')) {
+      return false;
+    }
+    char const* const name = ++c;
+    while (c != e && *c != '"' && *c != '>' && *c != '\0') {
+      ++c;
+    }
+    if (c == name || c == e || *c == '\0') {
+      return false;
+    }
+    fileName.assign(name, c);
+    delim = *c;
+    return true;
+  }
+
+  std::string const& Content;
+  std::string::size_type Pos;
+  std::string::size_type NextHash;
+  std::string::size_type NextPercent;
+};
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+// Most threads a single dependency scan starts.
+unsigned int const MaxScanThreads = 4;
+
+// Whether the make tool that runs us runs several jobs at once, and so
+// possibly several dependency scans.  GNU make passes -j and the job
+// server to its children in MAKEFLAGS.
+bool MakeRunsParallel()
+{
+  std::string flags;
+  if (!cmSystemTools::GetEnv("MAKEFLAGS", flags)) {
+    return false;
+  }
+  std::istringstream words(flags);
+  std::string word;
+  while (words >> word) {
+    if (word == "--") {
+      break;
+    }
+    if (cmHasLiteralPrefix(word, "--jobserver")) {
+      return true;
+    }
+    if (cmHasLiteralPrefix(word, "-j")) {
+      return word != "-j1";
+    }
+  }
+  return false;
+}
+#endif
+}
+
 cmDependsC::cmDependsC()
-  : ValidDeps(nullptr)
+  : ScanAllIncludes(true)
+  , ValidDeps(nullptr)
 {
 }
 
@@ -28,6 +181,7 @@ cmDependsC::cmDependsC(
   cmLocalGenerator* lg, const char* targetDir, const std::string& lang,
   const std::map<std::string, DependencyVector>* validDeps)
   : cmDepends(lg, targetDir)
+  , ScanAllIncludes(false)
   , ValidDeps(validDeps)
 {
   cmMakefile* mf = lg->GetMakefile();
@@ -53,9 +207,10 @@ cmDependsC::cmDependsC(
     }
   }
 
-  this->IncludeRegexLine.compile(INCLUDE_REGEX_LINE);
-  this->IncludeRegexScan.compile(scanRegex.c_str());
-  this->IncludeRegexComplain.compile(complainRegex.c_str());
+  this->Regex.IncludeRegexLine.compile(INCLUDE_REGEX_LINE);
+  this->Regex.IncludeRegexScan.compile(scanRegex.c_str());
+  this->ScanAllIncludes = (scanRegex == "^.*$");
+  this->Regex.IncludeRegexComplain.compile(complainRegex.c_str());
   this->IncludeRegexLineString = INCLUDE_REGEX_LINE_MARKER INCLUDE_REGEX_LINE;
   this->IncludeRegexScanString = INCLUDE_REGEX_SCAN_MARKER;
   this->IncludeRegexScanString += scanRegex;
@@ -70,14 +225,86 @@ cmDependsC::cmDependsC(
   this->CacheFileName += ".includecache";
 
   this->ReadCacheFile();
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Targets with the same scanning rules share one cache file.
+  cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+  this->SharedCacheFileName = lg->GetBinaryDirectory();
+  this->SharedCacheFileName += "/CMakeFiles/CMakeIncludeCache/";
+  this->SharedCacheFileName += hasher.HashString(
+    this->IncludeRegexLineString + "\n" + this->IncludeRegexScanString +
+    "\n" + this->IncludeRegexComplainString + "\n" +
+    this->IncludeRegexTransformString);
+  this->SharedCacheFileName += ".txt";
+  this->ReadSharedCacheFile(this->SharedCache);
+#endif
 }
 
 cmDependsC::~cmDependsC()
 {
   this->WriteCacheFile();
+  this->WriteSharedCacheFile();
   cmDeleteAll(this->FileCache);
 }
 
+void cmDependsC::PrepareDependencies(
+  std::map<std::string, std::set<std::string>> const& dependencies)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Collect the object files whose dependencies must be scanned.
+  // Anything WriteDependencies would reject is left to it.
+  std::string binDir = this->LocalGenerator->GetBinaryDirectory();
+  std::vector<std::pair<std::string, std::set<std::string> const*>> work;
+  for (auto const& d : dependencies) {
+    if (d.second.empty() || d.second.begin()->empty() || d.first.empty()) {
+      continue;
+    }
+    if (this->ValidDeps != nullptr) {
+      std::string obj_i =
+        this->LocalGenerator->ConvertToRelativePath(binDir, d.first);
+      if (this->ValidDeps->find(obj_i) != this->ValidDeps->end()) {
+        continue;
+      }
+    }
+    work.emplace_back(d.first, &d.second);
+  }
+  if (work.size() < 2) {
+    return;
+  }
+
+  // Walk the dependency graph of each object file on a worker thread.
+  // The results are written in order by WriteDependencies so the
+  // depend files do not depend on the scheduling.  A parallel make
+  // already runs the scans of several targets at once.
+  if (MakeRunsParallel()) {
+    return;
+  }
+  unsigned int threads =
+    std::min(cmWorkerPool::GetHardwareThreadCount(), MaxScanThreads);
+  if (threads < 2) {
+    return;
+  }
+  if (threads > work.size()) {
+    threads = static_cast<unsigned int>(work.size());
+  }
+  for (auto const& w : work) {
+    this->PreparedScans[w.first];
+  }
+  cmWorkerPool pool(threads);
+  for (auto const& w : work) {
+    std::set<std::string> const* sources = w.second;
+    ScanResult* result = &this->PreparedScans[w.first];
+    pool.PushJob([this, sources, result]() {
+      Matchers regex = this->Regex;
+      this->ScanDependencies(*sources, regex, *result);
+    });
+  }
+  pool.WaitForJobs();
+#else
+  static_cast<void>(dependencies);
+#endif
+}
+
 bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
                                    const std::string& obj,
                                    std::ostream& makeDepends,
@@ -113,116 +340,21 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   }
 
   if (!haveDeps) {
-    // Walk the dependency graph starting with the source file.
-    int srcFiles = static_cast<int>(sources.size());
-    this->Encountered.clear();
-
-    for (std::string const& src : sources) {
-      UnscannedEntry root;
-      root.FileName = src;
-      this->Unscanned.push(root);
-      this->Encountered.insert(src);
-    }
-
-    std::set<std::string> scanned;
-
-    // Use reserve to allocate enough memory for tempPathStr
-    // so that during the loops no memory is allocated or freed
-    std::string tempPathStr;
-    tempPathStr.reserve(4 * 1024);
-
-    while (!this->Unscanned.empty()) {
-      // Get the next file to scan.
-      UnscannedEntry current = this->Unscanned.front();
-      this->Unscanned.pop();
-
-      // If not a full path, find the file in the include path.
-      std::string fullName;
-      if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
-        if (cmSystemTools::FileExists(current.FileName, true)) {
-          fullName = current.FileName;
-        }
-      } else if (!current.QuotedLocation.empty() &&
-                 cmSystemTools::FileExists(current.QuotedLocation, true)) {
-        // The include statement producing this entry was a double-quote
-        // include and the included file is present in the directory of
-        // the source containing the include statement.
-        fullName = current.QuotedLocation;
-      } else {
-        std::map<std::string, std::string>::iterator headerLocationIt =
-          this->HeaderLocationCache.find(current.FileName);
-        if (headerLocationIt != this->HeaderLocationCache.end()) {
-          fullName = headerLocationIt->second;
-        } else {
-          for (std::string const& i : this->IncludePath) {
-            // Construct the name of the file as if it were in the current
-            // include directory.  Avoid using a leading "./".
-
-            tempPathStr =
-              cmSystemTools::CollapseCombinedPath(i, current.FileName);
-
-            // Look for the file in this location.
-            if (cmSystemTools::FileExists(tempPathStr, true)) {
-              fullName = tempPathStr;
-              HeaderLocationCache[current.FileName] = fullName;
-              break;
-            }
-          }
-        }
-      }
-
-      // Complain if the file cannot be found and matches the complain
-      // regex.
-      if (fullName.empty() &&
-          this->IncludeRegexComplain.find(current.FileName)) {
-        cmSystemTools::Error("Cannot find file \"", current.FileName.c_str(),
-                             "\".");
-        return false;
-      }
-
-      // Scan the file if it was found and has not been scanned already.
-      if (!fullName.empty() && (scanned.find(fullName) == scanned.end())) {
-        // Record scanned files.
-        scanned.insert(fullName);
-
-        // Check whether this file is already in the cache
-        std::map<std::string, cmIncludeLines*>::iterator fileIt =
-          this->FileCache.find(fullName);
-        if (fileIt != this->FileCache.end()) {
-          fileIt->second->Used = true;
-          dependencies.insert(fullName);
-          for (UnscannedEntry const& inc : fileIt->second->UnscannedEntries) {
-            if (this->Encountered.find(inc.FileName) ==
-                this->Encountered.end()) {
-              this->Encountered.insert(inc.FileName);
-              this->Unscanned.push(inc);
-            }
-          }
-        } else {
-
-          // Try to scan the file.  Just leave it out if we cannot find
-          // it.
-          cmsys::ifstream fin(fullName.c_str());
-          if (fin) {
-            cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
-            if (bom == cmsys::FStream::BOM_None ||
-                bom == cmsys::FStream::BOM_UTF8) {
-              // Add this file as a dependency.
-              dependencies.insert(fullName);
-
-              // Scan this file for new dependencies.  Pass the directory
-              // containing the file to handle double-quote includes.
-              std::string dir = cmSystemTools::GetFilenamePath(fullName);
-              this->Scan(fin, dir.c_str(), fullName);
-            } else {
-              // Skip file with encoding we do not implement.
-            }
-          }
-        }
-      }
-
-      srcFiles--;
+    ScanResult scan;
+    std::map<std::string, ScanResult>::iterator prepared =
+      this->PreparedScans.find(obj);
+    if (prepared != this->PreparedScans.end()) {
+      scan = std::move(prepared->second);
+      this->PreparedScans.erase(prepared);
+    } else {
+      this->ScanDependencies(sources, this->Regex, scan);
+    }
+    if (!scan.MissingFile.empty()) {
+      cmSystemTools::Error("Cannot find file \"", scan.MissingFile.c_str(),
+                           "\".");
+      return false;
     }
+    dependencies = std::move(scan.Dependencies);
   }
 
   // Write the dependencies to the output stream.  Makefile rules
@@ -244,6 +376,167 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   return true;
 }
 
+void cmDependsC::ScanDependencies(std::set<std::string> const& sources,
+                                  Matchers& regex, ScanResult& result)
+{
+  // Walk the dependency graph starting with the source file.
+  int srcFiles = static_cast<int>(sources.size());
+  std::set<std::string> encountered;
+  std::queue<UnscannedEntry> unscanned;
+
+  for (std::string const& src : sources) {
+    UnscannedEntry root;
+    root.FileName = src;
+    unscanned.push(root);
+    encountered.insert(src);
+  }
+
+  std::set<std::string> scanned;
+
+  while (!unscanned.empty()) {
+    // Get the next file to scan.
+    UnscannedEntry current = unscanned.front();
+    unscanned.pop();
+
+    // If not a full path, find the file in the include path.
+    std::string fullName;
+    if ((srcFiles > 0) || cmSystemTools::FileIsFullPath(current.FileName)) {
+      if (cmSystemTools::FileExists(current.FileName, true)) {
+        fullName = current.FileName;
+      }
+    } else if (!current.QuotedLocation.empty() &&
+               cmSystemTools::FileExists(current.QuotedLocation, true)) {
+      // The include statement producing this entry was a double-quote
+      // include and the included file is present in the directory of
+      // the source containing the include statement.
+      fullName = current.QuotedLocation;
+    } else {
+      fullName = this->FindHeader(current.FileName);
+    }
+
+    // Complain if the file cannot be found and matches the complain
+    // regex.
+    if (fullName.empty() &&
+        regex.IncludeRegexComplain.find(current.FileName)) {
+      result.MissingFile = current.FileName;
+      return;
+    }
+
+    // Scan the file if it was found and has not been scanned already.
+    if (!fullName.empty() && scanned.insert(fullName).second) {
+      // Just leave the file out if we cannot read it.
+      if (cmIncludeLines const* lines =
+            this->GetIncludeLines(fullName, regex)) {
+        result.Dependencies.insert(fullName);
+        for (UnscannedEntry const& inc : lines->UnscannedEntries) {
+          // Queue the file if it has not yet been encountered.
+          if (encountered.insert(inc.FileName).second) {
+            unscanned.push(inc);
+          }
+        }
+      }
+    }
+
+    srcFiles--;
+  }
+}
+
+std::string cmDependsC::FindHeader(std::string const& fileName)
+{
+  {
+    CacheLock lock(this->CacheMutex);
+    std::map<std::string, std::string>::iterator headerLocationIt =
+      this->HeaderLocationCache.find(fileName);
+    if (headerLocationIt != this->HeaderLocationCache.end()) {
+      return headerLocationIt->second;
+    }
+  }
+
+  for (std::string const& i : this->IncludePath) {
+    // Construct the name of the file as if it were in the current
+    // include directory.  Avoid using a leading "./".
+    std::string fullName = cmSystemTools::CollapseCombinedPath(i, fileName);
+
+    // Look for the file in this location.
+    if (cmSystemTools::FileExists(fullName, true)) {
+      CacheLock lock(this->CacheMutex);
+      this->HeaderLocationCache[fileName] = fullName;
+      return fullName;
+    }
+  }
+  return std::string();
+}
+
+cmDependsC::cmIncludeLines const* cmDependsC::GetIncludeLines(
+  std::string const& fullName, Matchers& regex)
+{
+  // Check whether this file is already in the cache
+  {
+    CacheLock lock(this->CacheMutex);
+    std::map<std::string, cmIncludeLines*>::iterator fileIt =
+      this->FileCache.find(fullName);
+    if (fileIt != this->FileCache.end()) {
+      fileIt->second->Used = true;
+      return fileIt->second;
+    }
+  }
+
+  // Look for the file in the cache shared with other targets.
+  std::string stamp;
+  bool const haveStamp = !this->SharedCacheFileName.empty() &&
+    cmFileTimeComparison::FileTimeStamp(fullName.c_str(), stamp);
+  if (haveStamp) {
+    SharedCacheType::const_iterator shared = this->SharedCache.find(fullName);
+    if (shared != this->SharedCache.end() && shared->second.Stamp == stamp) {
+      cmIncludeLines* newCacheEntry = new cmIncludeLines;
+      newCacheEntry->UnscannedEntries = shared->second.UnscannedEntries;
+      return this->AddCacheEntry(fullName, newCacheEntry);
+    }
+  }
+
+  // Try to scan the file.
+  cmsys::ifstream fin(fullName.c_str());
+  if (!fin) {
+    return nullptr;
+  }
+  cmsys::FStream::BOM bom = cmsys::FStream::ReadBOM(fin);
+  if (bom != cmsys::FStream::BOM_None && bom != cmsys::FStream::BOM_UTF8) {
+    // Skip file with encoding we do not implement.
+    return nullptr;
+  }
+
+  // Scan this file for new dependencies.  Pass the directory
+  // containing the file to handle double-quote includes.
+  cmIncludeLines* newCacheEntry = new cmIncludeLines;
+  std::string dir = cmSystemTools::GetFilenamePath(fullName);
+  this->Scan(fin, dir.c_str(), regex, *newCacheEntry);
+
+  // The stamp was taken before reading, so the entry will not be used
+  // if the file changes meanwhile.
+  if (haveStamp) {
+    CacheLock lock(this->CacheMutex);
+    SharedCacheEntry& shared = this->SharedCacheAdded[fullName];
+    shared.Stamp = stamp;
+    shared.UnscannedEntries = newCacheEntry->UnscannedEntries;
+  }
+  return this->AddCacheEntry(fullName, newCacheEntry);
+}
+
+cmDependsC::cmIncludeLines const* cmDependsC::AddCacheEntry(
+  std::string const& fullName, cmIncludeLines* lines)
+{
+  // Another walk may have scanned the same file meanwhile.  Keep the
+  // first entry, they are identical.
+  CacheLock lock(this->CacheMutex);
+  std::pair<std::map<std::string, cmIncludeLines*>::iterator, bool> ins =
+    this->FileCache.insert(std::make_pair(fullName, lines));
+  if (!ins.second) {
+    delete lines;
+  }
+  ins.first->second->Used = true;
+  return ins.first->second;
+}
+
 void cmDependsC::ReadCacheFile()
 {
   if (this->CacheFileName.empty()) {
@@ -343,55 +636,203 @@ void cmDependsC::WriteCacheFile() const
   }
 }
 
-void cmDependsC::Scan(std::istream& is, const char* directory,
-                      const std::string& fullName)
+void cmDependsC::ReadSharedCacheFile(SharedCacheType& cache) const
 {
-  cmIncludeLines* newCacheEntry = new cmIncludeLines;
-  newCacheEntry->Used = true;
-  this->FileCache[fullName] = newCacheEntry;
+  cmsys::ifstream fin(this->SharedCacheFileName.c_str());
+  if (!fin) {
+    return;
+  }
 
-  // Read one line at a time.
+  // The file starts with the scanning rules it was written for.
   std::string line;
-  while (cmSystemTools::GetLineFromStream(is, line)) {
-    // Transform the line content first.
-    if (!this->TransformRules.empty()) {
-      this->TransformLine(line);
+  std::string const* rules[] = { &this->IncludeRegexLineString,
+                                 &this->IncludeRegexScanString,
+                                 &this->IncludeRegexComplainString,
+                                 &this->IncludeRegexTransformString };
+  for (std::string const* rule : rules) {
+    if (!cmSystemTools::GetLineFromStream(fin, line) || line != *rule) {
+      return;
     }
+  }
 
-    // Match include directives.
-    if (this->IncludeRegexLine.find(line)) {
-      // Get the file being included.
-      UnscannedEntry entry;
-      entry.FileName = this->IncludeRegexLine.match(2);
-      cmSystemTools::ConvertToUnixSlashes(entry.FileName);
-      if (this->IncludeRegexLine.match(3) == "\"" &&
-          !cmSystemTools::FileIsFullPath(entry.FileName)) {
-        // This was a double-quoted include with a relative path.  We
-        // must check for the file in the directory containing the
-        // file we are scanning.
-        entry.QuotedLocation =
-          cmSystemTools::CollapseCombinedPath(directory, entry.FileName);
+  // Each entry is the name of the scanned file, its time stamp and the
+  // pairs of lines of its includes, ended by an empty line.
+  SharedCacheEntry* entry = nullptr;
+  bool haveStamp = false;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty()) {
+      entry = nullptr;
+    } else if (!entry) {
+      entry = &cache[line];
+      entry->UnscannedEntries.clear();
+      haveStamp = false;
+    } else if (!haveStamp) {
+      entry->Stamp = line;
+      haveStamp = true;
+    } else {
+      UnscannedEntry inc;
+      inc.FileName = line;
+      if (cmSystemTools::GetLineFromStream(fin, line)) {
+        if (line != "-") {
+          inc.QuotedLocation = line;
+        }
+        entry->UnscannedEntries.push_back(std::move(inc));
+      }
+    }
+  }
+}
+
+void cmDependsC::WriteSharedCacheFile()
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (this->SharedCacheFileName.empty() || this->SharedCacheAdded.empty()) {
+    return;
+  }
+
+  cmSystemTools::MakeDirectory(
+    cmSystemTools::GetFilenamePath(this->SharedCacheFileName));
+  std::ostringstream tmpName;
+  tmpName << this->SharedCacheFileName << "." << uv_os_getpid() << ".tmp";
+  std::string const tmpFile = tmpName.str();
+
+  // Other targets may be scanned concurrently and replace the file at
+  // any time.  Merge the new entries with its current content into a
+  // temporary file of this process and rename it, but merge again if the
+  // file was replaced meanwhile.  Only a replacement right before the
+  // rename loses entries, which are then scanned again by a later build.
+  for (int attempt = 0; attempt < 4; ++attempt) {
+    std::string stampBefore;
+    bool const existedBefore = cmFileTimeComparison::FileTimeStamp(
+      this->SharedCacheFileName.c_str(), stampBefore);
+    SharedCacheType cache;
+    this->ReadSharedCacheFile(cache);
+
+    // Drop the entries of headers that were removed or changed since.
+    for (SharedCacheType::iterator i = cache.begin(); i != cache.end();) {
+      std::string stamp;
+      if (!cmFileTimeComparison::FileTimeStamp(i->first.c_str(), stamp) ||
+          stamp != i->second.Stamp) {
+        i = cache.erase(i);
+      } else {
+        ++i;
       }
+    }
+    for (auto const& added : this->SharedCacheAdded) {
+      cache[added.first] = added.second;
+    }
 
-      // Queue the file if it has not yet been encountered and it
-      // matches the regular expression for recursive scanning.  Note
-      // that this check does not account for the possibility of two
-      // headers with the same name in different directories when one
-      // is included by double-quotes and the other by angle brackets.
-      // It also does not work properly if two header files with the same
-      // name exist in different directories, and both are included from a
-      // file their own directory by simply using "filename.h" (#12619)
-      // This kind of problem will be fixed when a more
-      // preprocessor-like implementation of this scanner is created.
-      if (this->IncludeRegexScan.find(entry.FileName)) {
-        newCacheEntry->UnscannedEntries.push_back(entry);
-        if (this->Encountered.find(entry.FileName) ==
-            this->Encountered.end()) {
-          this->Encountered.insert(entry.FileName);
-          this->Unscanned.push(entry);
+    {
+      cmsys::ofstream cacheOut(tmpFile.c_str());
+      if (!cacheOut) {
+        return;
+      }
+      cacheOut << this->IncludeRegexLineString << "\n"
+               << this->IncludeRegexScanString << "\n"
+               << this->IncludeRegexComplainString << "\n"
+               << this->IncludeRegexTransformString << "\n\n";
+      for (auto const& fileIt : cache) {
+        cacheOut << fileIt.first << "\n" << fileIt.second.Stamp << "\n";
+        for (UnscannedEntry const& inc : fileIt.second.UnscannedEntries) {
+          cacheOut << inc.FileName << "\n";
+          if (inc.QuotedLocation.empty()) {
+            cacheOut << "-\n";
+          } else {
+            cacheOut << inc.QuotedLocation << "\n";
+          }
         }
+        cacheOut << "\n";
+      }
+      if (!cacheOut) {
+        cacheOut.close();
+        cmSystemTools::RemoveFile(tmpFile);
+        return;
       }
     }
+
+    std::string stampAfter;
+    bool const existedAfter = cmFileTimeComparison::FileTimeStamp(
+      this->SharedCacheFileName.c_str(), stampAfter);
+    if (existedAfter != existedBefore || stampAfter != stampBefore) {
+      continue;
+    }
+    if (cmSystemTools::RenameFile(tmpFile.c_str(),
+                                  this->SharedCacheFileName.c_str())) {
+      this->SharedCacheAdded.clear();
+      return;
+    }
+    break;
+  }
+
+  // The file keeps changing.  Its entries are valid, and the ones not
+  // written here are scanned again by a later build.
+  cmSystemTools::RemoveFile(tmpFile);
+#endif
+}
+
+void cmDependsC::Scan(std::istream& is, const char* directory,
+                      Matchers& regex, cmIncludeLines& lines) const
+{
+  if (this->TransformRules.empty()) {
+    // Nothing rewrites the lines, so look for include lines directly in
+    // the content of the file.
+    std::string content;
+    char buffer[16384];
+    while (is.read(buffer, sizeof(buffer)) || is.gcount() > 0) {
+      content.append(buffer, static_cast<size_t>(is.gcount()));
+    }
+    IncludeLineScanner scanner(content);
+    std::string fileName;
+    char delim;
+    while (scanner.Next(fileName, delim)) {
+      this->AddInclude(fileName, delim == '"', directory, regex, lines);
+    }
+    return;
+  }
+
+  // Read one line at a time.
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(is, line)) {
+    // Transform the line content first.
+    this->TransformLine(line, regex);
+
+    // Match include directives.
+    if (regex.IncludeRegexLine.find(line)) {
+      this->AddInclude(regex.IncludeRegexLine.match(2),
+                       regex.IncludeRegexLine.match(3) == "\"", directory,
+                       regex, lines);
+    }
+  }
+}
+
+void cmDependsC::AddInclude(std::string fileName, bool quoted,
+                            const char* directory, Matchers& regex,
+                            cmIncludeLines& lines) const
+{
+  // Get the file being included.
+  UnscannedEntry entry;
+  entry.FileName = std::move(fileName);
+  cmSystemTools::ConvertToUnixSlashes(entry.FileName);
+  if (quoted && !cmSystemTools::FileIsFullPath(entry.FileName)) {
+    // This was a double-quoted include with a relative path.  We
+    // must check for the file in the directory containing the
+    // file we are scanning.
+    entry.QuotedLocation =
+      cmSystemTools::CollapseCombinedPath(directory, entry.FileName);
+  }
+
+  // Record the file if it matches the regular expression for
+  // recursive scanning.  The walk queues it if it has not yet been
+  // encountered.  Note that this check does not account for the
+  // possibility of two headers with the same name in different
+  // directories when one is included by double-quotes and the other
+  // by angle brackets.  It also does not work properly if two header
+  // files with the same name exist in different directories, and
+  // both are included from a file their own directory by simply
+  // using "filename.h" (#12619) This kind of problem will be fixed
+  // when a more preprocessor-like implementation of this scanner is
+  // created.
+  if (this->ScanAllIncludes || regex.IncludeRegexScan.find(entry.FileName)) {
+    lines.UnscannedEntries.push_back(std::move(entry));
   }
 }
 
@@ -419,7 +860,7 @@ void cmDependsC::SetupTransforms()
       sep = "|";
     }
     xform += ")[ \t]*\\(([^),]*)\\)";
-    this->IncludeRegexTransform.compile(xform.c_str());
+    this->Regex.IncludeRegexTransform.compile(xform.c_str());
 
     // Build a string that encodes all transformation rules and will
     // change when rules are changed.
@@ -446,21 +887,21 @@ void cmDependsC::ParseTransform(std::string const& xform)
   this->TransformRules[name] = value;
 }
 
-void cmDependsC::TransformLine(std::string& line)
+void cmDependsC::TransformLine(std::string& line, Matchers& regex) const
 {
   // Check for a transform rule match.  Return if none.
-  if (!this->IncludeRegexTransform.find(line)) {
+  if (!regex.IncludeRegexTransform.find(line)) {
     return;
   }
   TransformRulesType::const_iterator tri =
-    this->TransformRules.find(this->IncludeRegexTransform.match(3));
+    this->TransformRules.find(regex.IncludeRegexTransform.match(3));
   if (tri == this->TransformRules.end()) {
     return;
   }
 
   // Construct the transformed line.
-  std::string newline = this->IncludeRegexTransform.match(1);
-  std::string arg = this->IncludeRegexTransform.match(4);
+  std::string newline = regex.IncludeRegexTransform.match(1);
+  std::string arg = regex.IncludeRegexTransform.match(4);
   for (const char* c = tri->second.c_str(); *c; ++c) {
     if (*c == '%') {
       newline += arg;
@@ -10,11 +10,14 @@
 #include "cmsys/RegularExpression.hxx"
 #include <iosfwd>
 #include <map>
-#include <queue>
 #include <set>
 #include <string>
 #include <vector>
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include <mutex>
+#endif
+
 class cmLocalGenerator;
 
 /** \class cmDependsC
@@ -37,33 +40,43 @@ public:
 
 protected:
   // Implement writing/checking methods required by superclass.
+  void PrepareDependencies(
+    std::map<std::string, std::set<std::string>> const& dependencies)
+    override;
   bool WriteDependencies(const std::set<std::string>& sources,
                          const std::string& obj, std::ostream& makeDepends,
                          std::ostream& internalDepends) override;
 
-  // Method to scan a single file.
-  void Scan(std::istream& is, const char* directory,
-            const std::string& fullName);
+  // Regular expressions used while scanning.  They hold the state of
+  // the last match, so each walk of the dependency graph works on its
+  // own copy.
+  struct Matchers
+  {
+    // Regular expression to identify C preprocessor include directives.
+    cmsys::RegularExpression IncludeRegexLine;
 
-  // Regular expression to identify C preprocessor include directives.
-  cmsys::RegularExpression IncludeRegexLine;
+    // Regular expressions to choose which include files to scan
+    // recursively and which to complain about not finding.
+    cmsys::RegularExpression IncludeRegexScan;
+    cmsys::RegularExpression IncludeRegexComplain;
 
-  // Regular expressions to choose which include files to scan
-  // recursively and which to complain about not finding.
-  cmsys::RegularExpression IncludeRegexScan;
-  cmsys::RegularExpression IncludeRegexComplain;
+    // Regex to transform #include lines.
+    cmsys::RegularExpression IncludeRegexTransform;
+  };
+  Matchers Regex;
+
+  // Whether the scan regex is the default that matches every file.
+  bool ScanAllIncludes;
   std::string IncludeRegexLineString;
   std::string IncludeRegexScanString;
   std::string IncludeRegexComplainString;
-
-  // Regex to transform #include lines.
   std::string IncludeRegexTransformString;
-  cmsys::RegularExpression IncludeRegexTransform;
+
   typedef std::map<std::string, std::string> TransformRulesType;
   TransformRulesType TransformRules;
   void SetupTransforms();
   void ParseTransform(std::string const& xform);
-  void TransformLine(std::string& line);
+  void TransformLine(std::string& line, Matchers& regex) const;
 
 public:
   // Data structures for dependency graph walk.
@@ -83,11 +96,62 @@ public:
     bool Used;
   };
 
+  // Result of a walk of the dependency graph from the sources of one
+  // object file.
+  struct ScanResult
+  {
+    std::set<std::string> Dependencies;
+    // Set if a file matching the complain regex cannot be found.
+    std::string MissingFile;
+  };
+
 protected:
+  // Walk the dependency graph starting with the given sources.  This
+  // may run concurrently for several object files.
+  void ScanDependencies(std::set<std::string> const& sources,
+                        Matchers& regex, ScanResult& result);
+
+  // Find a header in the include path.
+  std::string FindHeader(std::string const& fileName);
+
+  // Get the include lines of a file from the cache or scan it.
+  // Returns null if the file cannot be read.
+  cmIncludeLines const* GetIncludeLines(std::string const& fullName,
+                                        Matchers& regex);
+
+  // Add an entry to the file cache unless another walk added one for
+  // the same file first.  Returns the entry in the cache.
+  cmIncludeLines const* AddCacheEntry(std::string const& fullName,
+                                      cmIncludeLines* lines);
+
+  // Method to scan a single file.
+  void Scan(std::istream& is, const char* directory, Matchers& regex,
+            cmIncludeLines& lines) const;
+  void AddInclude(std::string fileName, bool quoted, const char* directory,
+                  Matchers& regex, cmIncludeLines& lines) const;
+
   const std::map<std::string, DependencyVector>* ValidDeps;
-  std::set<std::string> Encountered;
-  std::queue<UnscannedEntry> Unscanned;
 
+  // Results computed ahead by PrepareDependencies.
+  std::map<std::string, ScanResult> PreparedScans;
+
+  // The header caches are shared by all walks and guarded by the mutex.
+  // Entries of the file cache do not change once inserted except for
+  // their Used flag, which is set with the mutex held.
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  typedef std::mutex CacheMutexType;
+  typedef std::lock_guard<std::mutex> CacheLock;
+#else
+  // The bootstrap cmake scans on a single thread.
+  struct CacheMutexType
+  {
+  };
+  struct CacheLock
+  {
+    explicit CacheLock(CacheMutexType&) {}
+  };
+#endif
+  CacheMutexType CacheMutex;
   std::map<std::string, cmIncludeLines*> FileCache;
   std::map<std::string, std::string> HeaderLocationCache;
 
@@ -95,6 +159,24 @@ protected:
 
   void WriteCacheFile() const;
   void ReadCacheFile();
+
+  // Include lines of the headers scanned by any target in the build
+  // tree with the same scanning rules.  An entry is valid as long as
+  // the time stamp of its file does not change.
+  struct SharedCacheEntry
+  {
+    std::string Stamp;
+    std::vector<UnscannedEntry> UnscannedEntries;
+  };
+  typedef std::map<std::string, SharedCacheEntry> SharedCacheType;
+  std::string SharedCacheFileName;
+  // Loaded by the constructor and not modified afterwards.
+  SharedCacheType SharedCache;
+  // Entries scanned by this instance, guarded by the mutex.
+  SharedCacheType SharedCacheAdded;
+
+  void ReadSharedCacheFile(SharedCacheType& cache) const;
+  void WriteSharedCacheFile();
 };
 
 #endif
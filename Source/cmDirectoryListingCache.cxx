@@ -0,0 +1,261 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmDirectoryListingCache.h"
+
+#include "cmFileTimeComparison.h"
+#include "cmSystemTools.h"
+
+#include "cmsys/Directory.hxx"
+#include <string.h>
+#include <time.h>
+#include <utility>
+
+#if defined(_WIN32) || defined(__APPLE__)
+#  define CM_DIRECTORY_LISTING_FOLD_CASE
+#endif
+
+cmDirectoryListingCache::cmDirectoryListingCache()
+  : StatsAvoided(0)
+  , Lookups(0)
+  , DirectoriesRead(0)
+{
+}
+
+bool cmDirectoryListingCache::FileExists(std::string const& path, bool isFile)
+{
+  ++this->Lookups;
+  if (!this->IsListed(path)) {
+    ++this->StatsAvoided;
+    return false;
+  }
+  return cmSystemTools::FileExists(path, isFile);
+}
+
+bool cmDirectoryListingCache::FileIsDirectory(std::string const& path)
+{
+  ++this->Lookups;
+  if (!this->IsListed(path)) {
+    ++this->StatsAvoided;
+    return false;
+  }
+  return cmSystemTools::FileIsDirectory(path);
+}
+
+std::vector<std::string> const& cmDirectoryListingCache::GetNames(
+  std::string const& dir)
+{
+  return this->GetListing(dir).Names;
+}
+
+std::string const& cmDirectoryListingCache::GetStamp(std::string const& dir)
+{
+  Listing& listing = this->GetListing(dir);
+  if (!listing.StampChecked) {
+    listing.StampChecked = true;
+    // Allow for time stamps with a resolution of up to two seconds.
+    if (!listing.Stamp.empty() &&
+        cmSystemTools::ModifiedTime(dir) + 2 >= listing.ReadTime) {
+      listing.Stamp = "recent";
+    }
+  }
+  return listing.Stamp;
+}
+
+void cmDirectoryListingCache::Invalidate(std::string const& path)
+{
+  if (this->Listings.empty()) {
+    return;
+  }
+  // A path through a symlink and ".." may name any directory.
+  if (cmDirectoryListingCache::HasParentComponent(path)) {
+    this->Clear();
+    return;
+  }
+  std::string const full = cmSystemTools::CollapseFullPath(path);
+  std::string dir = cmDirectoryListingCache::ResolvePath(full);
+
+  // A symlink at the path changes the real path of everything below it.
+  this->EraseRealPaths(full);
+  if (dir != full) {
+    this->EraseRealPaths(dir);
+  }
+
+  // The path itself and everything below it.
+  std::string const below = dir + "/";
+  this->Listings.erase(dir);
+  auto i = this->Listings.lower_bound(below);
+  while (i != this->Listings.end() &&
+         i->first.compare(0, below.size(), below) == 0) {
+    i = this->Listings.erase(i);
+  }
+
+  // The directories above it, which may have gained an entry.
+  for (;;) {
+    std::string parent = cmSystemTools::GetFilenamePath(dir);
+    if (parent.empty() || parent == dir) {
+      break;
+    }
+    this->Listings.erase(parent);
+    dir = std::move(parent);
+  }
+
+  // Listings read through ".." may be any of the above.
+  for (i = this->Listings.begin(); i != this->Listings.end();) {
+    if (cmDirectoryListingCache::HasParentComponent(i->first)) {
+      i = this->Listings.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+void cmDirectoryListingCache::Clear()
+{
+  this->Listings.clear();
+  this->RealPaths.clear();
+}
+
+void cmDirectoryListingCache::EraseRealPaths(std::string const& path)
+{
+  std::string const below = path + "/";
+  for (auto i = this->RealPaths.begin(); i != this->RealPaths.end();) {
+    if (i->first == path || i->second == path ||
+        i->first.compare(0, below.size(), below) == 0 ||
+        i->second.compare(0, below.size(), below) == 0) {
+      i = this->RealPaths.erase(i);
+    } else {
+      ++i;
+    }
+  }
+}
+
+cmDirectoryListingCache::Listing& cmDirectoryListingCache::GetListing(
+  std::string const& dir)
+{
+  // Collapsing ".." after a symlink would name another directory than
+  // the system resolves, so such paths are kept as given.
+  std::string const key = cmDirectoryListingCache::HasParentComponent(dir)
+    ? dir
+    : this->GetRealPath(cmSystemTools::CollapseFullPath(dir));
+  auto i = this->Listings.find(key);
+  if (i != this->Listings.end()) {
+    return i->second;
+  }
+
+  Listing& listing = this->Listings[key];
+  ++this->DirectoriesRead;
+  listing.ReadTime = static_cast<long>(time(nullptr));
+  cmFileTimeComparison::FileTimeStamp(key.c_str(), listing.Stamp);
+  cmsys::Directory d;
+  if (!d.Load(key)) {
+    // A directory we cannot read may still contain files.
+    listing.Known = !cmSystemTools::FileIsDirectory(key);
+  } else {
+    listing.Known = true;
+    unsigned long const n = d.GetNumberOfFiles();
+    listing.Names.reserve(n);
+    for (unsigned long f = 0; f < n; ++f) {
+      const char* name = d.GetFile(f);
+      if (strcmp(name, ".") != 0 && strcmp(name, "..") != 0) {
+        listing.Names.push_back(name);
+        listing.Lookup.insert(cmDirectoryListingCache::FoldCase(name));
+      }
+    }
+  }
+  return listing;
+}
+
+std::string const& cmDirectoryListingCache::GetRealPath(
+  std::string const& path)
+{
+  auto i = this->RealPaths.find(path);
+  if (i == this->RealPaths.end()) {
+    i = this->RealPaths
+          .insert(std::make_pair(path,
+                                 cmDirectoryListingCache::ResolvePath(path)))
+          .first;
+  }
+  return i->second;
+}
+
+bool cmDirectoryListingCache::IsListed(std::string const& path)
+{
+  // Leave paths without a directory and a name to the disk.
+  std::string::size_type end = path.find_last_not_of('/');
+  if (end == std::string::npos) {
+    return true;
+  }
+  std::string::size_type const slash = path.find_last_of('/', end);
+  if (slash == std::string::npos || slash == 0) {
+    return true;
+  }
+  std::string const name = path.substr(slash + 1, end - slash);
+  if (name == "." || name == "..") {
+    return true;
+  }
+#ifdef CM_DIRECTORY_LISTING_FOLD_CASE
+  // Only ASCII names are folded the way the file system does it.
+  for (char c : name) {
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      return true;
+    }
+  }
+#endif
+  std::string const dir = path.substr(0, slash);
+  if (cmDirectoryListingCache::HasParentComponent(dir)) {
+    return true;
+  }
+#if defined(_WIN32)
+  // A drive letter is not a directory we can list by itself.
+  if (dir.size() == 2 && dir[1] == ':') {
+    return true;
+  }
+#endif
+  Listing const& listing = this->GetListing(dir);
+  return !listing.Known ||
+    listing.Lookup.count(cmDirectoryListingCache::FoldCase(name)) != 0;
+}
+
+bool cmDirectoryListingCache::HasParentComponent(std::string const& path)
+{
+  std::string::size_type pos = 0;
+  while ((pos = path.find("..", pos)) != std::string::npos) {
+    std::string::size_type const end = pos + 2;
+    if ((pos == 0 || path[pos - 1] == '/' || path[pos - 1] == '\\') &&
+        (end == path.size() || path[end] == '/' || path[end] == '\\')) {
+      return true;
+    }
+    pos = end;
+  }
+  return false;
+}
+
+std::string cmDirectoryListingCache::FoldCase(std::string const& name)
+{
+#ifdef CM_DIRECTORY_LISTING_FOLD_CASE
+  return cmSystemTools::LowerCase(name);
+#else
+  return name;
+#endif
+}
+
+std::string cmDirectoryListingCache::ResolvePath(std::string const& path)
+{
+  // Resolve the longest leading part that exists, which holds all the
+  // symlinks the path goes through.
+  std::string existing = path;
+  std::string rest;
+  for (;;) {
+    std::string error;
+    std::string const real = cmSystemTools::GetRealPath(existing, &error);
+    if (error.empty() && !real.empty()) {
+      return real + rest;
+    }
+    std::string const parent = cmSystemTools::GetFilenamePath(existing);
+    if (parent.empty() || parent == existing) {
+      return path;
+    }
+    rest.insert(0, "/" + cmSystemTools::GetFilenameName(existing));
+    existing = parent;
+  }
+}
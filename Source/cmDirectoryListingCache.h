@@ -0,0 +1,106 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmDirectoryListingCache_h
+#define cmDirectoryListingCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/** \class cmDirectoryListingCache
+ * \brief Answer file existence checks of the find commands from memory.
+ *
+ * The find commands probe many candidate paths in the same few
+ * directories.  Each directory is read once, and a candidate whose
+ * name is not listed in its directory is reported missing without a
+ * stat() call.  A listed candidate is still checked on disk, so only
+ * negative answers come from the cache.  On platforms whose file
+ * systems are usually case-insensitive names are compared case-folded.
+ * Paths with a ".." component are left to the disk, since the directory
+ * they name depends on the symlinks before it.  Other directories are
+ * listed under their real path, so that a change made through one path
+ * of a directory also drops the listing read through a symlink to it.
+ *
+ * Listings are kept for the whole configure step.  Commands that
+ * write files tell the cache which paths changed, or clear it if they
+ * may write anywhere.
+ */
+class cmDirectoryListingCache
+{
+public:
+  cmDirectoryListingCache();
+
+  CM_DISABLE_COPY(cmDirectoryListingCache)
+
+  /** Return whether \a path exists, as cmSystemTools::FileExists.  */
+  bool FileExists(std::string const& path, bool isFile = false);
+
+  /** Return whether \a path is a directory.  */
+  bool FileIsDirectory(std::string const& path);
+
+  /** Get the names in directory \a dir in the order the system lists
+      them, without "." and "..".  */
+  std::vector<std::string> const& GetNames(std::string const& dir);
+
+  /** Get the time stamp that directory \a dir had just before its
+      names were read, as cmFileTimeComparison::FileTimeStamp, or an
+      empty string if it did not exist.  A later stamp that differs
+      means the listing may no longer be accurate.  A directory that
+      was modified too shortly before it was read may change again
+      without a new stamp, so its stamp is a value that never matches
+      one read from disk.  */
+  std::string const& GetStamp(std::string const& dir);
+
+  /** Forget the listings that a change of \a path may affect: the path
+      itself, the directories above it and the directories below it.  */
+  void Invalidate(std::string const& path);
+
+  /** Forget all listings.  */
+  void Clear();
+
+  /** Number of existence checks answered without a stat() call.  */
+  unsigned long GetStatsAvoided() const { return this->StatsAvoided; }
+
+  /** Number of existence checks made through the cache.  */
+  unsigned long GetLookups() const { return this->Lookups; }
+
+  /** Number of directories read from disk.  */
+  unsigned long GetDirectoriesRead() const { return this->DirectoriesRead; }
+
+private:
+  struct Listing
+  {
+    Listing()
+      : Known(false)
+      , StampChecked(false)
+      , ReadTime(0)
+    {
+    }
+    bool Known;
+    bool StampChecked;
+    long ReadTime;
+    std::string Stamp;
+    std::vector<std::string> Names;
+    std::unordered_set<std::string> Lookup;
+  };
+
+  Listing& GetListing(std::string const& dir);
+  std::string const& GetRealPath(std::string const& path);
+  bool IsListed(std::string const& path);
+  void EraseRealPaths(std::string const& path);
+
+  static bool HasParentComponent(std::string const& path);
+  static std::string FoldCase(std::string const& name);
+  static std::string ResolvePath(std::string const& path);
+
+  std::map<std::string, Listing> Listings;
+  std::map<std::string, std::string> RealPaths;
+  unsigned long StatsAvoided;
+  unsigned long Lookups;
+  unsigned long DirectoriesRead;
+};
+
+#endif
@@ -5,6 +5,8 @@
 #include "cmsys/Process.h"
 #include <stdio.h>
 
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmProcessOutput.h"
 #include "cmSystemTools.h"
@@ -80,6 +82,8 @@ bool cmExecProgramCommand::InitialPass(std::vector<std::string> const& args,
   int retVal = 0;
   std::string output;
   bool result = true;
+  // The program may write files anywhere.
+  this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache().Clear();
   if (args.size() - count == 2) {
     cmSystemTools::MakeDirectory(args[1]);
     result = cmExecProgramCommand::RunCommand(command.c_str(), output, retVal,
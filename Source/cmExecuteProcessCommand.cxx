@@ -8,6 +8,8 @@
 #include <stdio.h>
 
 #include "cmAlgorithms.h"
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmProcessOutput.h"
 #include "cmSystemTools.h"
@@ -233,6 +235,9 @@ bool cmExecuteProcessCommand::InitialPass(std::vector<std::string> const& args,
     cmsysProcess_SetTimeout(cp, timeout);
   }
 
+  // The process may write files anywhere.
+  this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache().Clear();
+
   // Start the process.
   cmsysProcess_Execute(cp);
 
@@ -21,6 +21,7 @@
 #include "cmAlgorithms.h"
 #include "cmCommandArgumentsHelper.h"
 #include "cmCryptoHash.h"
+#include "cmDirectoryListingCache.h"
 #include "cmFSPermissions.h"
 #include "cmFileLockPool.h"
 #include "cmFileTimeComparison.h"
@@ -87,6 +88,7 @@ bool cmFileCommand::InitialPass(std::vector<std::string> const& args,
     this->SetError("must be called with at least two arguments.");
     return false;
   }
+  this->InvalidateDirectoryListings(args);
   std::string const& subCommand = args[0];
   if (subCommand == "WRITE") {
     return this->HandleWriteCommand(args, false);
@@ -182,6 +184,34 @@ bool cmFileCommand::InitialPass(std::vector<std::string> const& args,
   return false;
 }
 
+void cmFileCommand::InvalidateDirectoryListings(
+  std::vector<std::string> const& args)
+{
+  cmDirectoryListingCache& listings =
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
+  std::string const& subCommand = args[0];
+  std::vector<std::string>::const_iterator first = args.begin() + 1;
+  std::vector<std::string>::const_iterator last = first;
+  if (subCommand == "WRITE" || subCommand == "APPEND") {
+    last = first + 1;
+  } else if (subCommand == "RENAME") {
+    last = args.size() > 2 ? first + 2 : args.end();
+  } else if (subCommand == "MAKE_DIRECTORY" || subCommand == "REMOVE" ||
+             subCommand == "REMOVE_RECURSE" || subCommand == "TOUCH" ||
+             subCommand == "TOUCH_NOCREATE") {
+    last = args.end();
+  } else if (subCommand == "DOWNLOAD" || subCommand == "COPY" ||
+             subCommand == "INSTALL" || subCommand == "LOCK") {
+    // These may create files in places not named by one argument.
+    listings.Clear();
+    return;
+  }
+  for (; first != last; ++first) {
+    listings.Invalidate(cmSystemTools::CollapseFullPath(
+      *first, this->Makefile->GetCurrentSourceDirectory()));
+  }
+}
+
 bool cmFileCommand::HandleWriteCommand(std::vector<std::string> const& args,
                                        bool append)
 {
@@ -61,6 +61,7 @@ protected:
   bool HandleLockCommand(std::vector<std::string> const& args);
 
 private:
+  void InvalidateDirectoryListings(std::vector<std::string> const& args);
   void AddEvaluationFile(const std::string& inputName,
                          const std::string& outputExpr,
                          const std::string& condition, bool inputIsContent);
@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFileTimeComparison.h"
 
+#include <sstream>
 #include <string>
 #include <time.h>
 #include <unordered_map>
@@ -94,6 +95,36 @@ bool cmFileTimeComparison::FileTimesDiffer(const char* f1, const char* f2)
   return this->Internals->FileTimesDiffer(f1, f2);
 }
 
+bool cmFileTimeComparison::FileTimeStamp(const char* f, std::string& stamp)
+{
+  std::ostringstream s;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  struct stat st;
+  if (::stat(f, &st) != 0) {
+    return false;
+  }
+#  if CMake_STAT_HAS_ST_MTIM
+  s << st.st_mtim.tv_sec << '.' << st.st_mtim.tv_nsec;
+#  elif CMake_STAT_HAS_ST_MTIMESPEC
+  s << st.st_mtimespec.tv_sec << '.' << st.st_mtimespec.tv_nsec;
+#  else
+  s << st.st_mtime;
+#  endif
+  s << ' ' << st.st_size;
+#else
+  WIN32_FILE_ATTRIBUTE_DATA fdata;
+  if (!GetFileAttributesExW(cmsys::Encoding::ToWide(f).c_str(),
+                            GetFileExInfoStandard, &fdata)) {
+    return false;
+  }
+  s << fdata.ftLastWriteTime.dwHighDateTime << '.'
+    << fdata.ftLastWriteTime.dwLowDateTime << ' ' << fdata.nFileSizeHigh
+    << '.' << fdata.nFileSizeLow;
+#endif
+  stamp = s.str();
+  return true;
+}
+
 int cmFileTimeComparisonInternal::Compare(cmFileTimeComparison_Type* s1,
                                           cmFileTimeComparison_Type* s2)
 {
@@ -5,6 +5,8 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <string>
+
 class cmFileTimeComparisonInternal;
 
 /** \class cmFileTimeComparison
@@ -32,6 +34,15 @@ public:
    */
   bool FileTimesDiffer(const char* f1, const char* f2);
 
+  /**
+   *  Get a string that changes whenever the file is modified, built
+   *  from its modification time at the best resolution available and
+   *  its size.  Return false if the file does not exist.  Unlike the
+   *  other methods this does not cache anything and may be called
+   *  from any thread.
+   */
+  static bool FileTimeStamp(const char* f, std::string& stamp);
+
 protected:
   cmFileTimeComparisonInternal* Internals;
 };
@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "cmDirectoryListingCache.h"
 #include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmState.h"
@@ -110,14 +111,16 @@ void cmFindLibraryCommand::AddArchitecturePath(
 {
   std::string::size_type pos = dir.find("lib/", start_pos);
 
+  cmDirectoryListingCache& listings =
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
   if (pos != std::string::npos) {
     // Check for "lib".
     std::string lib = dir.substr(0, pos + 3);
-    bool use_lib = cmSystemTools::FileIsDirectory(lib);
+    bool use_lib = listings.FileIsDirectory(lib);
 
     // Check for "lib<suffix>" and use it first.
     std::string libX = lib + suffix;
-    bool use_libX = cmSystemTools::FileIsDirectory(libX);
+    bool use_libX = listings.FileIsDirectory(libX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_libX && use_lib && cmLibDirsLinked(libX, lib)) {
@@ -137,11 +140,11 @@ void cmFindLibraryCommand::AddArchitecturePath(
 
   if (fresh) {
     // Check for the original unchanged path.
-    bool use_dir = cmSystemTools::FileIsDirectory(dir);
+    bool use_dir = listings.FileIsDirectory(dir);
 
     // Check for <dir><suffix>/ and use it first.
     std::string dirX = dir + suffix;
-    bool use_dirX = cmSystemTools::FileIsDirectory(dirX);
+    bool use_dirX = listings.FileIsDirectory(dirX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_dirX && use_dir && cmLibDirsLinked(dirX, dir)) {
@@ -353,7 +356,8 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
   if (name.TryRaw) {
     this->TestPath = path;
     this->TestPath += name.Raw;
-    if (cmSystemTools::FileExists(this->TestPath, true)) {
+    if (this->GG->GetDirectoryListingCache().FileExists(this->TestPath,
+                                                        true)) {
       this->BestPath = cmSystemTools::CollapseFullPath(this->TestPath);
       cmSystemTools::ConvertToUnixSlashes(this->BestPath);
       return true;
@@ -464,6 +468,8 @@ std::string cmFindLibraryCommand::FindFrameworkLibrary()
 
 std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
 {
+  cmDirectoryListingCache& listings =
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
   std::string fwPath;
   // Search for all names in each search path.
   for (std::string const& d : this->SearchPaths) {
@@ -471,7 +477,7 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
       fwPath = d;
       fwPath += n;
       fwPath += ".framework";
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (listings.FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -483,6 +489,8 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
 
 std::string cmFindLibraryCommand::FindFrameworkLibraryDirsPerName()
 {
+  cmDirectoryListingCache& listings =
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
   std::string fwPath;
   // Search for each name in all search paths.
   for (std::string const& n : this->Names) {
@@ -490,7 +498,7 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryDirsPerName()
       fwPath = d;
       fwPath += n;
       fwPath += ".framework";
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (listings.FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -20,6 +20,8 @@
 #include <utility>
 
 #include "cmAlgorithms.h"
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmPolicies.h"
 #include "cmSearchPath.h"
@@ -28,6 +30,10 @@
 #include "cmVersion.h"
 #include "cmake.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmFindPackageConfigCache.h"
+#endif
+
 #if defined(__HAIKU__)
 #  include <FindDirectory.h>
 #  include <StorageDefs.h>
@@ -110,6 +116,7 @@ cmFindPackageCommand::cmFindPackageCommand()
   this->RequiredCMakeVersion = 0;
   this->SortOrder = None;
   this->SortDirection = Asc;
+  this->WatchDirectories = false;
   this->AppendSearchPathGroups();
 }
 
@@ -927,6 +934,15 @@ bool cmFindPackageCommand::FindConfig()
   // Look for the project's configuration file.
   bool found = false;
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Try the result of an earlier search with the same inputs.
+  std::unique_ptr<cmFindPackageConfigCache> configCache =
+    this->CreateConfigCache();
+  bool const cached = configCache && this->FindCachedConfig(*configCache);
+  found = cached;
+  this->WatchDirectories = configCache && !cached;
+#endif
+
   // Search for frameworks.
   if (!found && (this->SearchFrameworkFirst || this->SearchFrameworkOnly)) {
     found = this->FindFrameworkConfig();
@@ -952,6 +968,14 @@ bool cmFindPackageCommand::FindConfig()
     found = this->FindAppBundleConfig();
   }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (found && !cached && configCache) {
+    this->StoreCachedConfig(*configCache);
+  }
+  this->WatchDirectories = false;
+  this->WatchedDirectories.clear();
+#endif
+
   // Store the entry in the cache so it can be set by the user.
   std::string init;
   if (found) {
@@ -969,6 +993,98 @@ bool cmFindPackageCommand::FindConfig()
   return found;
 }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+std::unique_ptr<cmFindPackageConfigCache>
+cmFindPackageCommand::CreateConfigCache() const
+{
+  std::unique_ptr<cmFindPackageConfigCache> cache;
+  std::string dir =
+    this->Makefile->GetSafeDefinition("CMAKE_FIND_PACKAGE_CACHE_DIR");
+  if (dir.empty()) {
+    cmSystemTools::GetEnv("CMAKE_FIND_PACKAGE_CACHE_DIR", dir);
+  }
+  if (dir.empty()) {
+    return cache;
+  }
+
+  // Everything the order of the candidates depends on.  Each list is
+  // preceded by its size so that no two sets of inputs look the same.
+  std::vector<std::string> inputs;
+  auto addList = [&inputs](std::vector<std::string> const& l) {
+    inputs.push_back(std::to_string(l.size()));
+    inputs.insert(inputs.end(), l.begin(), l.end());
+  };
+  inputs.push_back(this->Name);
+  addList(this->Names);
+  addList(this->Configs);
+  addList(this->SearchPaths);
+  addList(this->SearchPathSuffixes);
+  addList(std::vector<std::string>(this->IgnoredPaths.begin(),
+                                   this->IgnoredPaths.end()));
+  inputs.push_back(this->Version);
+  inputs.push_back(this->LibraryArchitecture);
+  std::string flags;
+  for (bool f :
+       { this->VersionExact, this->UseLib32Paths, this->UseLib64Paths,
+         this->UseLibx32Paths, this->SearchFrameworkFirst,
+         this->SearchFrameworkOnly, this->SearchFrameworkLast,
+         this->SearchAppBundleFirst, this->SearchAppBundleOnly,
+         this->SearchAppBundleLast }) {
+    flags += f ? '1' : '0';
+  }
+  inputs.push_back(flags);
+  inputs.push_back(std::to_string(this->SortOrder));
+  inputs.push_back(std::to_string(this->SortDirection));
+  cache = cm::make_unique<cmFindPackageConfigCache>(dir, inputs);
+  return cache;
+}
+
+bool cmFindPackageCommand::FindCachedConfig(
+  cmFindPackageConfigCache const& cache)
+{
+  cmFindPackageConfigCache::Entry entry;
+  if (!cache.Load(entry)) {
+    return false;
+  }
+
+  // The directories did not change, so the search would consider the
+  // same candidates in the same order.  Their version files may answer
+  // differently now, so ask them again.
+  bool valid = true;
+  for (std::string const& r : entry.Rejected) {
+    if (this->CheckVersion(r)) {
+      valid = false;
+      break;
+    }
+  }
+  if (!valid || !this->CheckVersion(entry.ConfigFile)) {
+    this->ConsideredConfigs.clear();
+    return false;
+  }
+  if (this->DebugMode) {
+    fprintf(stderr, "Using cached file [%s]\n", entry.ConfigFile.c_str());
+  }
+  this->FileFound = entry.ConfigFile;
+  return true;
+}
+
+void cmFindPackageCommand::StoreCachedConfig(
+  cmFindPackageConfigCache const& cache)
+{
+  // Every candidate considered before the one found was rejected.
+  cmFindPackageConfigCache::Entry entry;
+  entry.ConfigFile = this->FileFound;
+  for (ConfigFileInfo const& c : this->ConsideredConfigs) {
+    entry.Rejected.push_back(c.filename);
+  }
+  if (!entry.Rejected.empty()) {
+    entry.Rejected.pop_back();
+  }
+  entry.Directories = this->WatchedDirectories;
+  cache.Store(entry);
+}
+#endif
+
 bool cmFindPackageCommand::FindPrefixedConfig()
 {
   std::vector<std::string> const& prefixes = this->SearchPaths;
@@ -1473,7 +1589,7 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
     if (this->DebugMode) {
       fprintf(stderr, "Checking file [%s]\n", file.c_str());
     }
-    if (cmSystemTools::FileExists(file, true) && this->CheckVersion(file)) {
+    if (this->ListedFileExists(file) && this->CheckVersion(file)) {
       return true;
     }
   }
@@ -1493,7 +1609,7 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
   // Look for foo-config-version.cmake
   std::string version_file = version_file_base;
   version_file += "-version.cmake";
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult && this->ListedFileExists(version_file)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
@@ -1501,7 +1617,7 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
   // Look for fooConfigVersion.cmake
   version_file = version_file_base;
   version_file += "Version.cmake";
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult && this->ListedFileExists(version_file)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
@@ -1674,6 +1790,14 @@ public:
     return false;
   }
 
+  // Get the names in a directory.  They are copied because considering
+  // a match may run code that invalidates the listing.
+  virtual std::vector<std::string> GetNames(std::string const& dir) = 0;
+
+  // Whether the directories a search reads are recorded to tell later
+  // whether its result may have changed.
+  virtual bool IsWatchingDirectories() const = 0;
+
 private:
   virtual bool Visit(std::string const& fullPath) = 0;
   friend class cmFileListGeneratorBase;
@@ -1691,6 +1815,16 @@ public:
   {
   }
 
+  std::vector<std::string> GetNames(std::string const& dir) override
+  {
+    return this->FPC->ListDirectory(dir);
+  }
+
+  bool IsWatchingDirectories() const override
+  {
+    return this->FPC->WatchDirectories;
+  }
+
 private:
   bool Visit(std::string const& fullPath) override
   {
@@ -1822,15 +1956,10 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname : lister.GetNames(parent)) {
       for (std::string const& n : this->Names) {
-        if (cmsysString_strncasecmp(fname, n.c_str(), n.length()) == 0) {
+        if (cmsysString_strncasecmp(fname.c_str(), n.c_str(), n.length()) ==
+            0) {
           matches.push_back(fname);
         }
       }
@@ -1882,16 +2011,10 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname : lister.GetNames(parent)) {
       for (std::string name : this->Names) {
         name += this->Extension;
-        if (cmsysString_strcasecmp(fname, name.c_str()) == 0) {
+        if (cmsysString_strcasecmp(fname.c_str(), name.c_str()) == 0) {
           matches.push_back(fname);
         }
       }
@@ -1932,15 +2055,8 @@ private:
   bool Search(std::string const& parent, cmFileList& lister) override
   {
     // Look for matching files.
-    std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
-      if (cmsysString_strcasecmp(fname, this->String.c_str()) == 0) {
+    for (std::string const& fname : lister.GetNames(parent)) {
+      if (cmsysString_strcasecmp(fname.c_str(), this->String.c_str()) == 0) {
         if (this->Consider(parent + fname, lister)) {
           return true;
         }
@@ -1974,6 +2090,13 @@ private:
   std::string Pattern;
   bool Search(std::string const& parent, cmFileList& lister) override
   {
+    // The matches depend on the directories the pattern descends into.
+    if (lister.IsWatchingDirectories()) {
+      for (std::string const& name : lister.GetNames(parent)) {
+        lister.GetNames(parent + name);
+      }
+    }
+
     // Glob the set of matching files.
     std::string expr = parent;
     expr += this->Pattern;
@@ -2007,7 +2130,7 @@ bool cmFindPackageCommand::SearchPrefix(std::string const& prefix_in)
   }
 
   // Skip this if the prefix does not exist.
-  if (!cmSystemTools::FileIsDirectory(prefix_in)) {
+  if (!this->ListedFileIsDirectory(prefix_in)) {
     return false;
   }
 
@@ -2253,4 +2376,49 @@ bool cmFindPackageCommand::SearchAppBundlePrefix(std::string const& prefix_in)
   return false;
 }
 
+bool cmFindPackageCommand::ListedFileExists(std::string const& path)
+{
+  this->WatchDirectory(cmSystemTools::GetFilenamePath(path));
+  return this->Makefile->GetGlobalGenerator()
+    ->GetDirectoryListingCache()
+    .FileExists(path, true);
+}
+
+bool cmFindPackageCommand::ListedFileIsDirectory(std::string const& path)
+{
+  std::string::size_type const end = path.find_last_not_of('/');
+  if (end != std::string::npos) {
+    this->WatchDirectory(
+      cmSystemTools::GetFilenamePath(path.substr(0, end + 1)));
+  }
+  return this->Makefile->GetGlobalGenerator()
+    ->GetDirectoryListingCache()
+    .FileIsDirectory(path);
+}
+
+std::vector<std::string> cmFindPackageCommand::ListDirectory(
+  std::string const& dir)
+{
+  this->WatchDirectory(dir);
+  return this->Makefile->GetGlobalGenerator()
+    ->GetDirectoryListingCache()
+    .GetNames(dir);
+}
+
+void cmFindPackageCommand::WatchDirectory(std::string const& dir)
+{
+  if (!this->WatchDirectories || dir.empty()) {
+    return;
+  }
+  std::string key = dir;
+  if (key.size() > 1 && key.back() == '/') {
+    key.pop_back();
+  }
+  if (this->WatchedDirectories.find(key) == this->WatchedDirectories.end()) {
+    this->WatchedDirectories[key] = this->Makefile->GetGlobalGenerator()
+                                      ->GetDirectoryListingCache()
+                                      .GetStamp(key);
+  }
+}
+
 // TODO: Debug cmsys::Glob double slash problem.
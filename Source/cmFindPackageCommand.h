@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -28,6 +29,7 @@ namespace std {
 
 class cmCommand;
 class cmExecutionStatus;
+class cmFindPackageConfigCache;
 class cmSearchPath;
 
 /** \class cmFindPackageCommand
@@ -104,6 +106,11 @@ private:
   bool FindPrefixedConfig();
   bool FindFrameworkConfig();
   bool FindAppBundleConfig();
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  std::unique_ptr<cmFindPackageConfigCache> CreateConfigCache() const;
+  bool FindCachedConfig(cmFindPackageConfigCache const& cache);
+  void StoreCachedConfig(cmFindPackageConfigCache const& cache);
+#endif
   enum PolicyScopeRule
   {
     NoPolicyScope,
@@ -138,6 +145,10 @@ private:
   bool SearchPrefix(std::string const& prefix);
   bool SearchFrameworkPrefix(std::string const& prefix_in);
   bool SearchAppBundlePrefix(std::string const& prefix_in);
+  bool ListedFileExists(std::string const& path);
+  bool ListedFileIsDirectory(std::string const& path);
+  std::vector<std::string> ListDirectory(std::string const& dir);
+  void WatchDirectory(std::string const& dir);
 
   friend class cmFindPackageFileList;
 
@@ -208,6 +219,12 @@ private:
   };
   std::vector<ConfigFileInfo> ConsideredConfigs;
 
+  // The directories whose listings decided the search for a
+  // configuration file, with their time stamps, while WatchDirectories
+  // is set.
+  bool WatchDirectories;
+  std::map<std::string, std::string> WatchedDirectories;
+
   friend struct std::hash<ConfigFileInfo>;
 };
 
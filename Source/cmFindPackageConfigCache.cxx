@@ -0,0 +1,104 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmFindPackageConfigCache.h"
+
+#include "cmFileTimeComparison.h"
+#include "cmSystemTools.h"
+
+#include <sstream>
+
+namespace {
+char const Magic[] = "CMakeFindPackageConfigCache 2";
+
+// Whether a path can be stored on a line of its own.
+bool IsLine(std::string const& s)
+{
+  return s.find_first_of("\r\n") == std::string::npos;
+}
+}
+
+cmFindPackageConfigCache::cmFindPackageConfigCache(
+  std::string const& directory, std::vector<std::string> const& inputs)
+  : File(directory, Magic, inputs)
+{
+}
+
+bool cmFindPackageConfigCache::Load(Entry& entry) const
+{
+  std::string content;
+  if (!this->File.Read(content)) {
+    return false;
+  }
+  std::istringstream fin(content);
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(fin, entry.ConfigFile)) {
+    return false;
+  }
+
+  // The rejected candidates, then the directories with their stamps,
+  // each group preceded by its size.
+  entry.Rejected.clear();
+  entry.Directories.clear();
+  unsigned long n;
+  if (!cmSystemTools::GetLineFromStream(fin, line) ||
+      !cmSystemTools::StringToULong(line.c_str(), &n)) {
+    return false;
+  }
+  for (; n > 0; --n) {
+    if (!cmSystemTools::GetLineFromStream(fin, line)) {
+      return false;
+    }
+    entry.Rejected.push_back(line);
+  }
+  if (!cmSystemTools::GetLineFromStream(fin, line) ||
+      !cmSystemTools::StringToULong(line.c_str(), &n)) {
+    return false;
+  }
+  for (; n > 0; --n) {
+    std::string dir;
+    if (!cmSystemTools::GetLineFromStream(fin, dir) ||
+        !cmSystemTools::GetLineFromStream(fin, line)) {
+      return false;
+    }
+    if (!cmFindPackageConfigCache::StampMatches(dir, line)) {
+      return false;
+    }
+    entry.Directories[dir] = line;
+  }
+  return cmSystemTools::GetLineFromStream(fin, line) && line == "end";
+}
+
+bool cmFindPackageConfigCache::Store(Entry const& entry) const
+{
+  std::ostringstream out;
+  bool lines = IsLine(entry.ConfigFile);
+  out << entry.ConfigFile << "\n";
+  out << entry.Rejected.size() << "\n";
+  for (std::string const& r : entry.Rejected) {
+    lines = lines && IsLine(r);
+    out << r << "\n";
+  }
+  out << entry.Directories.size() << "\n";
+  for (auto const& d : entry.Directories) {
+    // A directory that changed since it was listed may have changed
+    // the result of the search.
+    if (!cmFindPackageConfigCache::StampMatches(d.first, d.second)) {
+      return false;
+    }
+    lines = lines && IsLine(d.first);
+    out << d.first << "\n" << d.second << "\n";
+  }
+  out << "end\n";
+  if (!lines) {
+    return false;
+  }
+  return this->File.Write(out.str());
+}
+
+bool cmFindPackageConfigCache::StampMatches(std::string const& dir,
+                                            std::string const& stamp)
+{
+  std::string current;
+  cmFileTimeComparison::FileTimeStamp(dir.c_str(), current);
+  return current == stamp;
+}
@@ -0,0 +1,52 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmFindPackageConfigCache_h
+#define cmFindPackageConfigCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmSharedCacheEntry.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+/** \class cmFindPackageConfigCache
+ * \brief Remember where find_package found a configuration file.
+ *
+ * An entry is stored in a cmSharedCacheEntry named by everything the
+ * search depends on, such as the package names and the list of search
+ * prefixes.  The entry holds the configuration file found, the
+ * candidates rejected by their version files before it, and the time
+ * stamps of the directories whose listings decided the search.  The
+ * entry is used only if none of those directories changed since.
+ */
+class cmFindPackageConfigCache
+{
+public:
+  struct Entry
+  {
+    std::string ConfigFile;
+    std::vector<std::string> Rejected;
+    /** Directory time stamps, or empty for a missing directory.  */
+    std::map<std::string, std::string> Directories;
+  };
+
+  cmFindPackageConfigCache(std::string const& directory,
+                           std::vector<std::string> const& inputs);
+
+  CM_DISABLE_COPY(cmFindPackageConfigCache)
+
+  /** Read the entry and check that its directories did not change.  */
+  bool Load(Entry& entry) const;
+
+  /** Write the entry unless one of its directories changed already.  */
+  bool Store(Entry const& entry) const;
+
+private:
+  static bool StampMatches(std::string const& dir, std::string const& stamp);
+
+  cmSharedCacheEntry File;
+};
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "cmsys/Glob.hxx"
 
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmStateTypes.h"
 #include "cmSystemTools.h"
@@ -94,7 +96,9 @@ std::string cmFindPathCommand::FindHeaderInFramework(std::string const& file,
       std::string intPath = fpath;
       intPath += "/Headers/";
       intPath += fileName;
-      if (cmSystemTools::FileExists(intPath)) {
+      cmDirectoryListingCache& listings =
+        this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
+      if (listings.FileExists(intPath)) {
         if (this->IncludeFileInPath) {
           return intPath;
         }
@@ -123,12 +127,14 @@ std::string cmFindPathCommand::FindHeaderInFramework(std::string const& file,
 
 std::string cmFindPathCommand::FindNormalHeader()
 {
+  cmDirectoryListingCache& listings =
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache();
   std::string tryPath;
   for (std::string const& n : this->Names) {
     for (std::string const& sp : this->SearchPaths) {
       tryPath = sp;
       tryPath += n;
-      if (cmSystemTools::FileExists(tryPath)) {
+      if (listings.FileExists(tryPath)) {
         if (this->IncludeFileInPath) {
           return tryPath;
         }
@@ -2,6 +2,8 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFindProgramCommand.h"
 
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmStateTypes.h"
 #include "cmSystemTools.h"
@@ -14,7 +16,8 @@ class cmExecutionStatus;
 
 struct cmFindProgramHelper
 {
-  cmFindProgramHelper()
+  cmFindProgramHelper(cmDirectoryListingCache& listings)
+    : Listings(listings)
   {
 #if defined(_WIN32) || defined(__CYGWIN__) || defined(__MINGW32__)
     // Consider platform-specific extensions.
@@ -25,6 +28,9 @@ struct cmFindProgramHelper
     this->Extensions.emplace_back();
   }
 
+  // Directory listings to check candidates against.
+  cmDirectoryListingCache& Listings;
+
   // List of valid extensions.
   std::vector<std::string> Extensions;
 
@@ -79,7 +85,7 @@ struct cmFindProgramHelper
       this->TestPath =
         cmSystemTools::CollapseCombinedPath(path, this->TestNameExt);
 
-      if (cmSystemTools::FileExists(this->TestPath, true)) {
+      if (this->Listings.FileExists(this->TestPath, true)) {
         this->BestPath = this->TestPath;
         return true;
       }
@@ -158,7 +164,8 @@ std::string cmFindProgramCommand::FindNormalProgram()
 std::string cmFindProgramCommand::FindNormalProgramNamesPerDir()
 {
   // Search for all names in each directory.
-  cmFindProgramHelper helper;
+  cmFindProgramHelper helper(
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache());
   for (std::string const& n : this->Names) {
     helper.AddName(n);
   }
@@ -181,7 +188,8 @@ std::string cmFindProgramCommand::FindNormalProgramNamesPerDir()
 std::string cmFindProgramCommand::FindNormalProgramDirsPerName()
 {
   // Search the entire path for each name.
-  cmFindProgramHelper helper;
+  cmFindProgramHelper helper(
+    this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache());
   for (std::string const& n : this->Names) {
     // Switch to searching for this name.
     helper.SetName(n);
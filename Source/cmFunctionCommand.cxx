@@ -9,6 +9,11 @@
 #include "cmMakefile.h"
 #include "cmPolicies.h"
 #include "cmState.h"
+#include "cmake.h"
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmMakefileProfilingData.h"
+#endif
 
 // define the class for function commands
 class cmFunctionHelperCommand : public cmCommand
@@ -55,6 +60,13 @@ public:
 bool cmFunctionHelperCommand::InvokeInitialPass(
   const std::vector<cmListFileArgument>& args, cmExecutionStatus& inStatus)
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (cmMakefileProfilingData* profiling =
+        this->Makefile->GetCMakeInstance()->GetProfilingOutput()) {
+    profiling->SetEntryCategory("function");
+  }
+#endif
+
   // Expand the argument list to the function.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
@@ -7,8 +7,57 @@
 #include "cmSystemTools.h"
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmWorkerPool.h"
+
 #  include "cm_codecvt.hxx"
 #  include "cm_zlib.h"
+
+#  include <atomic>
+#  include <condition_variable>
+#  include <mutex>
+#  include <set>
+#  include <thread>
+
+namespace {
+struct AsyncCommitState
+{
+  AsyncCommitState(unsigned int threadCount)
+    : Owner(std::this_thread::get_id())
+    , Pool(threadCount)
+  {
+  }
+
+  // Wait until no replacement of the file \a name is pending.
+  void Wait(std::string const& name)
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->Committed.wait(
+      lock, [this, &name] { return this->Pending.count(name) == 0; });
+  }
+
+  // Only streams of the thread that opened the scope are committed
+  // asynchronously; worker threads of other pools write synchronously.
+  std::thread::id const Owner;
+  std::mutex Mutex;
+  std::condition_variable Committed;
+  std::set<std::string> Pending;
+  // Declared last so that the threads stop before the state goes away.
+  cmWorkerPool Pool;
+};
+
+// Set only by AsyncCommitScope on the thread that generates files.
+std::atomic<AsyncCommitState*> AsyncCommit(nullptr);
+unsigned int AsyncCommitScopes = 0;
+
+AsyncCommitState* GetAsyncCommit()
+{
+  AsyncCommitState* state = AsyncCommit.load();
+  if (state && state->Owner != std::this_thread::get_id()) {
+    return nullptr;
+  }
+  return state;
+}
+}
 #endif
 
 cmGeneratedFileStream::cmGeneratedFileStream(Encoding encoding)
@@ -127,11 +176,45 @@ cmGeneratedFileStreamBase::cmGeneratedFileStreamBase(std::string const& name)
 
 cmGeneratedFileStreamBase::~cmGeneratedFileStreamBase()
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  AsyncCommitState* state = GetAsyncCommit();
+  if (state && !this->Name.empty()) {
+    std::string const name = this->Name;
+    std::string const tempName = this->TempName;
+    bool const okay = this->Okay;
+    bool const copyIfDifferent = this->CopyIfDifferent;
+    bool const compress = this->Compress;
+    bool const compressExtraExtension = this->CompressExtraExtension;
+    state->Wait(name);
+    {
+      std::lock_guard<std::mutex> lock(state->Mutex);
+      state->Pending.insert(name);
+    }
+    state->Pool.PushJob([=]() {
+      cmGeneratedFileStreamBase::Commit(name, tempName, okay, copyIfDifferent,
+                                        compress, compressExtraExtension);
+      {
+        std::lock_guard<std::mutex> lock(state->Mutex);
+        state->Pending.erase(name);
+      }
+      state->Committed.notify_all();
+    });
+    return;
+  }
+#endif
   this->Close();
 }
 
 void cmGeneratedFileStreamBase::Open(std::string const& name)
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // The temporary file name is fixed, so a pending replacement of the
+  // same destination must finish before the temporary file is reused.
+  if (AsyncCommitState* state = GetAsyncCommit()) {
+    state->Wait(name);
+  }
+#endif
+
   // Save the original name of the file.
   this->Name = name;
 
@@ -151,29 +234,39 @@ void cmGeneratedFileStreamBase::Open(std::string const& name)
 }
 
 bool cmGeneratedFileStreamBase::Close()
+{
+  return cmGeneratedFileStreamBase::Commit(
+    this->Name, this->TempName, this->Okay, this->CopyIfDifferent,
+    this->Compress, this->CompressExtraExtension);
+}
+
+bool cmGeneratedFileStreamBase::Commit(std::string const& name,
+                                       std::string const& tempName,
+                                       bool okay, bool copyIfDifferent,
+                                       bool compress,
+                                       bool compressExtraExtension)
 {
   bool replaced = false;
 
-  std::string resname = this->Name;
-  if (this->Compress && this->CompressExtraExtension) {
+  std::string resname = name;
+  if (compress && compressExtraExtension) {
     resname += ".gz";
   }
 
   // Only consider replacing the destination file if no error
   // occurred.
-  if (!this->Name.empty() && this->Okay &&
-      (!this->CopyIfDifferent ||
-       cmSystemTools::FilesDiffer(this->TempName, resname))) {
+  if (!name.empty() && okay &&
+      (!copyIfDifferent || cmSystemTools::FilesDiffer(tempName, resname))) {
     // The destination is to be replaced.  Rename the temporary to the
     // destination atomically.
-    if (this->Compress) {
-      std::string gzname = this->TempName + ".temp.gz";
-      if (this->CompressFile(this->TempName, gzname)) {
-        this->RenameFile(gzname, resname);
+    if (compress) {
+      std::string gzname = tempName + ".temp.gz";
+      if (cmGeneratedFileStreamBase::CompressFile(tempName, gzname)) {
+        cmGeneratedFileStreamBase::RenameFile(gzname, resname);
       }
       cmSystemTools::RemoveFile(gzname);
     } else {
-      this->RenameFile(this->TempName, resname);
+      cmGeneratedFileStreamBase::RenameFile(tempName, resname);
     }
 
     replaced = true;
@@ -182,7 +275,7 @@ bool cmGeneratedFileStreamBase::Close()
   // Else, the destination was not replaced.
   //
   // Always delete the temporary file. We never want it to stay around.
-  cmSystemTools::RemoveFile(this->TempName);
+  cmSystemTools::RemoveFile(tempName);
 
   return replaced;
 }
@@ -231,3 +324,29 @@ void cmGeneratedFileStream::SetName(const std::string& fname)
 {
   this->Name = fname;
 }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+cmGeneratedFileStream::AsyncCommitScope::AsyncCommitScope(
+  unsigned int threadCount)
+{
+  if (AsyncCommitScopes++ == 0) {
+    AsyncCommit = new AsyncCommitState(threadCount);
+  }
+}
+
+cmGeneratedFileStream::AsyncCommitScope::~AsyncCommitScope()
+{
+  if (--AsyncCommitScopes == 0) {
+    // Destroying the pool waits for all pending replacements.
+    delete AsyncCommit.exchange(nullptr);
+  }
+}
+#else
+cmGeneratedFileStream::AsyncCommitScope::AsyncCommitScope(unsigned int)
+{
+}
+
+cmGeneratedFileStream::AsyncCommitScope::~AsyncCommitScope()
+{
+}
+#endif
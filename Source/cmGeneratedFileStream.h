@@ -32,11 +32,19 @@ protected:
   void Open(std::string const& name);
   bool Close();
 
+  // Replace the destination file with the temporary file and remove
+  // the latter.  Does not use any state so it may run on any thread.
+  static bool Commit(std::string const& name, std::string const& tempName,
+                     bool okay, bool copyIfDifferent, bool compress,
+                     bool compressExtraExtension);
+
   // Internal file replacement implementation.
-  int RenameFile(std::string const& oldname, std::string const& newname);
+  static int RenameFile(std::string const& oldname,
+                        std::string const& newname);
 
   // Internal file compression implementation.
-  int CompressFile(std::string const& oldname, std::string const& newname);
+  static int CompressFile(std::string const& oldname,
+                          std::string const& newname);
 
   // The name of the final destination file for the output.
   std::string Name;
@@ -135,6 +143,27 @@ public:
    */
   void SetName(const std::string& fname);
 
+  /** \class AsyncCommitScope
+   * \brief Replace destination files on worker threads.
+   *
+   * While an instance exists, a stream of the thread that created it
+   * that is destroyed without being closed explicitly hands the
+   * comparison with and replacement of its destination file to one of
+   * \a threadCount worker threads.  Opening a stream for a file
+   * whose replacement is still pending waits for it.  The destructor
+   * waits for all pending replacements, so the content of the files on
+   * disk is the same as without the scope once it ends.  Explicit calls
+   * to Close() are not affected because callers use the result.
+   */
+  class AsyncCommitScope
+  {
+  public:
+    AsyncCommitScope(unsigned int threadCount = 0);
+    ~AsyncCommitScope();
+
+    CM_DISABLE_COPY(AsyncCommitScope)
+  };
+
 private:
   cmGeneratedFileStream(cmGeneratedFileStream const&); // not implemented
 };
@@ -20,6 +20,7 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
   : Parent(parent)
   , Target(target)
   , Property(property)
+  , ChecksCount(0)
   , Content(content)
   , Backtrace(backtrace)
   , TransitivePropertiesOnly(false)
@@ -34,6 +35,7 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
   : Parent(parent)
   , Target(target)
   , Property(property)
+  , ChecksCount(0)
   , Content(content)
   , Backtrace()
   , TransitivePropertiesOnly(false)
@@ -42,6 +44,21 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
 }
 
 void cmGeneratorExpressionDAGChecker::Initialize()
+{
+  cmGeneratorExpressionDAGChecker* top = this->Top();
+  ++top->ChecksCount;
+  this->CheckResult = this->CheckGraph();
+
+  if (CheckResult == DAG && top->TracksSeen()) {
+    if (top->IsSeen(this->Target, this->Property)) {
+      this->CheckResult = ALREADY_SEEN;
+      return;
+    }
+    top->Seen[this->Target].insert(this->Property);
+  }
+}
+
+cmGeneratorExpressionDAGChecker* cmGeneratorExpressionDAGChecker::Top() const
 {
   const cmGeneratorExpressionDAGChecker* top = this;
   const cmGeneratorExpressionDAGChecker* p = this->Parent;
@@ -49,28 +66,39 @@ void cmGeneratorExpressionDAGChecker::Initialize()
     top = p;
     p = p->Parent;
   }
-  this->CheckResult = this->CheckGraph();
+  return const_cast<cmGeneratorExpressionDAGChecker*>(top);
+}
+
+bool cmGeneratorExpressionDAGChecker::TracksSeen() const
+{
+  const cmGeneratorExpressionDAGChecker* top = this->Top();
 
 #define TEST_TRANSITIVE_PROPERTY_METHOD(METHOD) top->METHOD() ||
 
-  if (CheckResult == DAG &&
-      (CM_FOR_EACH_TRANSITIVE_PROPERTY_METHOD(
-        TEST_TRANSITIVE_PROPERTY_METHOD) false)) // NOLINT(clang-tidy)
+  return CM_FOR_EACH_TRANSITIVE_PROPERTY_METHOD(
+    TEST_TRANSITIVE_PROPERTY_METHOD) false; // NOLINT(clang-tidy)
 #undef TEST_TRANSITIVE_PROPERTY_METHOD
-  {
-    std::map<cmGeneratorTarget const*, std::set<std::string>>::const_iterator
-      it = top->Seen.find(this->Target);
-    if (it != top->Seen.end()) {
-      const std::set<std::string>& propSet = it->second;
-      if (propSet.find(this->Property) != propSet.end()) {
-        this->CheckResult = ALREADY_SEEN;
-        return;
-      }
-    }
-    const_cast<cmGeneratorExpressionDAGChecker*>(top)
-      ->Seen[this->Target]
-      .insert(this->Property);
-  }
+}
+
+bool cmGeneratorExpressionDAGChecker::IsSeen(
+  cmGeneratorTarget const* target, std::string const& property) const
+{
+  const cmGeneratorExpressionDAGChecker* top = this->Top();
+  std::map<cmGeneratorTarget const*, std::set<std::string>>::const_iterator
+    it = top->Seen.find(target);
+  return it != top->Seen.end() &&
+    it->second.find(property) != it->second.end();
+}
+
+void cmGeneratorExpressionDAGChecker::MarkSeen(cmGeneratorTarget const* target,
+                                               std::string const& property)
+{
+  this->Top()->Seen[target].insert(property);
+}
+
+unsigned long cmGeneratorExpressionDAGChecker::GetChecksCount() const
+{
+  return this->Top()->ChecksCount;
 }
 
 cmGeneratorExpressionDAGChecker::Result
@@ -201,6 +229,11 @@ cmGeneratorTarget const* cmGeneratorExpressionDAGChecker::TopTarget() const
   return top->Target;
 }
 
+std::string const& cmGeneratorExpressionDAGChecker::TopProperty() const
+{
+  return this->Top()->Property;
+}
+
 enum TransitiveProperty
 {
 #define DEFINE_ENUM_ENTRY(NAME) NAME,
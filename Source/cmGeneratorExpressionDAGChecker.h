@@ -78,8 +78,25 @@ struct cmGeneratorExpressionDAGChecker
   void SetTransitivePropertiesOnly() { this->TransitivePropertiesOnly = true; }
 
   cmGeneratorTarget const* TopTarget() const;
+  std::string const& TopProperty() const;
+
+  /** Whether the top-level checker tracks the target properties already
+      seen, which it does while evaluating a transitive property.  */
+  bool TracksSeen() const;
+
+  bool IsSeen(cmGeneratorTarget const* target,
+              std::string const& property) const;
+
+  /** Mark a target property as seen as if a checker for it were created
+      below this one.  */
+  void MarkSeen(cmGeneratorTarget const* target, std::string const& property);
+
+  /** Get the number of checkers created for the evaluation so far.  */
+  unsigned long GetChecksCount() const;
 
 private:
+  cmGeneratorExpressionDAGChecker* Top() const;
+
   Result CheckGraph() const;
   void Initialize();
 
@@ -88,6 +105,7 @@ private:
   cmGeneratorTarget const* Target;
   const std::string Property;
   std::map<cmGeneratorTarget const*, std::set<std::string>> Seen;
+  unsigned long ChecksCount;
   const GeneratorExpressionContent* const Content;
   const cmListFileBacktrace Backtrace;
   Result CheckResult;
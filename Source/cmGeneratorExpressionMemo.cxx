@@ -0,0 +1,57 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmGeneratorExpressionMemo.h"
+
+#include <utility>
+
+cmGeneratorExpressionMemoEntry::cmGeneratorExpressionMemoEntry()
+  : LinkedDependOnConfig(false)
+  , ValueKnown(false)
+  , HadContextSensitiveCondition(false)
+  , HadHeadSensitiveCondition(false)
+  , ForHeadTarget(false)
+{
+}
+
+cmGeneratorExpressionMemo::cmGeneratorExpressionMemo()
+  : Enabled(false)
+{
+}
+
+cmGeneratorExpressionMemo::Entry const* cmGeneratorExpressionMemo::Find(
+  cmGeneratorTarget const* target, cmLocalGenerator const* lg,
+  std::string const& key, cmGeneratorTarget const* head) const
+{
+  auto i = this->Entries.find(std::make_tuple(target, lg, key));
+  if (i == this->Entries.end()) {
+    return nullptr;
+  }
+
+  // Entries that do not depend on the head target are stored without one.
+  HeadToEntryMap const& hm = i->second;
+  auto h = hm.find(nullptr);
+  if (h == hm.end()) {
+    h = hm.find(head);
+  }
+  return h != hm.end() ? h->second.get() : nullptr;
+}
+
+void cmGeneratorExpressionMemo::Store(cmGeneratorTarget const* target,
+                                      cmLocalGenerator const* lg,
+                                      std::string const& key,
+                                      cmGeneratorTarget const* head,
+                                      std::unique_ptr<Entry> entry)
+{
+  // Keep an entry stored before, an evaluation may still refer to it.
+  std::unique_ptr<Entry>& slot =
+    this->Entries[std::make_tuple(target, lg, key)][head];
+  if (!slot) {
+    entry->ForHeadTarget = head != nullptr;
+    slot = std::move(entry);
+  }
+}
+
+void cmGeneratorExpressionMemo::Clear()
+{
+  this->Entries.clear();
+}
@@ -0,0 +1,92 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmGeneratorExpressionMemo_h
+#define cmGeneratorExpressionMemo_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <map>
+#include <memory> // IWYU pragma: keep
+#include <string>
+#include <tuple>
+#include <vector>
+
+class cmGeneratorTarget;
+class cmLocalGenerator;
+
+/** What the evaluation of a transitive interface property of a target
+    needs besides the properties of the targets it links to.  */
+struct cmGeneratorExpressionMemoEntry
+{
+  cmGeneratorExpressionMemoEntry();
+
+  /** Targets in the link interface, in order.  */
+  std::vector<cmGeneratorTarget const*> Linked;
+  /** Whether the link interface depends on the configuration.  */
+  bool LinkedDependOnConfig;
+
+  /** Whether the value of the property on the target itself is known.
+      It is not if its evaluation reads other target properties, which
+      depends on what the evaluation saw before.  */
+  bool ValueKnown;
+  std::string Value;
+  /** The non-empty elements of the value.  */
+  std::string ValueElements;
+  bool HadContextSensitiveCondition;
+  bool HadHeadSensitiveCondition;
+
+  /** Whether the entry is stored for one head target only.  */
+  bool ForHeadTarget;
+  /** The entries of the targets in the link interface with a known
+      value, once found, so that every evaluation passing through this
+      entry shares them instead of looking them up again.  */
+  mutable std::vector<cmGeneratorExpressionMemoEntry const*> LinkedEntries;
+};
+
+/** \class cmGeneratorExpressionMemo
+ * \brief Remember evaluations of transitive interface properties.
+ *
+ * Evaluating $<TARGET_PROPERTY:tgt,INTERFACE_...> for a usage
+ * requirement follows the whole link interface closure of the target,
+ * and the generators do so for every target that links to it.  The
+ * link interface followed and the value of the property on each target
+ * are kept here, keyed by the target, the local generator evaluating
+ * it, the property and the rest of the evaluation context, and by the
+ * head target only if they depend on it.  The global generator enables
+ * the memo once the targets do not change any more.
+ */
+class cmGeneratorExpressionMemo
+{
+public:
+  typedef cmGeneratorExpressionMemoEntry Entry;
+
+  cmGeneratorExpressionMemo();
+
+  CM_DISABLE_COPY(cmGeneratorExpressionMemo)
+
+  bool IsEnabled() const { return this->Enabled; }
+  void SetEnabled(bool enabled) { this->Enabled = enabled; }
+
+  Entry const* Find(cmGeneratorTarget const* target,
+                    cmLocalGenerator const* lg, std::string const& key,
+                    cmGeneratorTarget const* head) const;
+
+  /** Take an entry computed for the given head target.  Pass a null head
+      target if the entry does not depend on it.  */
+  void Store(cmGeneratorTarget const* target, cmLocalGenerator const* lg,
+             std::string const& key, cmGeneratorTarget const* head,
+             std::unique_ptr<Entry> entry);
+
+  void Clear();
+
+private:
+  typedef std::map<cmGeneratorTarget const*, std::unique_ptr<Entry>>
+    HeadToEntryMap;
+  std::map<std::tuple<cmGeneratorTarget const*, cmLocalGenerator const*,
+                      std::string>,
+           HeadToEntryMap>
+    Entries;
+  bool Enabled;
+};
+
+#endif
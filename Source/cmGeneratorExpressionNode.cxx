@@ -7,11 +7,13 @@
 #include "cmGeneratorExpressionContext.h"
 #include "cmGeneratorExpressionDAGChecker.h"
 #include "cmGeneratorExpressionEvaluator.h"
+#include "cmGeneratorExpressionMemo.h"
 #include "cmGeneratorTarget.h"
 #include "cmGlobalGenerator.h"
 #include "cmLinkItem.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
+#include "cmMessenger.h"
 #include "cmOutputConverter.h"
 #include "cmPolicies.h"
 #include "cmStateTypes.h"
@@ -1074,6 +1076,217 @@ std::string getLinkedTargetsContent(
   return linkedTargetsContent;
 }
 
+// Whether a transitive property of a target is also a compatible
+// interface property, which TargetPropertyNode evaluates differently.
+static bool isCompatibleInterfaceProperty(cmGeneratorTarget const* target,
+                                          std::string const& propertyName,
+                                          const char* prop,
+                                          std::string const& config)
+{
+  if (target->IsImported()) {
+    return false;
+  }
+  if (!prop) {
+    if (target->GetType() == cmStateEnums::INTERFACE_LIBRARY) {
+      return false;
+    }
+    if (target->IsLinkInterfaceDependentBoolProperty(propertyName, config) ||
+        target->IsLinkInterfaceDependentStringProperty(propertyName,
+                                                       config)) {
+      return true;
+    }
+  }
+  return target->IsLinkInterfaceDependentNumberMinProperty(propertyName,
+                                                           config) ||
+    target->IsLinkInterfaceDependentNumberMaxProperty(propertyName, config);
+}
+
+static void appendListElements(std::string& list, std::string const& elements)
+{
+  if (!elements.empty()) {
+    if (!list.empty()) {
+      list += ';';
+    }
+    list += elements;
+  }
+}
+
+// The evaluation of a transitive interface property of a target, which
+// follows the link interfaces remembered in the memo.
+struct RememberedEvaluation
+{
+  cmGeneratorExpressionMemo& Memo;
+  std::string const& Key;
+  std::string const& Property;
+  cmGeneratorTarget const* HeadTarget;
+  cmGeneratorExpressionContext* Context;
+};
+
+static std::string evaluateRemembered(
+  RememberedEvaluation& re, cmLocalGenerator* lg,
+  cmGeneratorTarget const* target, cmGeneratorExpressionDAGChecker* dagChecker,
+  std::string& linked);
+
+// Append the non-empty elements of the property of the targets linked by
+// the entry of a target as getLinkedTargetsContent would.  A target whose
+// value is remembered is only marked as seen, without a DAG checker or an
+// expression of its own.
+static void evaluateRememberedLinked(
+  RememberedEvaluation& re, cmGeneratorTarget const* target,
+  cmGeneratorExpressionMemoEntry const& owner,
+  cmGeneratorExpressionDAGChecker* dagChecker, std::string& linked)
+{
+  cmGeneratorExpressionContext* context = re.Context;
+  cmLocalGenerator* lg = target->GetLocalGenerator();
+  std::vector<cmGeneratorTarget const*> const& linkedTargets = owner.Linked;
+  if (owner.LinkedEntries.size() != linkedTargets.size()) {
+    owner.LinkedEntries.assign(linkedTargets.size(), nullptr);
+  }
+  for (size_t i = 0; i < linkedTargets.size(); ++i) {
+    cmGeneratorTarget const* dep = linkedTargets[i];
+    // No content from a property seen before or on a cycle.
+    if (dagChecker->IsSeen(dep, re.Property)) {
+      continue;
+    }
+
+    cmGeneratorExpressionMemoEntry const* entry = owner.LinkedEntries[i];
+    if (!entry) {
+      entry = re.Memo.Find(dep, lg, re.Key, re.HeadTarget);
+      // An entry for one head target may be shared only by an owner
+      // that is used for that head target only.
+      if (entry && entry->ValueKnown &&
+          (!entry->ForHeadTarget || owner.ForHeadTarget)) {
+        owner.LinkedEntries[i] = entry;
+      }
+    }
+    if (entry && entry->ValueKnown) {
+      dagChecker->MarkSeen(dep, re.Property);
+      if (entry->LinkedDependOnConfig ||
+          entry->HadContextSensitiveCondition) {
+        context->HadContextSensitiveCondition = true;
+      }
+      if (entry->HadHeadSensitiveCondition) {
+        context->HadHeadSensitiveCondition = true;
+      }
+      appendListElements(linked, entry->ValueElements);
+      evaluateRememberedLinked(re, dep, *entry, dagChecker, linked);
+      continue;
+    }
+
+    if (isCompatibleInterfaceProperty(dep, re.Property,
+                                      dep->GetProperty(re.Property),
+                                      context->Config)) {
+      std::string uniqueName =
+        target->GetGlobalGenerator()->IndexGeneratorTargetUniquely(dep);
+      std::string const value =
+        cmGeneratorExpressionNode::EvaluateDependentExpression(
+          "$<TARGET_PROPERTY:" + uniqueName + "," + re.Property + ">", lg,
+          context, re.HeadTarget, target, dagChecker);
+      appendListElements(linked,
+                         cmGeneratorExpression::StripEmptyListElements(value));
+      continue;
+    }
+
+    cmGeneratorExpressionDAGChecker depChecker(context->Backtrace, dep,
+                                               re.Property, nullptr,
+                                               dagChecker);
+    std::string depLinked;
+    std::string const value =
+      evaluateRemembered(re, lg, dep, &depChecker, depLinked);
+    appendListElements(linked,
+                       cmGeneratorExpression::StripEmptyListElements(value));
+    appendListElements(linked, depLinked);
+  }
+}
+
+// Evaluate the property of a target like TargetPropertyNode, remembering
+// its link interface and its value if the latter does not read other
+// target properties.  Returns the value and appends the non-empty
+// elements of the content of the linked targets to 'linked'.
+static std::string evaluateRemembered(
+  RememberedEvaluation& re, cmLocalGenerator* lg,
+  cmGeneratorTarget const* target, cmGeneratorExpressionDAGChecker* dagChecker,
+  std::string& linked)
+{
+  cmGeneratorExpressionContext* context = re.Context;
+  cmGeneratorExpressionMemoEntry const* entry =
+    re.Memo.Find(target, lg, re.Key, re.HeadTarget);
+  std::unique_ptr<cmGeneratorExpressionMemoEntry> newEntry;
+  bool linkedDependOnHead = false;
+  if (!entry) {
+    newEntry = cm::make_unique<cmGeneratorExpressionMemoEntry>();
+    if (cmLinkInterfaceLibraries const* iface =
+          target->GetLinkInterfaceLibraries(context->Config, re.HeadTarget,
+                                            true)) {
+      newEntry->LinkedDependOnConfig = iface->HadContextSensitiveCondition;
+      linkedDependOnHead = iface->HadHeadSensitiveCondition;
+      for (cmLinkItem const& l : iface->Libraries) {
+        if (l.Target && l.Target != target) {
+          newEntry->Linked.push_back(l.Target);
+        }
+      }
+    }
+    entry = newEntry.get();
+  }
+  if (entry->LinkedDependOnConfig) {
+    context->HadContextSensitiveCondition = true;
+  }
+
+  evaluateRememberedLinked(re, target, *entry, dagChecker, linked);
+
+  if (entry->ValueKnown) {
+    if (entry->HadContextSensitiveCondition) {
+      context->HadContextSensitiveCondition = true;
+    }
+    if (entry->HadHeadSensitiveCondition) {
+      context->HadHeadSensitiveCondition = true;
+    }
+    return entry->Value;
+  }
+
+  std::string value;
+  bool valueKnown = true;
+  bool hadContextSensitiveCondition = false;
+  bool hadHeadSensitiveCondition = false;
+  if (const char* prop = target->GetProperty(re.Property)) {
+    // A value whose evaluation issued a message is evaluated again next
+    // time, so that every use of it issues the message as before.
+    cmMessenger const* messenger = lg->GetCMakeInstance()->GetMessenger();
+    unsigned long const messages = messenger->GetIssuedMessageCount();
+    unsigned long const checks = dagChecker->GetChecksCount();
+    bool const contextSensitive = context->HadContextSensitiveCondition;
+    bool const headSensitive = context->HadHeadSensitiveCondition;
+    context->HadContextSensitiveCondition = false;
+    context->HadHeadSensitiveCondition = false;
+    value = cmGeneratorExpressionNode::EvaluateDependentExpression(
+      prop, lg, context, re.HeadTarget, target, dagChecker);
+    valueKnown = dagChecker->GetChecksCount() == checks &&
+      messenger->GetIssuedMessageCount() == messages;
+    hadContextSensitiveCondition = context->HadContextSensitiveCondition;
+    hadHeadSensitiveCondition = context->HadHeadSensitiveCondition;
+    context->HadContextSensitiveCondition =
+      contextSensitive || hadContextSensitiveCondition;
+    context->HadHeadSensitiveCondition =
+      headSensitive || hadHeadSensitiveCondition;
+  }
+
+  if (newEntry && !cmSystemTools::GetErrorOccuredFlag()) {
+    bool dependsOnHead = linkedDependOnHead;
+    if (valueKnown) {
+      newEntry->ValueKnown = true;
+      newEntry->Value = value;
+      newEntry->ValueElements =
+        cmGeneratorExpression::StripEmptyListElements(value);
+      newEntry->HadContextSensitiveCondition = hadContextSensitiveCondition;
+      newEntry->HadHeadSensitiveCondition = hadHeadSensitiveCondition;
+      dependsOnHead = dependsOnHead || hadHeadSensitiveCondition;
+    }
+    re.Memo.Store(target, lg, re.Key, dependsOnHead ? re.HeadTarget : nullptr,
+                  std::move(newEntry));
+  }
+  return value;
+}
+
 static const struct TargetPropertyNode : public cmGeneratorExpressionNode
 {
   TargetPropertyNode() {}
@@ -1253,8 +1466,6 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
       }
     }
 
-    std::string linkedTargetsContent;
-
     std::string interfacePropertyName;
     bool isInterfaceProperty = false;
 
@@ -1280,20 +1491,71 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
       context->HeadTarget && isInterfaceProperty ? context->HeadTarget
                                                  : target;
 
+    // The usage requirements of a target are evaluated for every target
+    // linking to it, so remember what they need.  Their evaluation for
+    // sources may depend on the top-level target.
+    cmGeneratorExpressionMemo& memo =
+      context->LG->GetGlobalGenerator()->GetGeneratorExpressionMemo();
+    if (isInterfaceProperty && memo.IsEnabled() && dagChecker.TracksSeen() &&
+        interfacePropertyName != "INTERFACE_SOURCES" &&
+        !isCompatibleInterfaceProperty(target, propertyName, prop,
+                                       context->Config)) {
+      std::string key = interfacePropertyName;
+      key += ';';
+      key += context->Config;
+      key += ';';
+      key += context->Language;
+      key += ';';
+      key += dagChecker.TopProperty();
+      key += ';';
+      key += context->EvaluateForBuildsystem ? '1' : '0';
+      key += context->Quiet ? '1' : '0';
+
+      RememberedEvaluation re = { memo, key, interfacePropertyName,
+                                  headTarget, context };
+      std::string linkedTargetsContent;
+      std::string result = evaluateRemembered(re, context->LG, target,
+                                              &dagChecker, linkedTargetsContent);
+      if (!linkedTargetsContent.empty()) {
+        result += (result.empty() ? "" : ";") + linkedTargetsContent;
+      }
+      return result;
+    }
+
+    return this->EvaluateProperty(context, dagCheckerParent, &dagChecker,
+                                  target, headTarget, propertyName, prop,
+                                  interfacePropertyName, isInterfaceProperty);
+  }
+
+  std::string EvaluateProperty(
+    cmGeneratorExpressionContext* context,
+    cmGeneratorExpressionDAGChecker* dagCheckerParent,
+    cmGeneratorExpressionDAGChecker* dagChecker,
+    cmGeneratorTarget const* target, cmGeneratorTarget const* headTarget,
+    std::string const& propertyName, const char* prop,
+    std::string const& interfacePropertyName, bool isInterfaceProperty) const
+  {
+    std::string linkedTargetsContent;
     if (isInterfaceProperty) {
       if (cmLinkInterfaceLibraries const* iface =
             target->GetLinkInterfaceLibraries(context->Config, headTarget,
                                               true)) {
+        if (iface->HadContextSensitiveCondition) {
+          context->HadContextSensitiveCondition = true;
+        }
         linkedTargetsContent =
           getLinkedTargetsContent(iface->Libraries, target, headTarget,
-                                  context, &dagChecker, interfacePropertyName);
+                                  context, dagChecker, interfacePropertyName);
       }
     } else if (!interfacePropertyName.empty()) {
       if (cmLinkImplementationLibraries const* impl =
             target->GetLinkImplementationLibraries(context->Config)) {
+        if (impl->HadContextSensitiveCondition) {
+          context->HadContextSensitiveCondition = true;
+        }
         linkedTargetsContent =
           getLinkedTargetsContent(impl->Libraries, target, target, context,
-                                  &dagChecker, interfacePropertyName);
+                                  dagChecker, interfacePropertyName);
       }
     }
 
@@ -1359,7 +1621,7 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
     }
     if (!interfacePropertyName.empty()) {
       std::string result = this->EvaluateDependentExpression(
-        prop, context->LG, context, headTarget, target, &dagChecker);
+        prop, context->LG, context, headTarget, target, dagChecker);
       if (!linkedTargetsContent.empty()) {
         result += (result.empty() ? "" : ";") + linkedTargetsContent;
       }
@@ -1924,6 +2186,8 @@ struct TargetFilesystemArtifact : public cmGeneratorExpressionNode
     }
     context->DependTargets.insert(target);
     context->AllTargets.insert(target);
+    // The artifacts are named and placed per configuration.
+    context->HadContextSensitiveCondition = true;
 
     std::string result =
       TargetFilesystemArtifactResultCreator<ArtifactT>::Create(target, context,
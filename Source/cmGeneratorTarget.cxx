@@ -25,6 +25,7 @@
 #include "cmGlobalGenerator.h"
 #include "cmLocalGenerator.h"
 #include "cmMakefile.h"
+#include "cmMessenger.h"
 #include "cmPropertyMap.h"
 #include "cmSourceFile.h"
 #include "cmSourceFileLocation.h"
@@ -106,6 +107,7 @@ cmGeneratorTarget::cmGeneratorTarget(cmTarget* t, cmLocalGenerator* lg)
   , DebugLinkDirectoriesDone(false)
   , DebugSourcesDone(false)
   , LinkImplementationLanguageIsContextDependent(true)
+  , CompileFeaturesAreContextDependent(true)
   , UtilityItemsDone(false)
 {
   this->Makefile = this->Target->GetMakefile();
@@ -392,6 +394,8 @@ void cmGeneratorTarget::AddIncludeDirectory(const std::string& src,
     : this->IncludeDirectoriesEntries.end();
   this->IncludeDirectoriesEntries.insert(
     pos, new TargetPropertyEntry(std::move(cge)));
+  this->IncludeDirectoriesCache.ByConfig.clear();
+  this->IncludeDirectoriesCache.AnyConfig.clear();
 }
 
 std::vector<cmSourceFile*> const* cmGeneratorTarget::GetSourceDepends(
@@ -839,6 +843,33 @@ static void AddInterfaceEntries(
   }
 }
 
+// Whether the entries evaluated for a configuration, and the link
+// implementation that gave the interface entries, may differ in other
+// configurations.
+static bool dependOnConfig(
+  cmGeneratorTarget const* thisTarget, std::string const& config,
+  std::vector<cmGeneratorTarget::TargetPropertyEntry*> const& entries,
+  std::vector<cmGeneratorTarget::TargetPropertyEntry*> const& ifaceEntries)
+{
+  if (cmLinkImplementationLibraries const* impl =
+        thisTarget->GetLinkImplementationLibraries(config)) {
+    if (impl->HadContextSensitiveCondition) {
+      return true;
+    }
+  }
+  for (cmGeneratorTarget::TargetPropertyEntry const* entry : entries) {
+    if (entry->ge->GetHadContextSensitiveCondition()) {
+      return true;
+    }
+  }
+  for (cmGeneratorTarget::TargetPropertyEntry const* entry : ifaceEntries) {
+    if (entry->ge->GetHadContextSensitiveCondition()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 static void AddObjectEntries(
   cmGeneratorTarget const* thisTarget, std::string const& config,
   std::vector<cmGeneratorTarget::TargetPropertyEntry*>& entries)
@@ -2609,9 +2640,30 @@ static void processIncludeDirectories(
   }
 }
 
+static unsigned long issuedMessageCount(cmGeneratorTarget const* tgt)
+{
+  return tgt->GetLocalGenerator()
+    ->GetCMakeInstance()
+    ->GetMessenger()
+    ->GetIssuedMessageCount();
+}
+
 std::vector<BT<std::string>> cmGeneratorTarget::GetIncludeDirectories(
   const std::string& config, const std::string& lang) const
 {
+  bool const remember = this->PropertiesAreFinal();
+  if (remember) {
+    if (std::vector<BT<std::string>> const* cached =
+          this->FindUsageRequirements(this->IncludeDirectoriesCache, config,
+                                      lang)) {
+      return *cached;
+    }
+  }
+
+  // Results whose evaluation issued a message are computed again, so
+  // that the message is issued for every use.
+  unsigned long const messages = issuedMessageCount(this);
+
   std::vector<BT<std::string>> includes;
   std::unordered_set<std::string> uniqueIncludes;
 
@@ -2668,11 +2720,58 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetIncludeDirectories(
                             includes, uniqueIncludes, &dagChecker, config,
                             debugIncludes, lang);
 
-  cmDeleteAll(linkInterfaceIncludeDirectoriesEntries);
+  if (remember && !cmSystemTools::GetErrorOccuredFlag() &&
+      issuedMessageCount(this) == messages) {
+    this->StoreUsageRequirements(
+      this->IncludeDirectoriesCache, config, lang,
+      dependOnConfig(this, config, this->IncludeDirectoriesEntries,
+                     linkInterfaceIncludeDirectoriesEntries),
+      includes);
+  }
 
+  cmDeleteAll(linkInterfaceIncludeDirectoriesEntries);
   return includes;
 }
 
+bool cmGeneratorTarget::PropertiesAreFinal() const
+{
+  // The usage requirements and the paths of the targets are computed by
+  // several parts of the generators.  The targets and their properties
+  // do not change any more once the generator expression memo is
+  // enabled, so results computed from them may be kept.
+  return this->GlobalGenerator->GetGeneratorExpressionMemo().IsEnabled();
+}
+
+std::vector<BT<std::string>> const* cmGeneratorTarget::FindUsageRequirements(
+  UsageRequirementsCache const& cache, std::string const& config,
+  std::string const& lang) const
+{
+  std::map<std::string, std::vector<BT<std::string>>>::const_iterator it =
+    cache.AnyConfig.find(lang);
+  if (it != cache.AnyConfig.end()) {
+    return &it->second;
+  }
+  it = cache.ByConfig.find(config + ";" + lang);
+  if (it != cache.ByConfig.end()) {
+    return &it->second;
+  }
+  return nullptr;
+}
+
+void cmGeneratorTarget::StoreUsageRequirements(
+  UsageRequirementsCache& cache, std::string const& config,
+  std::string const& lang, bool configDependent,
+  std::vector<BT<std::string>> const& result) const
+{
+  // Multi-configuration generators evaluate the usage requirements for
+  // each configuration, and most of them are the same in all of them.
+  if (configDependent) {
+    cache.ByConfig[config + ";" + lang] = result;
+  } else {
+    cache.AnyConfig[lang] = result;
+  }
+}
+
 enum class OptionsParse
 {
   None,
@@ -2749,6 +2848,16 @@ void cmGeneratorTarget::GetCompileOptions(std::vector<std::string>& result,
 std::vector<BT<std::string>> cmGeneratorTarget::GetCompileOptions(
   std::string const& config, std::string const& language) const
 {
+  bool const remember = this->PropertiesAreFinal();
+  if (remember) {
+    if (std::vector<BT<std::string>> const* cached =
+          this->FindUsageRequirements(this->CompileOptionsCache, config,
+                                      language)) {
+      return *cached;
+    }
+  }
+  unsigned long const messages = issuedMessageCount(this);
+
   std::vector<BT<std::string>> result;
   std::unordered_set<std::string> uniqueOptions;
 
@@ -2784,6 +2893,15 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileOptions(
                         uniqueOptions, &dagChecker, config, debugOptions,
                         language);
 
+  if (remember && !cmSystemTools::GetErrorOccuredFlag() &&
+      issuedMessageCount(this) == messages) {
+    this->StoreUsageRequirements(
+      this->CompileOptionsCache, config, language,
+      dependOnConfig(this, config, this->CompileOptionsEntries,
+                     linkInterfaceCompileOptionsEntries),
+      result);
+  }
+
   cmDeleteAll(linkInterfaceCompileOptionsEntries);
   return result;
 }
@@ -2813,6 +2931,13 @@ void cmGeneratorTarget::GetCompileFeatures(std::vector<std::string>& result,
 
 std::vector<BT<std::string>> cmGeneratorTarget::GetCompileFeatures(
   std::string const& config) const
+{
+  bool configDependent = false;
+  return this->GetCompileFeatures(config, configDependent);
+}
+
+std::vector<BT<std::string>> cmGeneratorTarget::GetCompileFeatures(
+  std::string const& config, bool& configDependent) const
 {
   std::vector<BT<std::string>> result;
   std::unordered_set<std::string> uniqueFeatures;
@@ -2846,6 +2971,9 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileFeatures(
   processCompileFeatures(this, linkInterfaceCompileFeaturesEntries, result,
                          uniqueFeatures, &dagChecker, config, debugFeatures);
 
+  configDependent =
+    dependOnConfig(this, config, this->CompileFeaturesEntries,
+                   linkInterfaceCompileFeaturesEntries);
   cmDeleteAll(linkInterfaceCompileFeaturesEntries);
   return result;
 }
@@ -2878,6 +3006,16 @@ void cmGeneratorTarget::GetCompileDefinitions(
 std::vector<BT<std::string>> cmGeneratorTarget::GetCompileDefinitions(
   std::string const& config, std::string const& language) const
 {
+  bool const remember = this->PropertiesAreFinal();
+  if (remember) {
+    if (std::vector<BT<std::string>> const* cached =
+          this->FindUsageRequirements(this->CompileDefinitionsCache, config,
+                                      language)) {
+      return *cached;
+    }
+  }
+  unsigned long const messages = issuedMessageCount(this);
+
   std::vector<BT<std::string>> list;
   std::unordered_set<std::string> uniqueOptions;
 
@@ -2938,6 +3076,28 @@ std::vector<BT<std::string>> cmGeneratorTarget::GetCompileDefinitions(
                             uniqueOptions, &dagChecker, config, debugDefines,
                             language);
 
+  if (remember && !cmSystemTools::GetErrorOccuredFlag() &&
+      issuedMessageCount(this) == messages) {
+    bool configDependent =
+      dependOnConfig(this, config, this->CompileDefinitionsEntries,
+                     linkInterfaceCompileDefinitionsEntries);
+    // Other configurations may have definitions of their own.
+    cmPolicies::PolicyStatus polSt =
+      this->Makefile->GetPolicyStatus(cmPolicies::CMP0043);
+    if (polSt == cmPolicies::WARN || polSt == cmPolicies::OLD) {
+      std::vector<std::string> configs;
+      this->Makefile->GetConfigurations(configs);
+      for (std::string const& c : configs) {
+        if (this->GetProperty("COMPILE_DEFINITIONS_" +
+                              cmSystemTools::UpperCase(c))) {
+          configDependent = true;
+        }
+      }
+    }
+    this->StoreUsageRequirements(this->CompileDefinitionsCache, config,
+                                 language, configDependent, list);
+  }
+
   cmDeleteAll(linkInterfaceCompileDefinitionsEntries);
   return list;
 }
@@ -3415,7 +3575,17 @@ void cmGeneratorTarget::ComputeTargetManifest(const std::string& config) const
 
 bool cmGeneratorTarget::ComputeCompileFeatures(std::string const& config) const
 {
-  std::vector<BT<std::string>> features = this->GetCompileFeatures(config);
+  // Features that do not depend on the configuration were required for
+  // all configurations by the first one.
+  if (!this->CompileFeaturesAreContextDependent) {
+    return true;
+  }
+  bool configDependent = false;
+  std::vector<BT<std::string>> features =
+    this->GetCompileFeatures(config, configDependent);
+  if (!configDependent) {
+    this->CompileFeaturesAreContextDependent = false;
+  }
   for (BT<std::string> const& f : features) {
     if (!this->Makefile->AddRequiredTargetFeature(this->Target, f.Value)) {
       return false;
@@ -3441,6 +3611,19 @@ std::string cmGeneratorTarget::GetFullPath(const std::string& config,
   if (this->IsImported()) {
     return this->Target->ImportedGetFullPath(config, artifact);
   }
+
+  // Every target linking to this one asks for its path.
+  if (this->PropertiesAreFinal()) {
+    FullPathKey key(OutputNameKey(config, artifact), realname);
+    FullPathMapType::const_iterator i = this->FullPathMap.find(key);
+    if (i == this->FullPathMap.end()) {
+      i = this->FullPathMap
+            .insert(FullPathMapType::value_type(
+              key, this->NormalGetFullPath(config, artifact, realname)))
+            .first;
+    }
+    return i->second;
+  }
   return this->NormalGetFullPath(config, artifact, realname);
 }
 
@@ -4754,7 +4937,8 @@ void cmGeneratorTarget::LookupLinkItems(std::vector<std::string> const& names,
 void cmGeneratorTarget::ExpandLinkItems(
   std::string const& prop, std::string const& value, std::string const& config,
   cmGeneratorTarget const* headTarget, bool usage_requirements_only,
-  std::vector<cmLinkItem>& items, bool& hadHeadSensitiveCondition) const
+  std::vector<cmLinkItem>& items, bool& hadHeadSensitiveCondition,
+  bool& hadContextSensitiveCondition) const
 {
   cmGeneratorExpression ge;
   cmGeneratorExpressionDAGChecker dagChecker(this, prop, nullptr, nullptr);
@@ -4771,6 +4955,7 @@ void cmGeneratorTarget::ExpandLinkItems(
                                     libs);
   this->LookupLinkItems(libs, cge->GetBacktrace(), items);
   hadHeadSensitiveCondition = cge->GetHadHeadSensitiveCondition();
+  hadContextSensitiveCondition = cge->GetHadContextSensitiveCondition();
 }
 
 cmLinkInterface const* cmGeneratorTarget::GetLinkInterface(
@@ -5234,7 +5419,12 @@ void cmGeneratorTarget::ComputeLinkInterfaceLibraries(
     // The interface libraries have been explicitly set.
     this->ExpandLinkItems(linkIfaceProp, explicitLibraries, config, headTarget,
                           usage_requirements_only, iface.Libraries,
-                          iface.HadHeadSensitiveCondition);
+                          iface.HadHeadSensitiveCondition,
+                          iface.HadContextSensitiveCondition);
+    // The old properties may be set for each configuration.
+    if (linkIfaceProp != "INTERFACE_LINK_LIBRARIES") {
+      iface.HadContextSensitiveCondition = true;
+    }
   } else if (this->GetPolicyStatusCMP0022() == cmPolicies::WARN ||
              this->GetPolicyStatusCMP0022() == cmPolicies::OLD)
   // If CMP0022 is NEW then the plain tll signature sets the
@@ -5247,6 +5437,7 @@ void cmGeneratorTarget::ComputeLinkInterfaceLibraries(
       this->GetLinkImplementationLibrariesInternal(config, headTarget);
     iface.Libraries.insert(iface.Libraries.end(), impl->Libraries.begin(),
                            impl->Libraries.end());
+    iface.HadContextSensitiveCondition = impl->HadContextSensitiveCondition;
     if (this->GetPolicyStatusCMP0022() == cmPolicies::WARN &&
         !this->PolicyWarnedCMP0022 && !usage_requirements_only) {
       // Compare the link implementation fallback link interface to the
@@ -5255,9 +5446,11 @@ void cmGeneratorTarget::ComputeLinkInterfaceLibraries(
       static const std::string newProp = "INTERFACE_LINK_LIBRARIES";
       if (const char* newExplicitLibraries = this->GetProperty(newProp)) {
         bool hadHeadSensitiveConditionDummy = false;
+        bool hadContextSensitiveConditionDummy = false;
         this->ExpandLinkItems(newProp, newExplicitLibraries, config,
                               headTarget, usage_requirements_only, ifaceLibs,
-                              hadHeadSensitiveConditionDummy);
+                              hadHeadSensitiveConditionDummy,
+                              hadContextSensitiveConditionDummy);
       }
       if (ifaceLibs != iface.Libraries) {
         std::string oldLibraries = cmJoin(impl->Libraries, ";");
@@ -5319,7 +5512,12 @@ const cmLinkInterface* cmGeneratorTarget::GetImportLinkInterface(
     cmSystemTools::ExpandListArgument(info->Languages, iface.Languages);
     this->ExpandLinkItems(info->LibrariesProp, info->Libraries, config,
                           headTarget, usage_requirements_only, iface.Libraries,
-                          iface.HadHeadSensitiveCondition);
+                          iface.HadHeadSensitiveCondition,
+                          iface.HadContextSensitiveCondition);
+    // The old properties may be set for each configuration.
+    if (info->LibrariesProp != "INTERFACE_LINK_LIBRARIES") {
+      iface.HadContextSensitiveCondition = true;
+    }
     std::vector<std::string> deps;
     cmSystemTools::ExpandListArgument(info->SharedDeps, deps);
     this->LookupLinkItems(deps, cmListFileBacktrace(), iface.SharedDeps);
@@ -5825,6 +6023,9 @@ void cmGeneratorTarget::ComputeLinkImplementationLibraries(
     if (cge->GetHadHeadSensitiveCondition()) {
       impl.HadHeadSensitiveCondition = true;
     }
+    if (cge->GetHadContextSensitiveCondition()) {
+      impl.HadContextSensitiveCondition = true;
+    }
 
     for (std::string const& lib : llibs) {
       // Skip entries that resolve to the target itself or are empty.
@@ -842,12 +842,35 @@ private:
   std::vector<TargetPropertyEntry*> SourceEntries;
   mutable std::set<std::string> LinkImplicitNullProperties;
 
+  // Usage requirements evaluated during the generate step, by
+  // configuration and language.  Those that do not depend on the
+  // configuration are kept by language for all configurations.
+  struct UsageRequirementsCache
+  {
+    std::map<std::string, std::vector<BT<std::string>>> ByConfig;
+    std::map<std::string, std::vector<BT<std::string>>> AnyConfig;
+  };
+  mutable UsageRequirementsCache IncludeDirectoriesCache;
+  mutable UsageRequirementsCache CompileOptionsCache;
+  mutable UsageRequirementsCache CompileDefinitionsCache;
+  bool PropertiesAreFinal() const;
+  std::vector<BT<std::string>> GetCompileFeatures(std::string const& config,
+                                                  bool& configDependent) const;
+  std::vector<BT<std::string>> const* FindUsageRequirements(
+    UsageRequirementsCache const& cache, std::string const& config,
+    std::string const& lang) const;
+  void StoreUsageRequirements(UsageRequirementsCache& cache,
+                              std::string const& config,
+                              std::string const& lang, bool configDependent,
+                              std::vector<BT<std::string>> const& result) const;
+
   void ExpandLinkItems(std::string const& prop, std::string const& value,
                        std::string const& config,
                        const cmGeneratorTarget* headTarget,
                        bool usage_requirements_only,
                        std::vector<cmLinkItem>& items,
-                       bool& hadHeadSensitiveCondition) const;
+                       bool& hadHeadSensitiveCondition,
+                       bool& hadContextSensitiveCondition) const;
   void LookupLinkItems(std::vector<std::string> const& names,
                        cmListFileBacktrace const& bt,
                        std::vector<cmLinkItem>& items) const;
@@ -884,6 +907,11 @@ private:
   typedef std::pair<std::string, cmStateEnums::ArtifactType> OutputNameKey;
   typedef std::map<OutputNameKey, std::string> OutputNameMapType;
   mutable OutputNameMapType OutputNameMap;
+
+  // Full paths computed during the generate step.
+  typedef std::pair<OutputNameKey, bool> FullPathKey;
+  typedef std::map<FullPathKey, std::string> FullPathMapType;
+  mutable FullPathMapType FullPathMap;
   mutable std::set<cmLinkItem> UtilityItems;
   cmPolicies::PolicyMap PolicyMap;
   mutable bool PolicyWarnedCMP0022;
@@ -896,6 +924,7 @@ private:
   mutable bool DebugLinkDirectoriesDone;
   mutable bool DebugSourcesDone;
   mutable bool LinkImplementationLanguageIsContextDependent;
+  mutable bool CompileFeaturesAreContextDependent;
   mutable bool UtilityItemsDone;
   bool DLLPlatform;
 
@@ -46,6 +46,8 @@
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 #  include "cmCryptoHash.h"
+#  include "cmListFileDiskCache.h"
+#  include "cmListFilePrefetcher.h"
 #  include "cm_jsoncpp_value.h"
 #  include "cm_jsoncpp_writer.h"
 #endif
@@ -98,6 +100,9 @@ cmGlobalGenerator::cmGlobalGenerator(cmake* cm)
   this->ConfigureDoneCMP0026AndCMP0024 = false;
   this->FirstTimeProgress = 0.0f;
 
+  this->TryCompileCacheHits = 0;
+  this->TryCompileCacheMisses = 0;
+
   cm->GetState()->SetIsGeneratorMultiConfig(false);
   cm->GetState()->SetMinGWMake(false);
   cm->GetState()->SetMSYSShell(false);
@@ -1169,9 +1174,48 @@ void cmGlobalGenerator::Configure()
 
   // now do it
   this->ConfigureDoneCMP0026AndCMP0024 = false;
+  this->DirectoryConfigureTimes.clear();
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  unsigned long prefetchHits = 0;
+  unsigned long prefetchMisses = 0;
+  unsigned long diskCacheHits = 0;
+  unsigned long diskCacheMisses = 0;
+  if (this->CMakeInstance->GetConfigureJobs() > 0) {
+    this->ListFilePrefetcher = cm::make_unique<cmListFilePrefetcher>(
+      this->CMakeInstance->GetConfigureJobs(), cmSystemTools::GetCMakeRoot());
+  }
+  if (cmSystemTools::IsOn(this->CMakeInstance->GetState()->GetCacheEntryValue(
+        "CMAKE_LISTFILE_CACHE"))) {
+    std::string cacheFile = this->CMakeInstance->GetHomeOutputDirectory();
+    cacheFile += cmake::GetCMakeFilesDirectory();
+    cmSystemTools::MakeDirectory(cacheFile);
+    cacheFile += "/ListFileCache.bin";
+    this->ListFileDiskCache = cm::make_unique<cmListFileDiskCache>(cacheFile);
+    this->ListFileDiskCache->Load();
+  }
+#endif
   dirMf->Configure();
   dirMf->EnforceDirectoryLevelRules();
 
+  // Remove the test projects of queued checks that were not run again.
+  size_t const batchTaken = this->TryCompileBatch.GetTakenCount();
+  size_t const batchQueued =
+    batchTaken + this->TryCompileBatch.GetUntakenCount();
+  this->TryCompileBatch.Clear(!this->CMakeInstance->GetDebugTryCompile());
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (this->ListFilePrefetcher) {
+    prefetchHits = this->ListFilePrefetcher->GetHitCount();
+    prefetchMisses = this->ListFilePrefetcher->GetMissCount();
+    this->ListFilePrefetcher.reset();
+  }
+  if (this->ListFileDiskCache) {
+    diskCacheHits = this->ListFileDiskCache->GetHitCount();
+    diskCacheMisses = this->ListFileDiskCache->GetMissCount();
+    this->ListFileDiskCache->Save();
+    this->ListFileDiskCache.reset();
+  }
+#endif
+
   this->ConfigureDoneCMP0026AndCMP0024 = true;
 
   // Put a copy of each global target in every directory.
@@ -1216,6 +1260,97 @@ void cmGlobalGenerator::Configure()
       msg << "Configuring done";
     }
     this->CMakeInstance->UpdateProgress(msg.str().c_str(), -1);
+
+    unsigned int const lookups =
+      this->TryCompileCacheHits + this->TryCompileCacheMisses;
+    if (lookups > 0) {
+      std::ostringstream cacheMsg;
+      cacheMsg << "try_compile results found in cache: "
+               << this->TryCompileCacheHits << " of " << lookups;
+      this->CMakeInstance->UpdateProgress(cacheMsg.str().c_str(), -1);
+    }
+    if (batchQueued > 0) {
+      std::ostringstream batchMsg;
+      batchMsg << "try_compile results taken from check batches: "
+               << batchTaken << " of " << batchQueued;
+      this->CMakeInstance->UpdateProgress(batchMsg.str().c_str(), -1);
+    }
+  }
+
+  if (this->CMakeInstance->GetConfigureJobs() >= 0) {
+    this->ReportDirectoryConfigureTimes();
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+    std::ostringstream msg;
+    msg << "Listfiles parsed ahead of configure: " << prefetchHits << " of "
+        << (prefetchHits + prefetchMisses);
+    this->CMakeInstance->UpdateProgress(msg.str().c_str(), -1);
+#endif
+    std::ostringstream findMsg;
+    cmDirectoryListingCache const& listings = this->DirectoryListingCache;
+    findMsg << "Find checks answered from directory listings: "
+            << listings.GetStatsAvoided() << " of " << listings.GetLookups()
+            << " (" << listings.GetDirectoriesRead() << " directories read)";
+    this->CMakeInstance->UpdateProgress(findMsg.str().c_str(), -1);
+  }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (diskCacheHits + diskCacheMisses > 0) {
+    std::ostringstream msg;
+    msg << "Listfiles loaded from the listfile cache: " << diskCacheHits
+        << " of " << (diskCacheHits + diskCacheMisses);
+    this->CMakeInstance->UpdateProgress(msg.str().c_str(), -1);
+  }
+#endif
+}
+
+void cmGlobalGenerator::BeginDirectoryConfigure()
+{
+  if (this->CMakeInstance->GetConfigureJobs() < 0) {
+    return;
+  }
+  DirectoryConfigureTimer timer;
+  timer.Start = std::chrono::steady_clock::now();
+  timer.Children = std::chrono::duration<double>::zero();
+  this->DirectoryConfigureTimers.push_back(timer);
+}
+
+void cmGlobalGenerator::EndDirectoryConfigure(std::string const& dir)
+{
+  if (this->DirectoryConfigureTimers.empty()) {
+    return;
+  }
+  DirectoryConfigureTimer const timer = this->DirectoryConfigureTimers.back();
+  this->DirectoryConfigureTimers.pop_back();
+
+  DirectoryConfigureTime time;
+  time.Directory = dir;
+  time.Total = std::chrono::steady_clock::now() - timer.Start;
+  time.Self = time.Total - timer.Children;
+  if (!this->DirectoryConfigureTimers.empty()) {
+    this->DirectoryConfigureTimers.back().Children += time.Total;
+  }
+  this->DirectoryConfigureTimes.push_back(std::move(time));
+}
+
+void cmGlobalGenerator::ReportDirectoryConfigureTimes()
+{
+  std::vector<DirectoryConfigureTime> times = this->DirectoryConfigureTimes;
+  std::stable_sort(
+    times.begin(), times.end(),
+    [](DirectoryConfigureTime const& l, DirectoryConfigureTime const& r) {
+      return l.Self > r.Self;
+    });
+
+  std::string const& home = this->CMakeInstance->GetHomeDirectory();
+  this->CMakeInstance->UpdateProgress(
+    "Configure time per directory (self / total seconds):", -1);
+  for (DirectoryConfigureTime const& time : times) {
+    std::string dir = cmSystemTools::RelativePath(home, time.Directory);
+    if (dir.empty()) {
+      dir = ".";
+    }
+    char buf[64];
+    sprintf(buf, "  %8.3f / %8.3f  ", time.Self.count(), time.Total.count());
+    this->CMakeInstance->UpdateProgress((buf + dir).c_str(), -1);
   }
 }
 
@@ -1373,6 +1508,10 @@ bool cmGlobalGenerator::Compute()
     localGen->ComputeHomeRelativeOutputPath();
   }
 
+  // The targets and their usage requirements do not change any more,
+  // so their evaluations may be remembered from now on.
+  this->GeneratorExpressionMemo.SetEnabled(true);
+
   return true;
 }
 
@@ -1384,19 +1523,31 @@ void cmGlobalGenerator::Generate()
 
   this->ProcessEvaluationFiles();
 
-  // Generate project files
-  for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i) {
-    this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
-    this->LocalGenerators[i]->Generate();
-    if (!this->LocalGenerators[i]->GetMakefile()->IsOn(
-          "CMAKE_SKIP_INSTALL_RULES")) {
-      this->LocalGenerators[i]->GenerateInstallRules();
+  // Generate project files.  The files are still generated one after
+  // the other.  With --generate-commit-jobs, comparing and replacing
+  // them is done on worker threads while the next ones are written.
+  // Test projects of try_compile are too small to gain from it.
+  {
+    std::unique_ptr<cmGeneratedFileStream::AsyncCommitScope> asyncCommit;
+    if (this->CMakeInstance->GetGenerateCommitJobs() > 0 &&
+        !this->CMakeInstance->GetIsInTryCompile()) {
+      asyncCommit = cm::make_unique<cmGeneratedFileStream::AsyncCommitScope>(
+        static_cast<unsigned int>(
+          this->CMakeInstance->GetGenerateCommitJobs()));
+    }
+    for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i) {
+      this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
+      this->LocalGenerators[i]->Generate();
+      if (!this->LocalGenerators[i]->GetMakefile()->IsOn(
+            "CMAKE_SKIP_INSTALL_RULES")) {
+        this->LocalGenerators[i]->GenerateInstallRules();
+      }
+      this->LocalGenerators[i]->GenerateTestFiles();
+      this->CMakeInstance->UpdateProgress(
+        "Generating",
+        (static_cast<float>(i) + 1.0f) /
+          static_cast<float>(this->LocalGenerators.size()));
     }
-    this->LocalGenerators[i]->GenerateTestFiles();
-    this->CMakeInstance->UpdateProgress(
-      "Generating",
-      (static_cast<float>(i) + 1.0f) /
-        static_cast<float>(this->LocalGenerators.size()));
   }
   this->SetCurrentMakefile(nullptr);
 
@@ -1666,6 +1817,14 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   this->ProjectMap.clear();
   this->RuleHashes.clear();
   this->DirectoryContentMap.clear();
+  this->DirectoryListingCache.Clear();
+  this->GeneratorExpressionMemo.Clear();
+  this->GeneratorExpressionMemo.SetEnabled(false);
+  this->SharedLinkDepends.clear();
+  this->TryCompileBatch.Clear(false);
+  this->TryCompileCacheHits = 0;
+  this->TryCompileCacheMisses = 0;
+  this->TryCompileToolHashes.clear();
   this->BinaryDirectories.clear();
 }
 
@@ -1796,6 +1955,67 @@ int cmGlobalGenerator::TryCompile(int jobs, const std::string& srcdir,
                      config, false, fast, false, this->TryCompileTimeout);
 }
 
+void cmGlobalGenerator::QueueTryCompile(std::string const& key,
+                                        const std::string& bindir,
+                                        const std::string& projectName,
+                                        const std::string& targetName,
+                                        bool fast, cmMakefile* mf)
+{
+  std::string const config =
+    mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
+  cmTryCompileBatch::Entry& entry = this->TryCompileBatch.Queue(key);
+  entry.Directory = bindir;
+  entry.TargetName = targetName;
+  this->GenerateBuildCommand(entry.BuildCommand, "", projectName, bindir,
+                             targetName, config, fast,
+                             cmake::NO_BUILD_PARALLEL_LEVEL, false);
+}
+
+bool cmGlobalGenerator::TakeTryCompileResult(std::string const& key,
+                                             std::string& bindir,
+                                             std::string& targetName,
+                                             int& ret, std::string& output)
+{
+  cmTryCompileBatch::Entry entry;
+  if (!this->TryCompileBatch.Take(key, 0, entry)) {
+    return false;
+  }
+  bindir = entry.Directory;
+  targetName = entry.TargetName;
+
+  // Report the build the way Build does.
+  std::string const makeCommandStr =
+    cmSystemTools::PrintSingleCommand(entry.BuildCommand);
+  output += "Change Dir: ";
+  output += bindir;
+  output += "\n";
+  output += "\nRun Build Command:";
+  output += makeCommandStr;
+  output += "\n";
+  output += entry.Output;
+  if (!entry.Started) {
+    output += "\nGenerator: execution of make failed. Make command was: " +
+      makeCommandStr + "\n";
+    ret = 1;
+    return true;
+  }
+  ret = this->CheckBuildOutput(entry.RetVal, output);
+  return true;
+}
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+std::string const& cmGlobalGenerator::GetTryCompileToolHash(
+  std::string const& path)
+{
+  auto it = this->TryCompileToolHashes.find(path);
+  if (it == this->TryCompileToolHashes.end()) {
+    cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+    it = this->TryCompileToolHashes.emplace(path, hasher.HashFile(path)).first;
+  }
+  return it->second;
+}
+#endif
+
 void cmGlobalGenerator::GenerateBuildCommand(
   std::vector<std::string>& makeCommand, const std::string& /*unused*/,
   const std::string& /*unused*/, const std::string& /*unused*/,
@@ -1905,6 +2125,12 @@ int cmGlobalGenerator::Build(int jobs, const std::string& /*unused*/,
   output += *outputPtr;
   cmSystemTools::SetRunCommandHideConsole(hideconsole);
 
+  return this->CheckBuildOutput(retVal, output);
+}
+
+int cmGlobalGenerator::CheckBuildOutput(int retVal,
+                                        std::string const& output) const
+{
   // The SGI MipsPro 7.3 compiler does not return an error code when
   // the source has a #error in it!  This is a work-around for such
   // compilers.
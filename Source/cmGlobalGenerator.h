@@ -5,21 +5,27 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <chrono>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "cmComputeLinkDepends.h"
 #include "cmCustomCommandLines.h"
+#include "cmDirectoryListingCache.h"
 #include "cmDuration.h"
 #include "cmExportSetMap.h"
+#include "cmGeneratorExpressionMemo.h"
 #include "cmStateSnapshot.h"
 #include "cmSystemTools.h"
 #include "cmTarget.h"
 #include "cmTargetDepend.h"
+#include "cmTryCompileBatch.h"
 #include "cm_codecvt.hxx"
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
@@ -33,6 +39,8 @@ class cmExportBuildFileGenerator;
 class cmExternalMakefileProjectGenerator;
 class cmGeneratorTarget;
 class cmLinkLineComputer;
+class cmListFileDiskCache;
+class cmListFilePrefetcher;
 class cmLocalGenerator;
 class cmMakefile;
 class cmOutputConverter;
@@ -154,6 +162,50 @@ public:
                  const std::string& targetName, bool fast, std::string& output,
                  cmMakefile* mf);
 
+  /**
+   * Queue the build of a test project that was configured and generated
+   * in bindir, to be built together with other queued projects.  The
+   * key identifies the content of the project.
+   */
+  void QueueTryCompile(std::string const& key, const std::string& bindir,
+                       const std::string& projectName,
+                       const std::string& targetName, bool fast,
+                       cmMakefile* mf);
+
+  /**
+   * Take the result of the test project queued with the given key,
+   * building all queued projects first if needed.  Returns false if no
+   * project was queued with the key.
+   */
+  bool TakeTryCompileResult(std::string const& key, std::string& bindir,
+                            std::string& targetName, int& ret,
+                            std::string& output);
+
+  /** Whether test projects are queued by QueueTryCompile.  */
+  bool HasQueuedTryCompiles() const
+  {
+    return !this->TryCompileBatch.IsEmpty();
+  }
+
+  /** Number of test projects queued by QueueTryCompile during the
+      configure step, to name the directory of the next one.  */
+  size_t GetQueuedTryCompileCount() const
+  {
+    return this->TryCompileBatch.GetQueuedCount();
+  }
+
+  /** Count a try_compile whose result was found, or not, in the cache
+      named by CMAKE_TRY_COMPILE_CACHE_DIR.  */
+  void CountTryCompileCacheLookup(bool hit)
+  {
+    ++(hit ? this->TryCompileCacheHits : this->TryCompileCacheMisses);
+  }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  /** Hash of the content of a compiler, computed once per configure.  */
+  std::string const& GetTryCompileToolHash(std::string const& path);
+#endif
+
   /**
    * Build a file given the following information. This is a more direct call
    * that is used by both CTest and TryCompile. If target name is NULL or
@@ -216,6 +268,27 @@ public:
 
   void AddMakefile(cmMakefile* mf);
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  /** Get the listfile prefetcher of the running configure step, if
+      enabled by the --configure-jobs option.  */
+  cmListFilePrefetcher* GetListFilePrefetcher() const
+  {
+    return this->ListFilePrefetcher.get();
+  }
+
+  /** Get the on-disk cache of parsed listfiles of the running configure
+      step, if enabled by the CMAKE_LISTFILE_CACHE variable.  */
+  cmListFileDiskCache* GetListFileDiskCache() const
+  {
+    return this->ListFileDiskCache.get();
+  }
+#endif
+
+  /** Track the time spent configuring a directory.  Calls nest for
+      subdirectories.  Only recorded when --configure-jobs is given.  */
+  void BeginDirectoryConfigure();
+  void EndDirectoryConfigure(std::string const& dir);
+
   ///! Set an generator for an "external makefile based project"
   void SetExternalMakefileProjectGenerator(
     cmExternalMakefileProjectGenerator* extraGenerator);
@@ -304,6 +377,32 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Get the directory listings used by the find commands to check
+      candidate paths during the configure step.  */
+  cmDirectoryListingCache& GetDirectoryListingCache()
+  {
+    return this->DirectoryListingCache;
+  }
+
+  /** Get the link dependencies computed during the generate step that
+      may be shared by targets linking the same items.  */
+  std::map<std::string, cmComputeLinkDepends::EntryVector>&
+  GetSharedLinkDepends()
+  {
+    return this->SharedLinkDepends;
+  }
+
+  /** Get the transitive interface property evaluations remembered
+      during the generate step.  */
+  cmGeneratorExpressionMemo& GetGeneratorExpressionMemo()
+  {
+    return this->GeneratorExpressionMemo;
+  }
+  cmGeneratorExpressionMemo const& GetGeneratorExpressionMemo() const
+  {
+    return this->GeneratorExpressionMemo;
+  }
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -516,6 +615,9 @@ protected:
   const char* GetPredefinedTargetsFolder();
 
 private:
+  // Fail builds whose tools do not report some errors by their result.
+  int CheckBuildOutput(int retVal, std::string const& output) const;
+
   typedef std::unordered_map<std::string, cmTarget*> TargetMap;
   typedef std::unordered_map<std::string, cmGeneratorTarget*>
     GeneratorTargetMap;
@@ -591,6 +693,8 @@ private:
 
   void ClearGeneratorMembers();
 
+  void ReportDirectoryConfigureTimes();
+
   bool CheckCMP0037(std::string const& targetName,
                     std::string const& reason) const;
 
@@ -612,6 +716,24 @@ private:
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
 
+  // Directory listings for the find commands.
+  cmDirectoryListingCache DirectoryListingCache;
+
+  // Transitive interface property evaluations.
+  cmGeneratorExpressionMemo GeneratorExpressionMemo;
+
+  // Link dependencies by directory, configuration and direct link items.
+  std::map<std::string, cmComputeLinkDepends::EntryVector> SharedLinkDepends;
+
+  // Test projects queued by try_compile calls in a batch of checks.
+  cmTryCompileBatch TryCompileBatch;
+
+  // Lookups in the try_compile result cache, and the compilers hashed
+  // for its keys.
+  unsigned int TryCompileCacheHits;
+  unsigned int TryCompileCacheMisses;
+  std::map<std::string, std::string> TryCompileToolHashes;
+
   // Set of binary directories on disk.
   std::set<std::string> BinaryDirectories;
 
@@ -626,8 +748,29 @@ private:
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   // Pool of file locks
   cmFileLockPool FileLockPool;
+
+  // Parse listfiles ahead of the configure step.
+  std::unique_ptr<cmListFilePrefetcher> ListFilePrefetcher;
+
+  // Keep parsed listfiles across runs.
+  std::unique_ptr<cmListFileDiskCache> ListFileDiskCache;
 #endif
 
+  // Wall time spent configuring each directory.
+  struct DirectoryConfigureTime
+  {
+    std::string Directory;
+    std::chrono::duration<double> Self;
+    std::chrono::duration<double> Total;
+  };
+  std::vector<DirectoryConfigureTime> DirectoryConfigureTimes;
+  struct DirectoryConfigureTimer
+  {
+    std::chrono::steady_clock::time_point Start;
+    std::chrono::duration<double> Children;
+  };
+  std::vector<DirectoryConfigureTimer> DirectoryConfigureTimers;
+
 protected:
   float FirstTimeProgress;
   bool NeedSymbolicMark;
@@ -430,6 +430,14 @@ void cmGlobalNinjaGenerator::WriteInclude(std::ostream& os,
   os << "include " << filename << "\n";
 }
 
+void cmGlobalNinjaGenerator::WriteSubninja(std::ostream& os,
+                                           const std::string& filename,
+                                           const std::string& comment)
+{
+  cmGlobalNinjaGenerator::WriteComment(os, comment);
+  os << "subninja " << filename << "\n";
+}
+
 void cmGlobalNinjaGenerator::WriteDefault(std::ostream& os,
                                           const cmNinjaDeps& targets,
                                           const std::string& comment)
@@ -445,6 +453,7 @@ void cmGlobalNinjaGenerator::WriteDefault(std::ostream& os,
 cmGlobalNinjaGenerator::cmGlobalNinjaGenerator(cmake* cm)
   : cmGlobalCommonGenerator(cm)
   , BuildFileStream(nullptr)
+  , MainBuildFileStream(nullptr)
   , RulesFileStream(nullptr)
   , CompileCommandsStream(nullptr)
   , Rules()
@@ -791,6 +800,55 @@ void cmGlobalNinjaGenerator::CloseBuildFileStream()
   }
 }
 
+static std::string cmNinjaDirectoryBuildFileDir(cmLocalGenerator* lg)
+{
+  return lg->GetCurrentBinaryDirectory() + cmake::GetCMakeFilesDirectory();
+}
+
+void cmGlobalNinjaGenerator::OpenDirectoryBuildFileStream(
+  cmLocalGenerator* lg)
+{
+  std::string const buildFileDir = cmNinjaDirectoryBuildFileDir(lg);
+  std::string const buildFilePath =
+    buildFileDir + "/" + cmGlobalNinjaGenerator::NINJA_BUILD_FILE;
+
+  // Load the directory file from the main one.  Ninja looks up rules and
+  // variables of the main file from its scope.
+  cmGlobalNinjaGenerator::WriteSubninja(
+    *this->BuildFileStream,
+    this->EncodePath(this->ConvertToNinjaPath(buildFilePath)));
+
+  // Keep the file untouched if the statements of the directory did not
+  // change, so that regenerating rewrites only the directories edited.
+  cmSystemTools::MakeDirectory(buildFileDir);
+  this->MainBuildFileStream = this->BuildFileStream;
+  this->BuildFileStream = new cmGeneratedFileStream(
+    buildFilePath, false, this->GetMakefileEncoding());
+  this->BuildFileStream->SetCopyIfDifferent(true);
+
+  this->WriteDisclaimer(*this->BuildFileStream);
+  /* clang-format off */
+  *this->BuildFileStream
+    << "# This file contains the build statements of one directory.\n"
+    << "# It is loaded by the main '" << NINJA_BUILD_FILE << "'.\n\n"
+    ;
+  /* clang-format on */
+}
+
+void cmGlobalNinjaGenerator::CloseDirectoryBuildFileStream()
+{
+  if (this->MainBuildFileStream) {
+    if (cmSystemTools::GetErrorOccuredFlag()) {
+      this->BuildFileStream->setstate(std::ios::failbit);
+    }
+    delete this->BuildFileStream;
+    this->BuildFileStream = this->MainBuildFileStream;
+    this->MainBuildFileStream = nullptr;
+  } else {
+    cmSystemTools::Error("Directory build file stream was not open.");
+  }
+}
+
 void cmGlobalNinjaGenerator::OpenRulesFileStream()
 {
   // Compute Ninja's build file path.
@@ -1435,11 +1493,22 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
   implicitDeps.erase(std::unique(implicitDeps.begin(), implicitDeps.end()),
                      implicitDeps.end());
 
+  // CMake also writes the build file of each directory.  It keeps those
+  // whose content did not change, so restat them to not re-run forever.
+  cmNinjaDeps implicitOuts;
+  if (this->SupportsImplicitOuts() && this->SupportsManifestRestat()) {
+    for (cmLocalGenerator* localGen : this->LocalGenerators) {
+      implicitOuts.push_back(this->ConvertToNinjaPath(
+        cmNinjaDirectoryBuildFileDir(localGen) + "/" + NINJA_BUILD_FILE));
+    }
+    variables["restat"] = "1";
+  }
+
   std::string const ninjaBuildFile = this->NinjaOutputPath(NINJA_BUILD_FILE);
   this->WriteBuild(os, "Re-run CMake if any of its inputs changed.",
                    "RERUN_CMAKE",
-                   /*outputs=*/cmNinjaDeps(1, ninjaBuildFile),
-                   /*implicitOuts=*/cmNinjaDeps(), explicitDeps, implicitDeps,
+                   /*outputs=*/cmNinjaDeps(1, ninjaBuildFile), implicitOuts,
+                   explicitDeps, implicitDeps,
                    /*orderOnlyDeps=*/cmNinjaDeps(), variables);
 
   cmNinjaDeps missingInputs;
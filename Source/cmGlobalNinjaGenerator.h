@@ -166,6 +166,13 @@ public:
   static void WriteInclude(std::ostream& os, const std::string& filename,
                            const std::string& comment = "");
 
+  /**
+   * Write a subninja statement loading @a filename in a scope of its own
+   * with an optional @a comment to the @a os stream.
+   */
+  static void WriteSubninja(std::ostream& os, const std::string& filename,
+                            const std::string& comment = "");
+
   /**
    * Write a default target statement specifying @a targets as
    * the default targets.
@@ -246,6 +253,11 @@ public:
     return this->RulesFileStream;
   }
 
+  /// Send the build statements to a file of the directory of @a lg,
+  /// loaded by the main build file, until the matching close call.
+  void OpenDirectoryBuildFileStream(cmLocalGenerator* lg);
+  void CloseDirectoryBuildFileStream();
+
   std::string const& ConvertToNinjaPath(const std::string& path) const;
 
   struct MapToNinjaPathImpl
@@ -409,6 +421,8 @@ private:
   /// The file containing the build statement. (the relationship of the
   /// compilation DAG).
   cmGeneratedFileStream* BuildFileStream;
+  /// The main build file while a directory file is open.
+  cmGeneratedFileStream* MainBuildFileStream;
   /// The file containing the rule statements. (The action attached to each
   /// edge of the compilation DAG).
   cmGeneratedFileStream* RulesFileStream;
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <utility>
 
+#include "cmCheckBuildSystemManifest.h"
 #include "cmDocumentationEntry.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorTarget.h"
@@ -23,6 +24,10 @@
 #include "cmTargetDepend.h"
 #include "cmake.h"
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmCryptoHash.h"
+#endif
+
 cmGlobalUnixMakefileGenerator3::cmGlobalUnixMakefileGenerator3(cmake* cm)
   : cmGlobalCommonGenerator(cm)
 {
@@ -124,6 +129,8 @@ void cmGlobalUnixMakefileGenerator3::Generate()
 {
   // first do superclass method
   this->cmGlobalGenerator::Generate();
+  this->ProgressNodes.clear();
+  this->ProgressNodeIndex.clear();
 
   // initialize progress
   unsigned long total = 0;
@@ -317,16 +324,39 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
   // reset lg to the first makefile
   lg = static_cast<cmLocalUnixMakefileGenerator3*>(this->LocalGenerators[0]);
 
+  // Collect the lists also for the manifest written next to the file.
+  cmCheckBuildSystemManifest manifest;
+
   std::string currentBinDir = lg->GetCurrentBinaryDirectory();
   // Save the list to the cmake file.
   cmakefileStream
     << "# The top level Makefile was generated from the following files:\n"
     << "set(CMAKE_MAKEFILE_DEPENDS\n"
     << "  \"CMakeCache.txt\"\n";
+  manifest.Depends.push_back("CMakeCache.txt");
   for (std::string const& f : lfiles) {
-    cmakefileStream << "  \"" << lg->ConvertToRelativePath(currentBinDir, f)
-                    << "\"\n";
+    manifest.Depends.push_back(lg->ConvertToRelativePath(currentBinDir, f));
+    cmakefileStream << "  \"" << manifest.Depends.back() << "\"\n";
   }
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Record the content of the dependencies so that the check can tell
+  // a modification from a mere update of their time stamps.  The glob
+  // verification stamp is only ever touched, so its time stamp counts.
+  if (this->GlobalSettingIsOn("CMAKE_REGENERATION_COMPARE_CONTENT")) {
+    cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+    std::string const cacheFile =
+      cm->GetHomeOutputDirectory() + "/CMakeCache.txt";
+    manifest.DependHashes.push_back(hasher.HashFile(cacheFile));
+    for (std::string const& f : lfiles) {
+      if (cm->DoWriteGlobVerifyTarget() && f == cm->GetGlobVerifyStamp()) {
+        manifest.DependHashes.emplace_back();
+      } else {
+        manifest.DependHashes.push_back(hasher.HashFile(f));
+      }
+    }
+  }
+#endif
   cmakefileStream << "  )\n\n";
 
   // Build the path to the cache check file.
@@ -335,13 +365,14 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
   check += "/cmake.check_cache";
 
   // Set the corresponding makefile in the cmake file.
+  manifest.Outputs.push_back(
+    lg->ConvertToRelativePath(currentBinDir, makefileName));
+  manifest.Outputs.push_back(lg->ConvertToRelativePath(currentBinDir, check));
   cmakefileStream << "# The corresponding makefile is:\n"
-                  << "set(CMAKE_MAKEFILE_OUTPUTS\n"
-                  << "  \""
-                  << lg->ConvertToRelativePath(currentBinDir, makefileName)
-                  << "\"\n"
-                  << "  \"" << lg->ConvertToRelativePath(currentBinDir, check)
-                  << "\"\n";
+                  << "set(CMAKE_MAKEFILE_OUTPUTS\n";
+  for (std::string const& o : manifest.Outputs) {
+    cmakefileStream << "  \"" << o << "\"\n";
+  }
   cmakefileStream << "  )\n\n";
 
   const std::string binDir = lg->GetBinaryDirectory();
@@ -353,8 +384,8 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
     const std::vector<std::string>& outfiles =
       lg->GetMakefile()->GetOutputFiles();
     for (std::string const& outfile : outfiles) {
-      cmakefileStream << "  \"" << lg->ConvertToRelativePath(binDir, outfile)
-                      << "\"\n";
+      manifest.Products.push_back(lg->ConvertToRelativePath(binDir, outfile));
+      cmakefileStream << "  \"" << manifest.Products.back() << "\"\n";
     }
 
     // add in all the directory information files
@@ -364,14 +395,19 @@ void cmGlobalUnixMakefileGenerator3::WriteMainCMakefile()
       tmpStr = lg->GetCurrentBinaryDirectory();
       tmpStr += cmake::GetCMakeFilesDirectory();
       tmpStr += "/CMakeDirectoryInformation.cmake";
-      cmakefileStream << "  \"" << lg->ConvertToRelativePath(binDir, tmpStr)
-                      << "\"\n";
+      manifest.Products.push_back(lg->ConvertToRelativePath(binDir, tmpStr));
+      cmakefileStream << "  \"" << manifest.Products.back() << "\"\n";
     }
     cmakefileStream << "  )\n\n";
   }
 
   this->WriteMainCMakefileLanguageRules(cmakefileStream,
                                         this->LocalGenerators);
+
+  // The manifest records the time stamp of the complete file.
+  if (cmakefileStream.Close()) {
+    manifest.Write(cmakefileName);
+  }
 }
 
 void cmGlobalUnixMakefileGenerator3::WriteMainCMakefileLanguageRules(
@@ -722,7 +758,7 @@ void cmGlobalUnixMakefileGenerator3::WriteConvenienceRules2(
           cmSystemTools::CollapseFullPath(progress.Dir),
           cmOutputConverter::SHELL);
         //
-        std::set<cmGeneratorTarget const*> emitted;
+        std::vector<bool> emitted;
         progCmd << " " << this->CountProgressMarksInTarget(gtarget, emitted);
         commands.push_back(progCmd.str());
       }
@@ -834,18 +870,51 @@ void cmGlobalUnixMakefileGenerator3::InitializeProgressMarks()
   }
 }
 
+size_t cmGlobalUnixMakefileGenerator3::GetProgressNode(
+  cmGeneratorTarget const* target)
+{
+  auto const inserted =
+    this->ProgressNodeIndex.insert(std::make_pair(target, 0));
+  if (!inserted.second) {
+    return inserted.first->second;
+  }
+  size_t const index = this->ProgressNodes.size();
+  inserted.first->second = index;
+  this->ProgressNodes.emplace_back();
+  this->ProgressNodes[index].Marks = this->ProgressMap[target].Marks.size();
+
+  // Number the dependencies before storing them because the recursion
+  // appends to ProgressNodes.
+  std::vector<size_t> depends;
+  for (cmTargetDepend const& depend : this->GetTargetDirectDepends(target)) {
+    if (depend->GetType() == cmStateEnums::INTERFACE_LIBRARY) {
+      continue;
+    }
+    depends.push_back(this->GetProgressNode(depend));
+  }
+  this->ProgressNodes[index].Depends = std::move(depends);
+  return index;
+}
+
 size_t cmGlobalUnixMakefileGenerator3::CountProgressMarksInTarget(
-  cmGeneratorTarget const* target, std::set<cmGeneratorTarget const*>& emitted)
+  cmGeneratorTarget const* target, std::vector<bool>& emitted)
 {
   size_t count = 0;
-  if (emitted.insert(target).second) {
-    count = this->ProgressMap[target].Marks.size();
-    TargetDependSet const& depends = this->GetTargetDirectDepends(target);
-    for (cmTargetDepend const& depend : depends) {
-      if (depend->GetType() == cmStateEnums::INTERFACE_LIBRARY) {
-        continue;
+  std::vector<size_t> queue(1, this->GetProgressNode(target));
+  emitted.resize(this->ProgressNodes.size(), false);
+  while (!queue.empty()) {
+    size_t const index = queue.back();
+    queue.pop_back();
+    if (emitted[index]) {
+      continue;
+    }
+    emitted[index] = true;
+    ProgressNode const& node = this->ProgressNodes[index];
+    count += node.Marks;
+    for (size_t depend : node.Depends) {
+      if (!emitted[depend]) {
+        queue.push_back(depend);
       }
-      count += this->CountProgressMarksInTarget(depend, emitted);
     }
   }
   return count;
@@ -855,7 +924,7 @@ size_t cmGlobalUnixMakefileGenerator3::CountProgressMarksInAll(
   cmLocalGenerator* lg)
 {
   size_t count = 0;
-  std::set<cmGeneratorTarget const*> emitted;
+  std::vector<bool> emitted;
   std::set<cmGeneratorTarget const*> const& targets =
     this->DirectoryTargetsMap[lg->GetStateSnapshot()];
   for (cmGeneratorTarget const* target : targets) {
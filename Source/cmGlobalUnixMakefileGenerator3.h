@@ -231,9 +231,21 @@ protected:
     ProgressMapType;
   ProgressMapType ProgressMap;
 
-  size_t CountProgressMarksInTarget(
-    cmGeneratorTarget const* target,
-    std::set<cmGeneratorTarget const*>& emitted);
+  // Targets numbered in the order first counted, with the progress
+  // marks of each and the numbers of the targets it depends on.  Large
+  // projects count the same dependency trees once per target, so walk
+  // them without looking up each target again.
+  struct ProgressNode
+  {
+    size_t Marks;
+    std::vector<size_t> Depends;
+  };
+  std::vector<ProgressNode> ProgressNodes;
+  std::map<cmGeneratorTarget const*, size_t> ProgressNodeIndex;
+  size_t GetProgressNode(cmGeneratorTarget const* target);
+
+  size_t CountProgressMarksInTarget(cmGeneratorTarget const* target,
+                                    std::vector<bool>& emitted);
   size_t CountProgressMarksInAll(cmLocalGenerator* lg);
 
   cmGeneratedFileStream* CommandDatabase;
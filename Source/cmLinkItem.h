@@ -46,18 +46,38 @@ public:
     dependencies needed by the object files of the target.  */
 struct cmLinkImplementationLibraries
 {
+  cmLinkImplementationLibraries()
+    : HadContextSensitiveCondition(false)
+  {
+  }
+
   // Libraries linked directly in this configuration.
   std::vector<cmLinkImplItem> Libraries;
 
   // Libraries linked directly in other configurations.
   // Needed only for OLD behavior of CMP0003.
   std::vector<cmLinkItem> WrongConfigLibraries;
+
+  // Whether the libraries depend on the configuration.
+  bool HadContextSensitiveCondition;
 };
 
 struct cmLinkInterfaceLibraries
 {
+  cmLinkInterfaceLibraries()
+    : HadHeadSensitiveCondition(false)
+    , HadContextSensitiveCondition(false)
+  {
+  }
+
   // Libraries listed in the interface.
   std::vector<cmLinkItem> Libraries;
+
+  // Whether the libraries depend on the head target.
+  bool HadHeadSensitiveCondition;
+
+  // Whether the libraries depend on the configuration.
+  bool HadContextSensitiveCondition;
 };
 
 struct cmLinkInterface : public cmLinkInterfaceLibraries
@@ -91,14 +111,12 @@ struct cmOptionalLinkInterface : public cmLinkInterface
     : LibrariesDone(false)
     , AllDone(false)
     , Exists(false)
-    , HadHeadSensitiveCondition(false)
     , ExplicitLibraries(nullptr)
   {
   }
   bool LibrariesDone;
   bool AllDone;
   bool Exists;
-  bool HadHeadSensitiveCondition;
   const char* ExplicitLibraries;
 };
 
@@ -29,7 +29,11 @@ struct cmListFileParser
   ~cmListFileParser();
   void IssueFileOpenError(std::string const& text) const;
   void IssueError(std::string const& text) const;
+  void IssueMessage(cmake::MessageType t, std::string const& text,
+                    long line) const;
   bool ParseFile();
+  bool ParseString(const char* str);
+  bool Parse();
   bool ParseFunction(const char* name, long line);
   bool AddArgument(cmListFileLexer_Token* token,
                    cmListFileArgument::Delimiter delim);
@@ -66,18 +70,35 @@ cmListFileParser::~cmListFileParser()
 
 void cmListFileParser::IssueFileOpenError(const std::string& text) const
 {
+  if (!this->Messenger) {
+    return;
+  }
   this->Messenger->IssueMessage(cmake::FATAL_ERROR, text, this->Backtrace);
 }
 
 void cmListFileParser::IssueError(const std::string& text) const
 {
+  if (!this->Messenger) {
+    return;
+  }
+  this->IssueMessage(cmake::FATAL_ERROR, text,
+                     cmListFileLexer_GetCurrentLine(this->Lexer));
+  cmSystemTools::SetFatalErrorOccured();
+}
+
+void cmListFileParser::IssueMessage(cmake::MessageType t,
+                                    std::string const& text,
+                                    long line) const
+{
+  if (!this->Messenger) {
+    return;
+  }
   cmListFileContext lfc;
   lfc.FilePath = this->FileName;
-  lfc.Line = cmListFileLexer_GetCurrentLine(this->Lexer);
+  lfc.Line = line;
   cmListFileBacktrace lfbt = this->Backtrace;
   lfbt = lfbt.Push(lfc);
-  this->Messenger->IssueMessage(cmake::FATAL_ERROR, text, lfbt);
-  cmSystemTools::SetFatalErrorOccured();
+  this->Messenger->IssueMessage(t, text, lfbt);
 }
 
 bool cmListFileParser::ParseFile()
@@ -104,6 +125,21 @@ bool cmListFileParser::ParseFile()
     return false;
   }
 
+  return this->Parse();
+}
+
+bool cmListFileParser::ParseString(const char* str)
+{
+  if (!cmListFileLexer_SetString(this->Lexer, str)) {
+    this->IssueFileOpenError("cmListFileCache: cannot allocate buffer.");
+    return false;
+  }
+
+  return this->Parse();
+}
+
+bool cmListFileParser::Parse()
+{
   // Use a simple recursive-descent parser to process the token
   // stream.
   bool haveNewline = true;
@@ -159,6 +195,46 @@ bool cmListFile::ParseFile(const char* filename, cmMessenger* messenger,
   return !parseError;
 }
 
+bool cmListFile::ParseString(const char* str, const char* virtual_filename,
+                             cmMessenger* messenger,
+                             cmListFileBacktrace const& lfbt)
+{
+  bool parseError = false;
+
+  {
+    cmListFileParser parser(this, lfbt, messenger, virtual_filename);
+    parseError = !parser.ParseString(str);
+  }
+
+  return !parseError;
+}
+
+bool cmListFile::PrepareContent(std::string const& content,
+                                std::string& text)
+{
+  // Drop a UTF-8 Byte-Order-Mark and convert CRLF to LF as the
+  // file lexer does.
+  std::string::size_type start = 0;
+  if (content.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+    start = 3;
+  }
+  text.clear();
+  text.reserve(content.size() - start);
+  for (std::string::size_type i = start; i < content.size(); ++i) {
+    if (content[i] != '\r' || i + 1 == content.size() ||
+        content[i + 1] != '\n') {
+      text += content[i];
+    }
+  }
+
+  // The string lexer cannot represent other Byte-Order-Marks or
+  // embedded null characters.
+  unsigned char const first =
+    text.empty() ? 0 : static_cast<unsigned char>(text[0]);
+  return first != 0xFE && first != 0xFF &&
+    text.find('\0') == std::string::npos;
+}
+
 bool cmListFileParser::ParseFunction(const char* name, long line)
 {
   // Ininitialize a new function call.
@@ -247,14 +323,9 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
   }
 
   std::ostringstream error;
-  cmListFileContext lfc;
-  lfc.FilePath = this->FileName;
-  lfc.Line = lastLine;
-  cmListFileBacktrace lfbt = this->Backtrace;
-  lfbt = lfbt.Push(lfc);
   error << "Parse error.  Function missing ending \")\".  "
         << "End of file reached.";
-  this->Messenger->IssueMessage(cmake::FATAL_ERROR, error.str(), lfbt);
+  this->IssueMessage(cmake::FATAL_ERROR, error.str(), lastLine);
   return false;
 }
 
@@ -267,22 +338,21 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
   }
   bool isError = (this->Separation == SeparationError ||
                   delim == cmListFileArgument::Bracket);
+  if (!this->Messenger) {
+    // Without a messenger we cannot report the warning, so fail and
+    // let the caller parse again with diagnostics enabled.
+    return false;
+  }
   std::ostringstream m;
-  cmListFileContext lfc;
-  lfc.FilePath = this->FileName;
-  lfc.Line = token->line;
-  cmListFileBacktrace lfbt = this->Backtrace;
-  lfbt = lfbt.Push(lfc);
-
   m << "Syntax " << (isError ? "Error" : "Warning") << " in cmake code at "
     << "column " << token->column << "\n"
     << "Argument not separated from preceding token by whitespace.";
   /* clang-format on */
   if (isError) {
-    this->Messenger->IssueMessage(cmake::FATAL_ERROR, m.str(), lfbt);
+    this->IssueMessage(cmake::FATAL_ERROR, m.str(), token->line);
     return false;
   }
-  this->Messenger->IssueMessage(cmake::AUTHOR_WARNING, m.str(), lfbt);
+  this->IssueMessage(cmake::AUTHOR_WARNING, m.str(), token->line);
   return true;
 }
 
@@ -45,6 +45,54 @@ struct cmCommandContext
   }
 };
 
+/** \class cmListFileArgumentExpansion
+ * \brief Variable references of an argument recorded during expansion.
+ *
+ * The first time cmMakefile expands an argument of a command it records
+ * the literal text and the ${}, $ENV{} and $CACHE{} references found in
+ * it.  Later expansions of the same argument replay the operations
+ * instead of scanning the text again.
+ */
+struct cmListFileArgumentExpansion
+{
+  cmListFileArgumentExpansion()
+    : Recorded(false)
+  {
+  }
+
+  enum Domain
+  {
+    Normal,
+    Environment,
+    Cache
+  };
+  enum OpCode
+  {
+    Literal,
+    Open,
+    Close
+  };
+  struct Op
+  {
+    Op(OpCode code, Domain domain, std::string text, long line)
+      : Code(code)
+      , RefDomain(domain)
+      , Text(std::move(text))
+      , Line(line)
+    {
+    }
+    OpCode Code;
+    // The kind of reference started by an Open operation.
+    Domain RefDomain;
+    // The text appended by a Literal operation.
+    std::string Text;
+    // The line of a Close operation relative to the argument.
+    long Line;
+  };
+  bool Recorded;
+  std::vector<Op> Ops;
+};
+
 struct cmListFileArgument
 {
   enum Delimiter
@@ -64,6 +112,10 @@ struct cmListFileArgument
     , Delim(d)
     , Line(line)
   {
+    // Arguments without references or escapes expand to themselves.
+    if (d != Bracket && v.find_first_of("$\\") != std::string::npos) {
+      this->Expansion = std::make_shared<cmListFileArgumentExpansion>();
+    }
   }
   bool operator==(const cmListFileArgument& r) const
   {
@@ -73,6 +125,9 @@ struct cmListFileArgument
   std::string Value;
   Delimiter Delim;
   long Line;
+  // Recorded by cmMakefile::ExpandArguments.  Shared by all copies of
+  // the argument so that function bodies benefit from it.
+  std::shared_ptr<cmListFileArgumentExpansion> Expansion;
 };
 
 class cmListFileContext
@@ -207,6 +262,17 @@ struct cmListFile
   bool ParseFile(const char* path, cmMessenger* messenger,
                  cmListFileBacktrace const& lfbt);
 
+  // Parse listfile code held in memory.  The virtual file name is used
+  // in diagnostics.  If no messenger is given, parsing fails on the
+  // first diagnostic instead of reporting it.
+  bool ParseString(const char* str, const char* virtual_filename,
+                   cmMessenger* messenger, cmListFileBacktrace const& lfbt);
+
+  // Convert the raw content of a listfile to the text the lexer sees
+  // when reading the file itself.  Returns false for content that only
+  // the file reader diagnoses, such as a Byte-Order-Mark other than UTF-8.
+  static bool PrepareContent(std::string const& content, std::string& text);
+
   std::vector<cmListFileFunction> Functions;
 };
 
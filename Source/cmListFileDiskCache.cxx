@@ -0,0 +1,302 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmListFileDiskCache.h"
+
+#include "cmBinaryCodec.h"
+#include "cmCryptoHash.h"
+#include "cmSystemTools.h"
+#include "cmVersion.h"
+
+#include "cmsys/FStream.hxx"
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Increment when the layout below changes.
+size_t const FormatVersion = 2;
+char const Magic[] = "CMakeListFileCache";
+
+bool ReadContent(std::string const& path, std::string& content)
+{
+  cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  content.assign(std::istreambuf_iterator<char>(fin),
+                 std::istreambuf_iterator<char>());
+  return !fin.bad();
+}
+
+// Numbers that may not fit a size are stored as decimal strings.
+bool ReadLong(cmBinaryReader& in, long& n)
+{
+  std::string s;
+  return in.ReadString(s) && cmSystemTools::StringToLong(s.c_str(), &n);
+}
+
+bool ReadULong(cmBinaryReader& in, unsigned long& n)
+{
+  std::string s;
+  return in.ReadString(s) && cmSystemTools::StringToULong(s.c_str(), &n);
+}
+}
+
+cmListFileDiskCache::cmListFileDiskCache(std::string cacheFile)
+  : CacheFile(std::move(cacheFile))
+  , CacheTime(0)
+  , Hits(0)
+  , Misses(0)
+  , Modified(false)
+{
+}
+
+void cmListFileDiskCache::Load()
+{
+  this->Entries.clear();
+  this->Modified = false;
+
+  std::string data;
+  if (!ReadContent(this->CacheFile, data)) {
+    return;
+  }
+  this->CacheTime = cmSystemTools::ModifiedTime(this->CacheFile);
+
+  cmBinaryReader in(data);
+  std::string magic;
+  size_t version;
+  std::string cmakeVersion;
+  size_t count;
+  if (!in.ReadString(magic) || magic != Magic || !in.ReadSize(version) ||
+      version != FormatVersion || !in.ReadString(cmakeVersion) ||
+      cmakeVersion != cmVersion::GetCMakeVersion() || !in.ReadSize(count)) {
+    this->Modified = true;
+    return;
+  }
+
+  std::map<std::string, Entry> entries;
+  for (; count > 0; --count) {
+    std::string path;
+    Entry entry;
+    size_t functions;
+    if (!in.ReadString(path) || !ReadLong(in, entry.MTime) ||
+        !ReadULong(in, entry.Size) || !in.ReadString(entry.Hash) ||
+        !in.ReadSize(functions)) {
+      this->Modified = true;
+      return;
+    }
+    for (; functions > 0; --functions) {
+      cmListFileFunction func;
+      size_t line;
+      size_t arguments;
+      if (!in.ReadString(func.Name.Original) ||
+          !in.ReadString(func.Name.Lower) || !in.ReadSize(line) ||
+          !in.ReadSize(arguments)) {
+        this->Modified = true;
+        return;
+      }
+      func.Line = static_cast<long>(line);
+      for (; arguments > 0; --arguments) {
+        std::string value;
+        size_t delim;
+        size_t argLine;
+        if (!in.ReadString(value) || !in.ReadSize(delim) ||
+            delim > cmListFileArgument::Bracket || !in.ReadSize(argLine)) {
+          this->Modified = true;
+          return;
+        }
+        func.Arguments.emplace_back(
+          value, static_cast<cmListFileArgument::Delimiter>(delim),
+          static_cast<long>(argLine));
+      }
+      entry.Functions.push_back(std::move(func));
+    }
+    entries[path] = std::move(entry);
+  }
+
+  if (!in.AtEnd()) {
+    // Ignore a cache file with trailing garbage.
+    this->Modified = true;
+    return;
+  }
+  this->Entries = std::move(entries);
+}
+
+bool cmListFileDiskCache::Save()
+{
+  // Drop entries of files not read by this run.
+  for (std::map<std::string, Entry>::iterator i = this->Entries.begin();
+       i != this->Entries.end();) {
+    if (i->second.Used) {
+      ++i;
+    } else {
+      i = this->Entries.erase(i);
+      this->Modified = true;
+    }
+  }
+  if (!this->Modified) {
+    return true;
+  }
+
+  std::string data;
+  cmBinaryWriter out(data);
+  out.WriteString(Magic);
+  out.WriteSize(FormatVersion);
+  out.WriteString(cmVersion::GetCMakeVersion());
+  out.WriteSize(this->Entries.size());
+  for (auto const& e : this->Entries) {
+    Entry const& entry = e.second;
+    out.WriteString(e.first);
+    out.WriteString(std::to_string(entry.MTime));
+    out.WriteString(std::to_string(entry.Size));
+    out.WriteString(entry.Hash);
+    out.WriteSize(entry.Functions.size());
+    for (cmListFileFunction const& func : entry.Functions) {
+      out.WriteString(func.Name.Original);
+      out.WriteString(func.Name.Lower);
+      out.WriteSize(static_cast<size_t>(func.Line));
+      out.WriteSize(func.Arguments.size());
+      for (cmListFileArgument const& arg : func.Arguments) {
+        out.WriteString(arg.Value);
+        out.WriteSize(static_cast<size_t>(arg.Delim));
+        out.WriteSize(static_cast<size_t>(arg.Line));
+      }
+    }
+  }
+
+  // Write a temporary file and rename it so that a concurrent or
+  // interrupted run never sees a partial cache.
+  std::string const tmpFile = this->CacheFile + ".tmp";
+  {
+    cmsys::ofstream fout(tmpFile.c_str(), std::ios::out | std::ios::binary);
+    if (!fout) {
+      return false;
+    }
+    fout.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!fout) {
+      return false;
+    }
+  }
+  if (!cmSystemTools::RenameFile(tmpFile.c_str(), this->CacheFile.c_str())) {
+    cmSystemTools::RemoveFile(tmpFile);
+    return false;
+  }
+  this->Modified = false;
+  return true;
+}
+
+bool cmListFileDiskCache::ParseFile(std::string const& path,
+                                    cmListFile& listFile,
+                                    cmMessenger* messenger,
+                                    cmListFileBacktrace const& lfbt)
+{
+  long mtime;
+  unsigned long size;
+  if (!this->Stat(path, mtime, size)) {
+    // Let the parser diagnose the problem.
+    ++this->Misses;
+    return listFile.ParseFile(path.c_str(), messenger, lfbt);
+  }
+
+  // Trust the time stamp and size if they are enough to tell a change.
+  std::map<std::string, Entry>::iterator i = this->Entries.find(path);
+  bool const sameStat = i != this->Entries.end() &&
+    i->second.MTime == mtime && i->second.Size == size;
+  if (sameStat && this->IsStatReliable(mtime)) {
+    i->second.Used = true;
+    listFile.Functions = i->second.Functions;
+    ++this->Hits;
+    return true;
+  }
+
+  std::string content;
+  if (!ReadContent(path, content)) {
+    ++this->Misses;
+    return listFile.ParseFile(path.c_str(), messenger, lfbt);
+  }
+  std::string const hash = cmListFileDiskCache::Hash(content);
+  if (sameStat && i->second.Hash == hash) {
+    // Save the entry again so that its time stamp becomes reliable.
+    i->second.Used = true;
+    listFile.Functions = i->second.Functions;
+    this->Modified = true;
+    ++this->Hits;
+    return true;
+  }
+  ++this->Misses;
+
+  // Parse the content we hashed so the entry matches it exactly.
+  std::string text;
+  if (!cmListFile::PrepareContent(content, text)) {
+    return listFile.ParseFile(path.c_str(), messenger, lfbt);
+  }
+
+  // A cache hit cannot repeat the diagnostics of the parser, so store
+  // only content that parses without any.  Without a messenger the
+  // parser fails on the first diagnostic, so parse again to issue it.
+  cmListFile clean;
+  if (!clean.ParseString(text.c_str(), path.c_str(), nullptr, lfbt)) {
+    return listFile.ParseString(text.c_str(), path.c_str(), messenger, lfbt);
+  }
+  listFile.Functions = std::move(clean.Functions);
+
+  Entry& entry = this->Entries[path];
+  entry.MTime = mtime;
+  entry.Size = size;
+  entry.Hash = hash;
+  entry.Functions = listFile.Functions;
+  entry.Used = true;
+  this->Modified = true;
+  return true;
+}
+
+void cmListFileDiskCache::Store(std::string const& path,
+                                std::string const& content,
+                                cmListFile const& listFile)
+{
+  long mtime;
+  unsigned long size;
+  if (!this->Stat(path, mtime, size) || size != content.size()) {
+    return;
+  }
+  Entry& entry = this->Entries[path];
+  entry.Used = true;
+  bool const sameStat = entry.MTime == mtime && entry.Size == size;
+  if (sameStat && this->IsStatReliable(mtime)) {
+    return;
+  }
+  // Save the entry again even if only its time stamp becomes reliable.
+  this->Modified = true;
+  std::string const hash = cmListFileDiskCache::Hash(content);
+  if (sameStat && entry.Hash == hash) {
+    return;
+  }
+  entry.MTime = mtime;
+  entry.Size = size;
+  entry.Hash = hash;
+  entry.Functions = listFile.Functions;
+}
+
+bool cmListFileDiskCache::IsStatReliable(long mtime) const
+{
+  // A file modified no earlier than the cache file was written may have
+  // changed again within the resolution of its time stamp.
+  return mtime < this->CacheTime;
+}
+
+bool cmListFileDiskCache::Stat(std::string const& path, long& mtime,
+                               unsigned long& size) const
+{
+  if (!cmSystemTools::FileExists(path, true)) {
+    return false;
+  }
+  mtime = cmSystemTools::ModifiedTime(path);
+  size = cmSystemTools::FileLength(path);
+  return true;
+}
+
+std::string cmListFileDiskCache::Hash(std::string const& content)
+{
+  cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+  return hasher.HashString(content);
+}
@@ -0,0 +1,83 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmListFileDiskCache_h
+#define cmListFileDiskCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmListFileCache.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class cmMessenger;
+
+/** \class cmListFileDiskCache
+ * \brief Keep parsed listfiles in a binary file across CMake runs.
+ *
+ * Entries are keyed by the path of the listfile and hold its
+ * modification time, size and content hash.  An entry is used if the
+ * time and size still match the file on disk.  If the file was modified
+ * no earlier than the cache file was written, its content must still
+ * have the hash too.  Entries not used during a run are dropped when
+ * the cache file is saved.
+ */
+class cmListFileDiskCache
+{
+public:
+  cmListFileDiskCache(std::string cacheFile);
+
+  CM_DISABLE_COPY(cmListFileDiskCache)
+
+  /** Read the cache file.  A missing or unreadable file, or one written
+      by a different version of CMake, results in an empty cache.  */
+  void Load();
+
+  /** Write the cache file if any entry was added or dropped.  */
+  bool Save();
+
+  /** Parse the listfile \a path, using the cached content if it is
+      still valid and updating the cache otherwise.  Content whose
+      parsing issues a diagnostic, such as a warning, is not cached.  */
+  bool ParseFile(std::string const& path, cmListFile& listFile,
+                 cmMessenger* messenger, cmListFileBacktrace const& lfbt);
+
+  /** Add content parsed elsewhere from the given raw file content.  */
+  void Store(std::string const& path, std::string const& content,
+             cmListFile const& listFile);
+
+  /** Number of listfiles served from the cache, and read otherwise.  */
+  unsigned long GetHitCount() const { return this->Hits; }
+  unsigned long GetMissCount() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    Entry()
+      : MTime(0)
+      , Size(0)
+      , Used(false)
+    {
+    }
+    long MTime;
+    unsigned long Size;
+    std::string Hash;
+    std::vector<cmListFileFunction> Functions;
+    bool Used;
+  };
+
+  bool Stat(std::string const& path, long& mtime,
+            unsigned long& size) const;
+  bool IsStatReliable(long mtime) const;
+  static std::string Hash(std::string const& content);
+
+  std::string CacheFile;
+  long CacheTime;
+  std::map<std::string, Entry> Entries;
+  unsigned long Hits;
+  unsigned long Misses;
+  bool Modified;
+};
+
+#endif
@@ -0,0 +1,173 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmListFilePrefetcher.h"
+
+#include "cmSystemTools.h"
+
+#include "cmsys/FStream.hxx"
+#include <iterator>
+#include <utility>
+#include <vector>
+
+cmListFilePrefetcher::cmListFilePrefetcher(unsigned int threadCount,
+                                           std::string cmakeRoot)
+  : CMakeRoot(std::move(cmakeRoot))
+  , Hits(0)
+  , Misses(0)
+  , Stopping(false)
+  , Pool(threadCount)
+{
+}
+
+cmListFilePrefetcher::~cmListFilePrefetcher()
+{
+  // Drop speculative work that has not started yet.  The pool member
+  // is destroyed after this and waits for the running jobs.
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Stopping = true;
+}
+
+void cmListFilePrefetcher::PrefetchReferencedFiles(
+  cmListFile const& listFile, std::string const& listFileName,
+  std::string const& sourceDir)
+{
+  std::string const listDir = cmSystemTools::GetFilenamePath(listFileName);
+  for (cmListFileFunction const& func : listFile.Functions) {
+    if (func.Arguments.empty()) {
+      continue;
+    }
+    if (func.Name.Lower == "add_subdirectory") {
+      std::string dir =
+        this->ResolveArgument(func.Arguments[0], listDir, sourceDir);
+      if (dir.empty()) {
+        continue;
+      }
+      dir = cmSystemTools::CollapseFullPath(dir, sourceDir);
+      this->Prefetch(dir + "/CMakeLists.txt", dir);
+    } else if (func.Name.Lower == "include") {
+      std::string file =
+        this->ResolveArgument(func.Arguments[0], listDir, sourceDir);
+      if (file.empty()) {
+        continue;
+      }
+      if (!cmSystemTools::FileIsFullPath(file) &&
+          file.find('/') == std::string::npos) {
+        // Probably a module.  The CMAKE_MODULE_PATH is not known here,
+        // so guess the location of modules shipped with CMake.
+        this->Prefetch(this->CMakeRoot + "/Modules/" + file + ".cmake",
+                       sourceDir);
+      }
+      this->Prefetch(cmSystemTools::CollapseFullPath(file, sourceDir),
+                     sourceDir);
+    }
+  }
+}
+
+bool cmListFilePrefetcher::Take(std::string const& path, cmListFile& listFile,
+                                std::string* content)
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  std::map<std::string, Entry>::iterator i = this->Entries.find(path);
+  if (i == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+  Entry const& entry = i->second;
+  this->EntryDone.wait(lock, [&entry] { return entry.Done; });
+  lock.unlock();
+
+  // The entry is no longer modified once done.  Make sure the file
+  // was not written since the worker read it.
+  std::string current;
+  if (!entry.Parsed || !cmListFilePrefetcher::ReadContent(path, current) ||
+      current != entry.Content) {
+    ++this->Misses;
+    return false;
+  }
+  listFile = entry.ListFile;
+  if (content) {
+    content->swap(current);
+  }
+  ++this->Hits;
+  return true;
+}
+
+void cmListFilePrefetcher::Prefetch(std::string const& path,
+                                    std::string const& sourceDir)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Stopping || !this->Entries.emplace(path, Entry()).second) {
+      return;
+    }
+  }
+  this->Pool.PushJob(
+    [this, path, sourceDir]() { this->Parse(path, sourceDir); });
+}
+
+void cmListFilePrefetcher::Parse(std::string const& path,
+                                 std::string const& sourceDir)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Stopping) {
+      return;
+    }
+  }
+
+  std::string content;
+  cmListFile listFile;
+  bool parsed = false;
+  if (!cmSystemTools::FileIsDirectory(path) &&
+      cmListFilePrefetcher::ReadContent(path, content)) {
+    std::string text;
+    if (cmListFile::PrepareContent(content, text)) {
+      parsed = listFile.ParseString(text.c_str(), path.c_str(), nullptr,
+                                    cmListFileBacktrace());
+    }
+  }
+
+  if (parsed) {
+    this->PrefetchReferencedFiles(listFile, path, sourceDir);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    Entry& entry = this->Entries[path];
+    entry.Parsed = parsed;
+    entry.Content = std::move(content);
+    entry.ListFile = std::move(listFile);
+    entry.Done = true;
+  }
+  this->EntryDone.notify_all();
+}
+
+std::string cmListFilePrefetcher::ResolveArgument(
+  cmListFileArgument const& arg, std::string const& listDir,
+  std::string const& sourceDir) const
+{
+  std::string value = arg.Value;
+  if (arg.Delim != cmListFileArgument::Bracket) {
+    cmSystemTools::ReplaceString(value, "${CMAKE_CURRENT_LIST_DIR}",
+                                 listDir.c_str());
+    cmSystemTools::ReplaceString(value, "${CMAKE_CURRENT_SOURCE_DIR}",
+                                 sourceDir.c_str());
+    // Anything else needs the configure step to evaluate.
+    if (value.find_first_of("$@\\;") != std::string::npos) {
+      return std::string();
+    }
+  }
+  return value;
+}
+
+bool cmListFilePrefetcher::ReadContent(std::string const& path,
+                                       std::string& content)
+{
+  cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  content.assign(std::istreambuf_iterator<char>(fin),
+                 std::istreambuf_iterator<char>());
+  return !fin.bad();
+}
@@ -0,0 +1,82 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmListFilePrefetcher_h
+#define cmListFilePrefetcher_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmListFileCache.h"
+#include "cmWorkerPool.h"
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+
+/** \class cmListFilePrefetcher
+ * \brief Parse listfiles on worker threads ahead of the configure step.
+ *
+ * Once a listfile has been parsed, the add_subdirectory() and include()
+ * calls in it whose arguments can be resolved without evaluating the
+ * code are followed, and the files they name are parsed on the worker
+ * pool too.  The serial configure walk asks for the parsed content with
+ * Take().  Each hit is validated against the current content of the file,
+ * so files written during configure are never served stale.
+ */
+class cmListFilePrefetcher
+{
+public:
+  cmListFilePrefetcher(unsigned int threadCount, std::string cmakeRoot);
+  ~cmListFilePrefetcher();
+
+  CM_DISABLE_COPY(cmListFilePrefetcher)
+
+  /** Queue the files referenced by a listfile parsed on the main thread.
+      The \a sourceDir is the directory in which the listfile executes.  */
+  void PrefetchReferencedFiles(cmListFile const& listFile,
+                               std::string const& listFileName,
+                               std::string const& sourceDir);
+
+  /** Get the parsed content of the file \a path if it was prefetched and
+      still matches the file on disk.  Waits for a pending parse.
+      Optionally provide the raw content of the file.  */
+  bool Take(std::string const& path, cmListFile& listFile,
+            std::string* content = nullptr);
+
+  unsigned int GetThreadCount() const { return this->Pool.GetThreadCount(); }
+  unsigned long GetHitCount() const { return this->Hits; }
+  unsigned long GetMissCount() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    Entry()
+      : Done(false)
+      , Parsed(false)
+    {
+    }
+    bool Done;
+    bool Parsed;
+    std::string Content;
+    cmListFile ListFile;
+  };
+
+  void Prefetch(std::string const& path, std::string const& sourceDir);
+  void Parse(std::string const& path, std::string const& sourceDir);
+  std::string ResolveArgument(cmListFileArgument const& arg,
+                              std::string const& listDir,
+                              std::string const& sourceDir) const;
+  static bool ReadContent(std::string const& path, std::string& content);
+
+  std::string CMakeRoot;
+  std::mutex Mutex;
+  std::condition_variable EntryDone;
+  std::map<std::string, Entry> Entries;
+  unsigned long Hits;
+  unsigned long Misses;
+  bool Stopping;
+  // Declared last so that the threads stop before the entries go away.
+  cmWorkerPool Pool;
+};
+
+#endif
@@ -60,11 +60,6 @@ void cmLocalNinjaGenerator::Generate()
     this->HomeRelativeOutputPath.clear();
   }
 
-  this->WriteProcessedMakefile(this->GetBuildFileStream());
-#ifdef NINJA_GEN_VERBOSE_FILES
-  this->WriteProcessedMakefile(this->GetRulesFileStream());
-#endif
-
   // We do that only once for the top CMakeLists.txt file.
   if (this->IsRootMakefile()) {
     this->WriteBuildFileTop();
@@ -81,6 +76,14 @@ void cmLocalNinjaGenerator::Generate()
     }
   }
 
+  // The build statements of each directory go to a file of its own.
+  this->GetGlobalNinjaGenerator()->OpenDirectoryBuildFileStream(this);
+
+  this->WriteProcessedMakefile(this->GetBuildFileStream());
+#ifdef NINJA_GEN_VERBOSE_FILES
+  this->WriteProcessedMakefile(this->GetRulesFileStream());
+#endif
+
   const std::vector<cmGeneratorTarget*>& targets = this->GetGeneratorTargets();
   for (cmGeneratorTarget* target : targets) {
     if (target->GetType() == cmStateEnums::INTERFACE_LIBRARY) {
@@ -100,6 +103,8 @@ void cmLocalNinjaGenerator::Generate()
   }
 
   this->WriteCustomCommandBuildStatements();
+
+  this->GetGlobalNinjaGenerator()->CloseDirectoryBuildFileStream();
 }
 
 // TODO: Picked up from cmLocalUnixMakefileGenerator3.  Refactor it.
@@ -12,6 +12,11 @@
 #include "cmPolicies.h"
 #include "cmState.h"
 #include "cmSystemTools.h"
+#include "cmake.h"
+
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+#  include "cmMakefileProfilingData.h"
+#endif
 
 // define the class for macro commands
 class cmMacroHelperCommand : public cmCommand
@@ -58,6 +63,13 @@ public:
 bool cmMacroHelperCommand::InvokeInitialPass(
   const std::vector<cmListFileArgument>& args, cmExecutionStatus& inStatus)
 {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  if (cmMakefileProfilingData* profiling =
+        this->Makefile->GetCMakeInstance()->GetProfilingOutput()) {
+    profiling->SetEntryCategory("macro");
+  }
+#endif
+
   // Expand the argument list to the macro.
   std::vector<std::string> expandedArgs;
   this->Makefile->ExpandArguments(args, expandedArgs);
@@ -2,6 +2,8 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmMakeDirectoryCommand.h"
 
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 
@@ -22,6 +24,8 @@ bool cmMakeDirectoryCommand::InitialPass(std::vector<std::string> const& args,
     cmSystemTools::SetFatalErrorOccured();
     return false;
   }
+  this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache().Invalidate(
+    args[0]);
   cmSystemTools::MakeDirectory(args[0]);
   return true;
 }
@@ -20,6 +20,7 @@
 #include "cmCommandArgumentParserHelper.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandLines.h"
+#include "cmDirectoryListingCache.h"
 #include "cmExecutionStatus.h"
 #include "cmExpandedCommandArgument.h" // IWYU pragma: keep
 #include "cmFileLockPool.h"
@@ -45,6 +46,9 @@
 #include "cmake.h"
 
 #ifdef CMAKE_BUILD_WITH_CMAKE
+#  include "cmListFileDiskCache.h"
+#  include "cmListFilePrefetcher.h"
+#  include "cmMakefileProfilingData.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -360,6 +364,13 @@ bool cmMakefile::ExecuteCommand(const cmListFileFunction& lff,
   cmMakefileCall stack_manager(this, lff, status);
   static_cast<void>(stack_manager);
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  // Record the call if profiling is enabled.
+  cmMakefileProfilingData::RAII profilingScope(
+    this->GetCMakeInstance()->GetProfilingOutput(), lff, this->Backtrace);
+  static_cast<void>(profilingScope);
+#endif
+
   // Lookup the command prototype.
   if (cmCommand* proto =
         this->GetState()->GetCommandByExactName(lff.Name.Lower)) {
@@ -542,8 +553,7 @@ bool cmMakefile::ReadDependentFile(const char* filename, bool noPolicyScope)
   IncludeScope incScope(this, filenametoread, noPolicyScope);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -593,8 +603,7 @@ bool cmMakefile::ReadListFile(const char* filename)
   ListFileScope scope(this, filenametoread);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -605,6 +614,46 @@ bool cmMakefile::ReadListFile(const char* filename)
   return true;
 }
 
+bool cmMakefile::ParseListFile(cmListFile& listFile,
+                               std::string const& filenametoread)
+{
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+  cmListFilePrefetcher* prefetcher =
+    this->GlobalGenerator->GetListFilePrefetcher();
+  cmListFileDiskCache* diskCache =
+    this->GlobalGenerator->GetListFileDiskCache();
+  if (prefetcher) {
+    std::string content;
+    if (prefetcher->Take(filenametoread, listFile,
+                         diskCache ? &content : nullptr)) {
+      if (diskCache) {
+        diskCache->Store(filenametoread, content, listFile);
+      }
+      return true;
+    }
+  }
+  if (diskCache) {
+    if (!diskCache->ParseFile(filenametoread, listFile, this->GetMessenger(),
+                              this->Backtrace)) {
+      return false;
+    }
+  } else if (!listFile.ParseFile(filenametoread.c_str(),
+                                 this->GetMessenger(), this->Backtrace)) {
+    return false;
+  }
+  if (prefetcher) {
+    prefetcher->PrefetchReferencedFiles(listFile, filenametoread,
+                                        this->GetCurrentSourceDirectory());
+  }
+#else
+  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
+                          this->Backtrace)) {
+    return false;
+  }
+#endif
+  return true;
+}
+
 void cmMakefile::ReadListFile(cmListFile const& listFile,
                               std::string const& filenametoread)
 {
@@ -1453,10 +1502,13 @@ public:
 #if defined(CMAKE_BUILD_WITH_CMAKE)
     this->GG->GetFileLockPool().PushFileScope();
 #endif
+    this->GG->BeginDirectoryConfigure();
   }
 
   ~BuildsystemFileScope()
   {
+    this->GG->EndDirectoryConfigure(
+      this->Makefile->GetCurrentSourceDirectory());
     this->Makefile->PopFunctionBlockerBarrier(this->ReportError);
     this->Makefile->PopSnapshot(this->ReportError);
 #if defined(CMAKE_BUILD_WITH_CMAKE)
@@ -1498,8 +1550,7 @@ void cmMakefile::Configure()
   this->AddDefinition("CMAKE_PARENT_LIST_FILE", currentStart.c_str());
 
   cmListFile listFile;
-  if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, currentStart)) {
     return;
   }
   if (this->IsRootMakefile()) {
@@ -2689,32 +2740,85 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringOld(
   return mtype;
 }
 
-typedef enum
-{
-  NORMAL,
-  ENVIRONMENT,
-  CACHE
-} t_domain;
 struct t_lookup
 {
   t_lookup()
-    : domain(NORMAL)
+    : domain(cmListFileArgumentExpansion::Normal)
     , loc(0)
   {
   }
-  t_domain domain;
+  cmListFileArgumentExpansion::Domain domain;
   size_t loc;
 };
 
+void cmMakefile::EvaluateVariableReference(
+  cmListFileArgumentExpansion::Domain domain, std::string const& lookup,
+  bool escapeQuotes, const char* filename, long line, bool removeEmpty,
+  std::string& varresult) const
+{
+  const char* value = nullptr;
+  std::string svalue;
+  static const std::string lineVar = "CMAKE_CURRENT_LIST_LINE";
+  switch (domain) {
+    case cmListFileArgumentExpansion::Normal:
+      if (filename && lookup == lineVar) {
+        std::ostringstream ostr;
+        ostr << line;
+        varresult = ostr.str();
+      } else {
+        value = this->GetDefinition(lookup);
+      }
+      break;
+    case cmListFileArgumentExpansion::Environment:
+      if (cmSystemTools::GetEnv(lookup, svalue)) {
+        value = svalue.c_str();
+      }
+      break;
+    case cmListFileArgumentExpansion::Cache:
+      value = this->GetCMakeInstance()->GetState()->GetCacheEntryValue(lookup);
+      break;
+  }
+  // Get the string we're meant to append to.
+  if (value) {
+    if (escapeQuotes) {
+      varresult = cmSystemTools::EscapeQuotes(value);
+    } else {
+      varresult = value;
+    }
+  } else if (!removeEmpty) {
+    // check to see if we need to print a warning
+    // if strict mode is on and the variable has
+    // not been "cleared"/initialized with a set(foo ) call
+    if (this->GetCMakeInstance()->GetWarnUninitialized() &&
+        !this->VariableInitialized(lookup)) {
+      if (this->CheckSystemVars ||
+          (filename &&
+           (cmSystemTools::IsSubDirectory(filename,
+                                          this->GetHomeDirectory()) ||
+            cmSystemTools::IsSubDirectory(filename,
+                                          this->GetHomeOutputDirectory())))) {
+        std::ostringstream msg;
+        msg << "uninitialized variable \'" << lookup << "\'";
+        this->IssueMessage(cmake::AUTHOR_WARNING, msg.str());
+      }
+    }
+  }
+}
+
 cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
   std::string& errorstr, std::string& source, bool escapeQuotes,
   bool noEscapes, bool atOnly, const char* filename, long line,
-  bool removeEmpty, bool replaceAt) const
+  bool removeEmpty, bool replaceAt,
+  cmListFileArgumentExpansion* expansion) const
 {
   // This method replaces ${VAR} and @VAR@ where VAR is looked up
   // with GetDefinition(), if not found in the map, nothing is expanded.
   // It also supports the $ENV{VAR} syntax where VAR is looked up in
-  // the current environment variables.
+  // the current environment variables.  If an expansion is given the
+  // literal text and references are recorded in it for a later replay.
+  // This is supported only without escaped quotes and @VAR@ handling.
+  assert(!expansion || (!escapeQuotes && !noEscapes && !removeEmpty &&
+                        !atOnly && !replaceAt));
 
   const char* in = source.c_str();
   const char* last = in;
@@ -2724,8 +2828,17 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
   bool error = false;
   bool done = false;
   cmake::MessageType mtype = cmake::LOG;
-
-  cmState* state = this->GetCMakeInstance()->GetState();
+  long const firstLine = line;
+  // The end of the part of the result recorded in the expansion.
+  std::string::size_type recorded = 0;
+  auto recordLiteral = [&]() {
+    if (recorded < result.size()) {
+      expansion->Ops.emplace_back(cmListFileArgumentExpansion::Literal,
+                                  cmListFileArgumentExpansion::Normal,
+                                  result.substr(recorded), 0);
+      recorded = result.size();
+    }
+  };
 
   do {
     char inc = *in;
@@ -2735,56 +2848,19 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
           t_lookup var = openstack.back();
           openstack.pop_back();
           result.append(last, in - last);
+          if (expansion) {
+            recordLiteral();
+            expansion->Ops.emplace_back(cmListFileArgumentExpansion::Close,
+                                        var.domain, std::string(),
+                                        line - firstLine);
+          }
           std::string const& lookup = result.substr(var.loc);
-          const char* value = nullptr;
           std::string varresult;
-          std::string svalue;
-          static const std::string lineVar = "CMAKE_CURRENT_LIST_LINE";
-          switch (var.domain) {
-            case NORMAL:
-              if (filename && lookup == lineVar) {
-                std::ostringstream ostr;
-                ostr << line;
-                varresult = ostr.str();
-              } else {
-                value = this->GetDefinition(lookup);
-              }
-              break;
-            case ENVIRONMENT:
-              if (cmSystemTools::GetEnv(lookup, svalue)) {
-                value = svalue.c_str();
-              }
-              break;
-            case CACHE:
-              value = state->GetCacheEntryValue(lookup);
-              break;
-          }
-          // Get the string we're meant to append to.
-          if (value) {
-            if (escapeQuotes) {
-              varresult = cmSystemTools::EscapeQuotes(value);
-            } else {
-              varresult = value;
-            }
-          } else if (!removeEmpty) {
-            // check to see if we need to print a warning
-            // if strict mode is on and the variable has
-            // not been "cleared"/initialized with a set(foo ) call
-            if (this->GetCMakeInstance()->GetWarnUninitialized() &&
-                !this->VariableInitialized(lookup)) {
-              if (this->CheckSystemVars ||
-                  (filename &&
-                   (cmSystemTools::IsSubDirectory(filename,
-                                                  this->GetHomeDirectory()) ||
-                    cmSystemTools::IsSubDirectory(
-                      filename, this->GetHomeOutputDirectory())))) {
-                std::ostringstream msg;
-                msg << "uninitialized variable \'" << lookup << "\'";
-                this->IssueMessage(cmake::AUTHOR_WARNING, msg.str());
-              }
-            }
-          }
+          this->EvaluateVariableReference(var.domain, lookup, escapeQuotes,
+                                          filename, line, removeEmpty,
+                                          varresult);
           result.replace(var.loc, result.size() - var.loc, varresult);
+          recorded = result.size();
           // Start looking from here on out.
           last = in + 1;
         }
@@ -2798,7 +2874,7 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
           if (nextc == '{') {
             // Looking for a variable.
             start = in + 2;
-            lookup.domain = NORMAL;
+            lookup.domain = cmListFileArgumentExpansion::Normal;
           } else if (nextc == '<') {
           } else if (!nextc) {
             result.append(last, next - last);
@@ -2806,11 +2882,11 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
           } else if (cmHasLiteralPrefix(next, "ENV{")) {
             // Looking for an environment variable.
             start = in + 5;
-            lookup.domain = ENVIRONMENT;
+            lookup.domain = cmListFileArgumentExpansion::Environment;
           } else if (cmHasLiteralPrefix(next, "CACHE{")) {
             // Looking for a cache variable.
             start = in + 7;
-            lookup.domain = CACHE;
+            lookup.domain = cmListFileArgumentExpansion::Cache;
           } else {
             if (this->cmNamedCurly.find(next)) {
               errorstr = "Syntax $" +
@@ -2827,6 +2903,11 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
             in = start - 1;
             lookup.loc = result.size();
             openstack.push_back(lookup);
+            if (expansion) {
+              recordLiteral();
+              expansion->Ops.emplace_back(cmListFileArgumentExpansion::Open,
+                                          lookup.domain, std::string(), 0);
+            }
           }
           break;
         }
@@ -2949,6 +3030,9 @@ cmake::MessageType cmMakefile::ExpandVariablesInStringNew(
   } else {
     // Append the rest of the unchanged part of the string.
     result.append(last);
+    if (expansion) {
+      recordLiteral();
+    }
 
     source = result;
   }
@@ -3084,6 +3168,77 @@ std::string cmMakefile::GetExecutionFilePath() const
   return this->StateSnapshot.GetExecutionListFile();
 }
 
+void cmMakefile::ExpandArgument(cmListFileArgument const& arg,
+                                const char* filename, std::string& value) const
+{
+  switch (this->GetPolicyStatus(cmPolicies::CMP0053)) {
+    case cmPolicies::WARN:
+    case cmPolicies::OLD:
+      value = arg.Value;
+      this->ExpandVariablesInString(value, false, false, false, filename,
+                                    arg.Line, false, false);
+      return;
+    case cmPolicies::REQUIRED_IF_USED:
+    case cmPolicies::REQUIRED_ALWAYS:
+    case cmPolicies::NEW:
+      break;
+  }
+
+  cmListFileArgumentExpansion* expansion = arg.Expansion.get();
+  if (!expansion || !expansion->Recorded) {
+    value = arg.Value;
+    if (!expansion && value.find_first_of("$\\") == std::string::npos) {
+      // Nothing to expand.
+      return;
+    }
+    // Expand the argument while recording its references if possible.
+    // Record into a local object since variable watches may expand the
+    // same argument again.  Arguments with syntax errors are diagnosed
+    // every time.
+    std::string errorstr;
+    cmListFileArgumentExpansion recording;
+    cmake::MessageType mtype = this->ExpandVariablesInStringNew(
+      errorstr, value, false, false, false, filename, arg.Line, false, false,
+      expansion ? &recording : nullptr);
+    if (mtype != cmake::LOG) {
+      if (mtype == cmake::FATAL_ERROR) {
+        cmSystemTools::SetFatalErrorOccured();
+      }
+      this->IssueMessage(mtype, errorstr);
+    } else if (expansion && !expansion->Recorded) {
+      expansion->Ops = std::move(recording.Ops);
+      expansion->Recorded = true;
+    }
+    return;
+  }
+
+  // Replay the recorded expansion.
+  value.clear();
+  std::vector<t_lookup> openstack;
+  for (cmListFileArgumentExpansion::Op const& op : expansion->Ops) {
+    switch (op.Code) {
+      case cmListFileArgumentExpansion::Literal:
+        value += op.Text;
+        break;
+      case cmListFileArgumentExpansion::Open: {
+        t_lookup lookup;
+        lookup.domain = op.RefDomain;
+        lookup.loc = value.size();
+        openstack.push_back(lookup);
+      } break;
+      case cmListFileArgumentExpansion::Close: {
+        t_lookup const var = openstack.back();
+        openstack.pop_back();
+        std::string varresult;
+        this->EvaluateVariableReference(var.domain, value.substr(var.loc),
+                                        false, filename, arg.Line + op.Line,
+                                        false, varresult);
+        value.replace(var.loc, value.size() - var.loc, varresult);
+      } break;
+    }
+  }
+}
+
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs,
                                  const char* filename) const
@@ -3101,9 +3256,7 @@ bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename, i.Line,
-                                  false, false);
+    this->ExpandArgument(i, filename, value);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -3133,9 +3286,7 @@ bool cmMakefile::ExpandArguments(
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename, i.Line,
-                                  false, false);
+    this->ExpandArgument(i, filename, value);
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -3337,8 +3488,27 @@ int cmMakefile::TryCompile(const std::string& srcdir,
                            const std::string& targetName, bool fast, int jobs,
                            const std::vector<std::string>* cmakeArgs,
                            std::string& output)
+{
+  if (this->GenerateTryCompile(srcdir, bindir, fast, cmakeArgs) != 0) {
+    return 1;
+  }
+
+  // finally call the generator to actually build the resulting project
+  this->IsSourceFileTryCompile = fast;
+  int ret = this->GetGlobalGenerator()->TryCompile(
+    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
+
+  this->IsSourceFileTryCompile = false;
+  return ret;
+}
+
+int cmMakefile::GenerateTryCompile(const std::string& srcdir,
+                                   const std::string& bindir, bool fast,
+                                   const std::vector<std::string>* cmakeArgs)
 {
   this->IsSourceFileTryCompile = fast;
+  // The test project may write files outside its binary directory.
+  this->GetGlobalGenerator()->GetDirectoryListingCache().Clear();
   // does the binary directory exist ? If not create it...
   if (!cmSystemTools::FileIsDirectory(bindir)) {
     cmSystemTools::MakeDirectory(bindir);
@@ -3445,12 +3615,8 @@ int cmMakefile::TryCompile(const std::string& srcdir,
     return 1;
   }
 
-  // finally call the generator to actually build the resulting project
-  int ret = this->GetGlobalGenerator()->TryCompile(
-    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
-
   this->IsSourceFileTryCompile = false;
-  return ret;
+  return 0;
 }
 
 bool cmMakefile::GetIsSourceFileTryCompile() const
@@ -3670,6 +3836,7 @@ int cmMakefile::ConfigureFile(const char* infile, const char* outfile,
   // when we finalize the configuration we will remove all
   // output files that now don't exist.
   this->AddCMakeOutputFile(soutfile);
+  this->GetGlobalGenerator()->GetDirectoryListingCache().Invalidate(soutfile);
 
   mode_t perm = 0;
   cmSystemTools::GetPermissions(sinfile, perm);
@@ -116,6 +116,13 @@ public:
                  const std::vector<std::string>* cmakeArgs,
                  std::string& output);
 
+  /**
+   * Configure and generate the test project of TryCompile without
+   * building it.  Returns zero on success.
+   */
+  int GenerateTryCompile(const std::string& srcdir, const std::string& bindir,
+                         bool fast, const std::vector<std::string>* cmakeArgs);
+
   bool GetIsSourceFileTryCompile() const;
 
   /**
@@ -922,6 +929,8 @@ private:
   cmStateSnapshot StateSnapshot;
   cmListFileBacktrace Backtrace;
 
+  bool ParseListFile(cmListFile& listFile,
+                     std::string const& filenametoread);
   void ReadListFile(cmListFile const& listFile,
                     const std::string& filenametoread);
 
@@ -981,7 +990,18 @@ private:
   cmake::MessageType ExpandVariablesInStringNew(
     std::string& errorstr, std::string& source, bool escapeQuotes,
     bool noEscapes, bool atOnly, const char* filename, long line,
-    bool removeEmpty, bool replaceAt) const;
+    bool removeEmpty, bool replaceAt,
+    cmListFileArgumentExpansion* expansion = nullptr) const;
+  // Evaluate a ${}, $ENV{} or $CACHE{} reference for the methods above.
+  void EvaluateVariableReference(cmListFileArgumentExpansion::Domain domain,
+                                 std::string const& lookup,
+                                 bool escapeQuotes, const char* filename,
+                                 long line, bool removeEmpty,
+                                 std::string& varresult) const;
+  // Expand a command argument for ExpandArguments.  With CMP0053 NEW
+  // the expansion is recorded in the argument and replayed later.
+  void ExpandArgument(cmListFileArgument const& arg, const char* filename,
+                      std::string& value) const;
   /**
    * Old version of GetSourceFileWithOutput(const std::string&) kept for
    * backward-compatibility. It implements a linear search and support
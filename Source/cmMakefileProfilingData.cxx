@@ -0,0 +1,124 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmMakefileProfilingData.h"
+
+#include "cmAlgorithms.h"
+#include "cmListFileCache.h"
+
+#include "cm_jsoncpp_writer.h"
+#include "cm_uv.h"
+
+#include <sstream>
+#include <utility>
+
+cmMakefileProfilingData::cmMakefileProfilingData(
+  std::string const& profileFile)
+  : ProfileStream(profileFile.c_str())
+  , Origin(Clock::now())
+  , FirstEvent(true)
+{
+  if (this->ProfileStream) {
+    this->ProfileStream << "[";
+  }
+}
+
+cmMakefileProfilingData::~cmMakefileProfilingData()
+{
+  // Close entries left running, e.g. by a fatal error.
+  while (!this->Running.empty()) {
+    this->StopEntry();
+  }
+  if (this->ProfileStream) {
+    this->ProfileStream << "]\n";
+  }
+}
+
+bool cmMakefileProfilingData::IsOpen() const
+{
+  return static_cast<bool>(this->ProfileStream);
+}
+
+void cmMakefileProfilingData::StartEntry(cmListFileFunction const& lff,
+                                         cmListFileBacktrace const& backtrace)
+{
+  this->Running.emplace_back();
+  Entry& entry = this->Running.back();
+  Json::Value& event = entry.Event;
+  event["name"] = lff.Name.Original;
+  if (lff.Name.Lower == "include") {
+    event["cat"] = "include";
+  } else if (cmHasLiteralPrefix(lff.Name.Lower, "find_")) {
+    event["cat"] = "find";
+  } else {
+    event["cat"] = "command";
+  }
+  event["ph"] = "X";
+  event["pid"] = static_cast<Json::Value::Int>(uv_os_getpid());
+  event["tid"] = 0;
+
+  Json::Value& args = event["args"];
+  std::string functionArgs;
+  const char* sep = "";
+  for (cmListFileArgument const& arg : lff.Arguments) {
+    functionArgs += sep;
+    functionArgs += arg.Value;
+    sep = " ";
+  }
+  args["functionArgs"] = functionArgs;
+
+  // The top of the backtrace is this call.
+  Json::Value& frames = args["backtrace"] = Json::arrayValue;
+  for (cmListFileBacktrace bt = backtrace; !bt.Empty(); bt = bt.Pop()) {
+    std::ostringstream frame;
+    frame << bt.Top();
+    frames.append(frame.str());
+  }
+  if (!backtrace.Empty()) {
+    cmListFileContext const& top = backtrace.Top();
+    std::ostringstream location;
+    location << top.FilePath << ":" << top.Line;
+    args["location"] = location.str();
+  }
+
+  // Take the time last to leave out the work above.
+  entry.Start = Clock::now();
+}
+
+void cmMakefileProfilingData::SetEntryCategory(const char* category)
+{
+  if (!this->Running.empty()) {
+    this->Running.back().Event["cat"] = category;
+  }
+}
+
+void cmMakefileProfilingData::StopEntry()
+{
+  Clock::time_point const stop = Clock::now();
+  if (this->Running.empty()) {
+    return;
+  }
+  Entry entry = std::move(this->Running.back());
+  this->Running.pop_back();
+  if (!this->ProfileStream) {
+    return;
+  }
+
+  long long const start = this->Microseconds(entry.Start);
+  entry.Event["ts"] = static_cast<Json::Value::Int64>(start);
+  entry.Event["dur"] =
+    static_cast<Json::Value::Int64>(this->Microseconds(stop) - start);
+
+  Json::FastWriter writer;
+  if (!this->FirstEvent) {
+    this->ProfileStream << ",";
+  }
+  this->ProfileStream << writer.write(entry.Event);
+  this->FirstEvent = false;
+}
+
+long long cmMakefileProfilingData::Microseconds(Clock::time_point t) const
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(t -
+                                                                this->Origin)
+    .count();
+}
@@ -0,0 +1,88 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmMakefileProfilingData_h
+#define cmMakefileProfilingData_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cm_jsoncpp_value.h"
+#include "cmsys/FStream.hxx"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class cmListFileBacktrace;
+struct cmListFileFunction;
+
+/** \class cmMakefileProfilingData
+ * \brief Record the time spent in commands in Chrome trace-event format.
+ *
+ * Each command invocation becomes a complete ("X") event that carries
+ * the arguments of the call and its backtrace.  The resulting file can
+ * be loaded into chrome://tracing or any other viewer of the format.
+ */
+class cmMakefileProfilingData
+{
+public:
+  cmMakefileProfilingData(std::string const& profileFile);
+  ~cmMakefileProfilingData();
+
+  CM_DISABLE_COPY(cmMakefileProfilingData)
+
+  /** Whether the output file could be opened.  */
+  bool IsOpen() const;
+
+  void StartEntry(cmListFileFunction const& lff,
+                  cmListFileBacktrace const& backtrace);
+
+  /** Set the category of the innermost running entry, e.g. to tell
+      calls of functions and macros from builtin commands.  */
+  void SetEntryCategory(const char* category);
+
+  void StopEntry();
+
+  /** Record an entry for the lifetime of an instance.  Does nothing
+      if profiling is not enabled, i.e. the data is null.  */
+  class RAII
+  {
+  public:
+    RAII(cmMakefileProfilingData* data, cmListFileFunction const& lff,
+         cmListFileBacktrace const& backtrace)
+      : Data(data)
+    {
+      if (this->Data) {
+        this->Data->StartEntry(lff, backtrace);
+      }
+    }
+    ~RAII()
+    {
+      if (this->Data) {
+        this->Data->StopEntry();
+      }
+    }
+
+    CM_DISABLE_COPY(RAII)
+
+  private:
+    cmMakefileProfilingData* Data;
+  };
+
+private:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Entry
+  {
+    Clock::time_point Start;
+    Json::Value Event;
+  };
+
+  long long Microseconds(Clock::time_point t) const;
+
+  cmsys::ofstream ProfileStream;
+  Clock::time_point Origin;
+  std::vector<Entry> Running;
+  bool FirstEvent;
+};
+
+#endif
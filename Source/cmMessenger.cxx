@@ -133,6 +133,7 @@ void displayMessage(cmake::MessageType t, std::ostringstream& msg)
 
 cmMessenger::cmMessenger(cmState* state)
   : State(state)
+  , IssuedMessageCount(0)
 {
 }
 
@@ -152,6 +153,7 @@ void cmMessenger::IssueMessage(cmake::MessageType t, const std::string& text,
   if (!force && !this->IsMessageTypeVisible(t)) {
     return;
   }
+  ++this->IssuedMessageCount;
   this->DisplayMessage(t, text, backtrace);
 }
 
@@ -29,11 +29,18 @@ public:
   bool GetDevWarningsAsErrors() const;
   bool GetDeprecatedWarningsAsErrors() const;
 
+  /** Number of messages issued and not suppressed so far.  */
+  unsigned long GetIssuedMessageCount() const
+  {
+    return this->IssuedMessageCount;
+  }
+
 private:
   bool IsMessageTypeVisible(cmake::MessageType t) const;
   cmake::MessageType ConvertMessageType(cmake::MessageType t) const;
 
   cmState* State;
+  mutable unsigned long IssuedMessageCount;
 };
 
 #endif
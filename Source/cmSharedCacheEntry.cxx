@@ -0,0 +1,93 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmSharedCacheEntry.h"
+
+#include "cmCryptoHash.h"
+#include "cmSystemTools.h"
+#include "cmVersion.h"
+#include "cm_uv.h"
+
+#include "cmsys/FStream.hxx"
+#include <sstream>
+
+namespace {
+// Write the content, or a copy of a file, to a temporary file and
+// rename it over the given file.
+bool ReplaceFile(std::string const& file, std::string const& content,
+                 std::string const& copyOf)
+{
+  std::ostringstream tmpName;
+  tmpName << file << "." << uv_os_getpid() << ".tmp";
+  std::string const tmpFile = tmpName.str();
+  bool written;
+  if (!copyOf.empty()) {
+    written = cmSystemTools::CopyFileAlways(copyOf, tmpFile);
+  } else {
+    cmsys::ofstream fout(tmpFile.c_str(), std::ios::out | std::ios::binary);
+    written = fout && static_cast<bool>(fout << content);
+  }
+  if (!written ||
+      !cmSystemTools::RenameFile(tmpFile.c_str(), file.c_str())) {
+    cmSystemTools::RemoveFile(tmpFile);
+    return false;
+  }
+  return true;
+}
+}
+
+cmSharedCacheEntry::cmSharedCacheEntry(std::string const& directory,
+                                       std::string const& magic,
+                                       std::vector<std::string> const& inputs)
+  : Directory(directory)
+  , Magic(magic)
+{
+  // The inputs may contain any character, including the file contents
+  // hashed with them, so precede each one by its size.
+  std::ostringstream key;
+  key << cmVersion::GetCMakeVersion() << '\n' << magic << '\n';
+  for (std::string const& i : inputs) {
+    key << i.size() << ':' << i;
+  }
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  this->EntryFile = this->Directory + "/" + hasher.HashString(key.str());
+}
+
+bool cmSharedCacheEntry::Read(std::string& content) const
+{
+  cmsys::ifstream fin(this->EntryFile.c_str(),
+                      std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(fin, line) || line != this->Magic) {
+    return false;
+  }
+  std::ostringstream out;
+  if (fin.peek() != std::char_traits<char>::eof() && !(out << fin.rdbuf())) {
+    return false;
+  }
+  content = out.str();
+  return true;
+}
+
+bool cmSharedCacheEntry::Write(std::string const& content) const
+{
+  cmSystemTools::MakeDirectory(this->Directory);
+  return ReplaceFile(this->EntryFile, this->Magic + "\n" + content,
+                       std::string());
+}
+
+bool cmSharedCacheEntry::WriteFile(std::string const& suffix,
+                                   std::string const& file) const
+{
+  cmSystemTools::MakeDirectory(this->Directory);
+  return ReplaceFile(this->EntryFile + suffix, std::string(), file);
+}
+
+bool cmSharedCacheEntry::ReadFile(std::string const& suffix,
+                                  std::string const& file) const
+{
+  cmSystemTools::MakeDirectory(cmSystemTools::GetFilenamePath(file));
+  return cmSystemTools::CopyFileAlways(this->EntryFile + suffix, file);
+}
@@ -0,0 +1,47 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmSharedCacheEntry_h
+#define cmSharedCacheEntry_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <vector>
+
+/** \class cmSharedCacheEntry
+ * \brief A file of a cache directory that many build trees may share.
+ *
+ * The file name is a hash of the version of CMake and of everything the
+ * content depends on, so an entry is never updated in place.  The first
+ * line of the file identifies the kind and format of its content.
+ * Files are written to a temporary name and renamed, so that concurrent
+ * runs never read a partial file.
+ */
+class cmSharedCacheEntry
+{
+public:
+  cmSharedCacheEntry(std::string const& directory, std::string const& magic,
+                     std::vector<std::string> const& inputs);
+
+  CM_DISABLE_COPY(cmSharedCacheEntry)
+
+  /** Read the content that follows the first line.  Fails if there is
+      no entry or if it is of another kind.  */
+  bool Read(std::string& content) const;
+
+  /** Write the entry with the given content.  */
+  bool Write(std::string const& content) const;
+
+  /** Copy \a file next to the entry, with the given suffix.  */
+  bool WriteFile(std::string const& suffix, std::string const& file) const;
+
+  /** Copy the file stored with the given suffix to \a file.  */
+  bool ReadFile(std::string const& suffix, std::string const& file) const;
+
+private:
+  std::string Directory;
+  std::string Magic;
+  std::string EntryFile;
+};
+
+#endif
@@ -33,6 +33,7 @@ cmState::cmState()
 {
   this->CacheManager = new cmCacheManager;
   this->GlobVerificationManager = new cmGlobVerificationManager;
+  cmDefinitions::AcquireKeyTable();
 }
 
 cmState::~cmState()
@@ -41,6 +42,7 @@ cmState::~cmState()
   delete this->GlobVerificationManager;
   cmDeleteAll(this->BuiltinCommands);
   cmDeleteAll(this->ScriptedCommands);
+  cmDefinitions::ReleaseKeyTable();
 }
 
 const char* cmState::GetTargetTypeName(cmStateEnums::TargetType targetType)
@@ -115,6 +117,11 @@ bool cmState::SaveCache(const std::string& path, cmMessenger* messenger)
   return this->CacheManager->SaveCache(path, messenger);
 }
 
+bool cmState::IsCacheLoadedFromMirror() const
+{
+  return this->CacheManager->IsLoadedFromMirror();
+}
+
 bool cmState::DeleteCache(const std::string& path)
 {
   return this->CacheManager->DeleteCache(path);
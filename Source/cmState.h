@@ -64,6 +64,8 @@ public:
 
   bool SaveCache(const std::string& path, cmMessenger* messenger);
 
+  bool IsCacheLoadedFromMirror() const;
+
   bool DeleteCache(const std::string& path);
 
   std::vector<std::string> GetCacheEntryKeys() const;
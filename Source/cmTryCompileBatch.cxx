@@ -0,0 +1,94 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTryCompileBatch.h"
+
+#include "cmSystemTools.h"
+#include "cmUVProcessPool.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+cmTryCompileBatch::Entry& cmTryCompileBatch::Queue(std::string const& key)
+{
+  ++this->QueuedCount;
+  Entry& entry = this->Entries[key];
+  if (!entry.Directory.empty()) {
+    this->Replaced.push_back(std::move(entry.Directory));
+  }
+  entry = Entry();
+  return entry;
+}
+
+bool cmTryCompileBatch::Take(std::string const& key, unsigned int jobs,
+                             Entry& entry)
+{
+  auto it = this->Entries.find(key);
+  if (it == this->Entries.end()) {
+    return false;
+  }
+  if (!it->second.Built) {
+    if (jobs == 0) {
+      jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    this->Build(jobs);
+  }
+  entry = std::move(it->second);
+  this->Entries.erase(it);
+  ++this->TakenCount;
+  return true;
+}
+
+void cmTryCompileBatch::Build(unsigned int jobs)
+{
+  std::vector<Entry*> pending;
+  for (auto& e : this->Entries) {
+    if (!e.second.Built) {
+      pending.push_back(&e.second);
+    }
+  }
+
+  // The output and error streams of a build are collected together, as
+  // they are for a build run by cmGlobalGenerator::Build.
+  cmUVProcessPool pool(
+    pending.size(),
+    [&pending](size_t index, size_t /*slot*/,
+               std::vector<std::string>& command, std::string& directory) {
+      command = pending[index]->BuildCommand;
+      directory = pending[index]->Directory;
+    },
+    [&pending](size_t index, size_t /*slot*/,
+               cmUVProcessPool::Result& result) {
+      Entry& entry = *pending[index];
+      entry.Built = true;
+      entry.Started = result.Started;
+      entry.RetVal = result.RetVal;
+      entry.Output = std::move(result.Output);
+      if (result.TermSignal != 0) {
+        entry.Output += "\nTerminated by signal ";
+        entry.Output += std::to_string(result.TermSignal);
+        entry.Output += "\n";
+      } else if (!result.Started) {
+        entry.Output += result.Errors;
+        entry.Output += "\n";
+      }
+    });
+  pool.SetMergeOutput(true);
+  pool.Run(jobs);
+}
+
+void cmTryCompileBatch::Clear(bool removeUntaken)
+{
+  if (removeUntaken) {
+    for (auto const& e : this->Entries) {
+      cmSystemTools::RemoveADirectory(e.second.Directory);
+    }
+    for (std::string const& dir : this->Replaced) {
+      cmSystemTools::RemoveADirectory(dir);
+    }
+  }
+  this->Entries.clear();
+  this->Replaced.clear();
+  this->QueuedCount = 0;
+  this->TakenCount = 0;
+}
@@ -0,0 +1,90 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileBatch_h
+#define cmTryCompileBatch_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <map>
+#include <string>
+#include <vector>
+
+/** \class cmTryCompileBatch
+ * \brief Build test projects queued by try_compile calls concurrently.
+ *
+ * A try_compile call made while a batch of checks is queued configures
+ * and generates its test project in a directory of its own, and queues
+ * the command to build it under a key computed from the content of the
+ * project.  When the checks are then run one at a time, the first call
+ * with the key of a queued project builds all projects not yet built,
+ * up to a given number at a time, and each call takes the result of
+ * its own project.
+ */
+class cmTryCompileBatch
+{
+public:
+  struct Entry
+  {
+    Entry()
+      : Built(false)
+      , Started(false)
+      , RetVal(1)
+    {
+    }
+    std::string Directory;
+    std::string TargetName;
+    std::vector<std::string> BuildCommand;
+    bool Built;
+    bool Started;
+    int RetVal;
+    std::string Output;
+  };
+
+  cmTryCompileBatch()
+    : QueuedCount(0)
+    , TakenCount(0)
+  {
+  }
+
+  CM_DISABLE_COPY(cmTryCompileBatch)
+
+  bool IsEmpty() const { return this->Entries.empty(); }
+
+  /** Number of projects queued since the batch was cleared, including
+      the projects already taken.  */
+  size_t GetQueuedCount() const { return this->QueuedCount; }
+
+  /** Number of projects taken since the batch was cleared.  */
+  size_t GetTakenCount() const { return this->TakenCount; }
+
+  /** Number of projects queued since the batch was cleared but not
+      taken, including the projects replaced by another one.  */
+  size_t GetUntakenCount() const
+  {
+    return this->Entries.size() + this->Replaced.size();
+  }
+
+  /** Queue a project, replacing one queued with the same key.  */
+  Entry& Queue(std::string const& key);
+
+  /** Remove the project queued with the given key and give it to the
+      caller.  All queued projects are built first if that one was not,
+      with at most \a jobs build tools running at a time.  A count of
+      zero selects the number of hardware threads.  Returns false if no
+      project was queued with the key.  */
+  bool Take(std::string const& key, unsigned int jobs, Entry& entry);
+
+  /** Forget all queued projects.  The directories of the projects not
+      taken are removed if \a removeUntaken is true.  */
+  void Clear(bool removeUntaken);
+
+private:
+  void Build(unsigned int jobs);
+
+  std::map<std::string, Entry> Entries;
+  std::vector<std::string> Replaced;
+  size_t QueuedCount;
+  size_t TakenCount;
+};
+
+#endif
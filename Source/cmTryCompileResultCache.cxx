@@ -0,0 +1,77 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmTryCompileResultCache.h"
+
+#include "cmSystemTools.h"
+
+#include <sstream>
+#include <stdlib.h>
+
+namespace {
+char const Magic[] = "CMakeTryCompileResultCache 2";
+char const OutputFileSuffix[] = ".bin";
+}
+
+cmTryCompileResultCache::cmTryCompileResultCache(
+  std::string const& directory, std::vector<std::string> const& inputs)
+  : File(directory, Magic, inputs)
+{
+}
+
+bool cmTryCompileResultCache::Load(Entry& entry) const
+{
+  std::string content;
+  if (!this->File.Read(content)) {
+    return false;
+  }
+  std::istringstream fin(content);
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(fin, line)) {
+    return false;
+  }
+  entry.Result = atoi(line.c_str());
+  if (!cmSystemTools::GetLineFromStream(fin, entry.OutputFile) ||
+      !cmSystemTools::GetLineFromStream(fin, line)) {
+    return false;
+  }
+
+  // The output may span many lines, so it is preceded by its size.  A
+  // size beyond the end of the entry means the entry is damaged.
+  unsigned long size;
+  std::streamoff const pos = fin.tellg();
+  if (!cmSystemTools::StringToULong(line.c_str(), &size) || pos < 0 ||
+      size > content.size() - static_cast<std::string::size_type>(pos)) {
+    return false;
+  }
+  entry.Output.assign(content, static_cast<std::string::size_type>(pos),
+                      size);
+  fin.seekg(pos + static_cast<std::streamoff>(size));
+  return cmSystemTools::GetLineFromStream(fin, line) && line == "end";
+}
+
+bool cmTryCompileResultCache::LoadOutputFile(
+  std::string const& outputFile) const
+{
+  // The copy of the file built is written before the entry, so it is
+  // missing only if it was removed from the cache since.
+  return this->File.ReadFile(OutputFileSuffix, outputFile);
+}
+
+bool cmTryCompileResultCache::Store(Entry const& entry,
+                                    std::string const& outputFile) const
+{
+  if (entry.OutputFile.find_first_of("\r\n") != std::string::npos) {
+    return false;
+  }
+  std::ostringstream out;
+  out << entry.Result << "\n"
+      << entry.OutputFile << "\n"
+      << entry.Output.size() << "\n"
+      << entry.Output << "end\n";
+
+  if (!entry.OutputFile.empty() &&
+      !this->File.WriteFile(OutputFileSuffix, outputFile)) {
+    return false;
+  }
+  return this->File.Write(out.str());
+}
@@ -0,0 +1,56 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmTryCompileResultCache_h
+#define cmTryCompileResultCache_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include "cmSharedCacheEntry.h"
+
+#include <string>
+#include <vector>
+
+/** \class cmTryCompileResultCache
+ * \brief Remember the results of try_compile test projects.
+ *
+ * An entry is stored in a cmSharedCacheEntry named by everything the
+ * build of the test project depends on, such as the content of its
+ * files and the identity of the compilers.  The entry holds the result
+ * and the output of the build, and the path of the file built in the
+ * project, whose copy is stored next to the entry.
+ */
+class cmTryCompileResultCache
+{
+public:
+  struct Entry
+  {
+    Entry()
+      : Result(1)
+    {
+    }
+    int Result;
+    std::string Output;
+    /** Path of the file built, relative to the project directory, or
+        empty if the build failed.  */
+    std::string OutputFile;
+  };
+
+  cmTryCompileResultCache(std::string const& directory,
+                          std::vector<std::string> const& inputs);
+
+  CM_DISABLE_COPY(cmTryCompileResultCache)
+
+  /** Read the entry.  */
+  bool Load(Entry& entry) const;
+
+  /** Copy the file built, as stored with the entry, to \a outputFile.  */
+  bool LoadOutputFile(std::string const& outputFile) const;
+
+  /** Write the entry with a copy of the file built at \a outputFile.  */
+  bool Store(Entry const& entry, std::string const& outputFile) const;
+
+private:
+  cmSharedCacheEntry File;
+};
+
+#endif
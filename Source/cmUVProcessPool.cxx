@@ -0,0 +1,226 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmUVProcessPool.h"
+
+#include "cmUVHandlePtr.h"
+#include "cmUVSignalHackRAII.h" // IWYU pragma: keep
+#include "cm_uv.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+class cmUVProcessPoolRunner
+{
+public:
+  cmUVProcessPoolRunner(size_t count,
+                        cmUVProcessPool::CommandCallback const& command,
+                        cmUVProcessPool::FinishCallback const& finish,
+                        bool mergeOutput)
+    : Count(count)
+    , Command(command)
+    , Finish(finish)
+    , MergeOutput(mergeOutput)
+    , Next(0)
+  {
+  }
+
+  CM_DISABLE_COPY(cmUVProcessPoolRunner)
+
+  void Run(size_t slots)
+  {
+#ifdef CMAKE_UV_SIGNAL_HACK
+    cmUVSignalHackRAII hackRAII;
+#endif
+    uv_loop_init(&this->Loop);
+    this->Slots.resize(slots);
+    for (size_t i = 0; i < slots; ++i) {
+      Slot& slot = this->Slots[i];
+      slot.Runner = this;
+      slot.Number = i;
+      slot.Out.Owner = &slot;
+      slot.Err.Owner = &slot;
+      this->StartNext(slot);
+    }
+    uv_run(&this->Loop, UV_RUN_DEFAULT);
+    this->Slots.clear();
+    // Let the loop close the handles released above.
+    uv_run(&this->Loop, UV_RUN_DEFAULT);
+    uv_loop_close(&this->Loop);
+  }
+
+private:
+  struct Slot;
+
+  struct Pipe
+  {
+    Slot* Owner;
+    cm::uv_pipe_ptr Handle;
+    std::string* Target;
+    std::vector<char> Buffer;
+  };
+
+  struct Slot
+  {
+    cmUVProcessPoolRunner* Runner;
+    size_t Number;
+    size_t Index;
+    cmUVProcessPool::Result Result;
+    cm::uv_process_ptr Process;
+    Pipe Out;
+    Pipe Err;
+    int Pending;
+  };
+
+  void StartNext(Slot& slot)
+  {
+    while (this->Next < this->Count) {
+      slot.Index = this->Next++;
+      slot.Result = cmUVProcessPool::Result();
+      if (this->Start(slot)) {
+        return;
+      }
+      this->Finish(slot.Index, slot.Number, slot.Result);
+    }
+  }
+
+  bool Start(Slot& slot)
+  {
+    std::vector<std::string> command;
+    std::string workingDirectory;
+    this->Command(slot.Index, slot.Number, command, workingDirectory);
+    if (command.empty()) {
+      return false;
+    }
+    std::vector<char const*> args;
+    for (std::string const& arg : command) {
+      args.push_back(arg.c_str());
+    }
+    args.push_back(nullptr);
+
+    slot.Out.Target = &slot.Result.Output;
+    slot.Err.Target =
+      this->MergeOutput ? &slot.Result.Output : &slot.Result.Errors;
+    slot.Out.Handle.init(this->Loop, 0, &slot.Out);
+    slot.Err.Handle.init(this->Loop, 0, &slot.Err);
+
+    uv_stdio_container_t stdio[3];
+    stdio[0].flags = UV_IGNORE;
+    stdio[1].flags =
+      static_cast<uv_stdio_flags>(UV_CREATE_PIPE | UV_WRITABLE_PIPE);
+    stdio[1].data.stream = slot.Out.Handle;
+    stdio[2].flags = stdio[1].flags;
+    stdio[2].data.stream = slot.Err.Handle;
+
+    uv_process_options_t options = uv_process_options_t();
+    options.file = args.front();
+    options.args = const_cast<char**>(args.data());
+    if (!workingDirectory.empty()) {
+      options.cwd = workingDirectory.c_str();
+    }
+    options.stdio_count = 3;
+    options.stdio = stdio;
+    options.exit_cb = &cmUVProcessPoolRunner::OnExitCB;
+
+    int status = slot.Process.spawn(this->Loop, options, &slot);
+    if (status == 0) {
+      status =
+        uv_read_start(slot.Out.Handle, &cmUVProcessPoolRunner::OnAllocateCB,
+                      &cmUVProcessPoolRunner::OnReadCB);
+    }
+    if (status == 0) {
+      status =
+        uv_read_start(slot.Err.Handle, &cmUVProcessPoolRunner::OnAllocateCB,
+                      &cmUVProcessPoolRunner::OnReadCB);
+    }
+    if (status != 0) {
+      slot.Result.Errors = uv_strerror(status);
+      slot.Process.reset();
+      slot.Out.Handle.reset();
+      slot.Err.Handle.reset();
+      return false;
+    }
+    slot.Result.Started = true;
+    slot.Pending = 3;
+    return true;
+  }
+
+  void Done(Slot& slot)
+  {
+    if (--slot.Pending > 0) {
+      return;
+    }
+    slot.Process.reset();
+    slot.Out.Handle.reset();
+    slot.Err.Handle.reset();
+    this->Finish(slot.Index, slot.Number, slot.Result);
+    this->StartNext(slot);
+  }
+
+  static void OnAllocateCB(uv_handle_t* handle, size_t suggested_size,
+                           uv_buf_t* buf)
+  {
+    Pipe* pipe = static_cast<Pipe*>(handle->data);
+    pipe->Buffer.resize(suggested_size);
+    *buf = uv_buf_init(pipe->Buffer.data(),
+                       static_cast<unsigned int>(pipe->Buffer.size()));
+  }
+
+  static void OnReadCB(uv_stream_t* stream, ssize_t nread, const uv_buf_t* buf)
+  {
+    Pipe* pipe = static_cast<Pipe*>(stream->data);
+    if (nread > 0) {
+      pipe->Target->append(buf->base, static_cast<size_t>(nread));
+    } else if (nread < 0) {
+      // The process will provide no more data.
+      uv_read_stop(stream);
+      pipe->Owner->Runner->Done(*pipe->Owner);
+    }
+  }
+
+  static void OnExitCB(uv_process_t* process, int64_t exit_status,
+                       int term_signal)
+  {
+    Slot* slot = static_cast<Slot*>(process->data);
+    slot->Result.RetVal = static_cast<int>(exit_status);
+    if (term_signal != 0) {
+      slot->Result.Started = false;
+      slot->Result.TermSignal = term_signal;
+    }
+    slot->Runner->Done(*slot);
+  }
+
+  size_t Count;
+  cmUVProcessPool::CommandCallback const& Command;
+  cmUVProcessPool::FinishCallback const& Finish;
+  bool MergeOutput;
+  std::vector<Slot> Slots;
+  size_t Next;
+  uv_loop_t Loop;
+};
+}
+
+cmUVProcessPool::cmUVProcessPool(size_t count, CommandCallback command,
+                                 FinishCallback finish)
+  : Count(count)
+  , Command(std::move(command))
+  , Finish(std::move(finish))
+  , MergeOutput(false)
+{
+}
+
+size_t cmUVProcessPool::GetSlotCount(size_t jobs) const
+{
+  return std::max<size_t>(1, std::min(jobs, this->Count));
+}
+
+void cmUVProcessPool::Run(size_t jobs)
+{
+  if (this->Count == 0) {
+    return;
+  }
+  cmUVProcessPoolRunner runner(this->Count, this->Command, this->Finish,
+                               this->MergeOutput);
+  runner.Run(this->GetSlotCount(jobs));
+}
@@ -0,0 +1,77 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmUVProcessPool_h
+#define cmUVProcessPool_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <functional>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/** \class cmUVProcessPool
+ * \brief Run a number of commands with at most a given number at a time.
+ *
+ * The commands are numbered from zero and started in that order, each
+ * in one of the slots of the pool as soon as the slot is free.  A
+ * callback gives the command line and working directory of a command
+ * when it is started, and another one is called with its result as
+ * soon as it finished, before its slot is reused.
+ */
+class cmUVProcessPool
+{
+public:
+  struct Result
+  {
+    Result()
+      : Started(false)
+      , RetVal(0)
+      , TermSignal(0)
+    {
+    }
+    /** Whether the process ran to its exit.  False if it could not be
+        started, with the reason in Errors, or if it was terminated by
+        signal TermSignal.  */
+    bool Started;
+    int RetVal;
+    int TermSignal;
+    std::string Output;
+    std::string Errors;
+  };
+
+  /** Set the command line and working directory of the command with
+      the given index, to be run in the given slot.  */
+  typedef std::function<void(size_t index, size_t slot,
+                             std::vector<std::string>& command,
+                             std::string& workingDirectory)>
+    CommandCallback;
+
+  /** Take the result of the command with the given index, run in the
+      given slot.  */
+  typedef std::function<void(size_t index, size_t slot, Result& result)>
+    FinishCallback;
+
+  cmUVProcessPool(size_t count, CommandCallback command,
+                  FinishCallback finish);
+
+  CM_DISABLE_COPY(cmUVProcessPool)
+
+  /** Collect the error stream of the commands in Result::Output, in
+      the order the data arrives, instead of in Result::Errors.  */
+  void SetMergeOutput(bool merge) { this->MergeOutput = merge; }
+
+  /** Number of slots used by Run for at most \a jobs at a time.  */
+  size_t GetSlotCount(size_t jobs) const;
+
+  /** Run all commands with at most \a jobs of them at a time.  */
+  void Run(size_t jobs);
+
+private:
+  size_t Count;
+  CommandCallback Command;
+  FinishCallback Finish;
+  bool MergeOutput;
+};
+
+#endif
@@ -0,0 +1,84 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmWorkerPool.h"
+
+#include <utility>
+
+cmWorkerPool::cmWorkerPool(unsigned int threadCount)
+  : RunningJobs(0)
+  , Stop(false)
+{
+  if (threadCount == 0) {
+    threadCount = cmWorkerPool::GetHardwareThreadCount();
+  }
+  this->Threads.reserve(threadCount);
+  for (unsigned int i = 0; i < threadCount; ++i) {
+    this->Threads.emplace_back(&cmWorkerPool::Work, this);
+  }
+}
+
+cmWorkerPool::~cmWorkerPool()
+{
+  this->WaitForJobs();
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stop = true;
+  }
+  this->JobAvailable.notify_all();
+  for (std::thread& thread : this->Threads) {
+    thread.join();
+  }
+}
+
+void cmWorkerPool::PushJob(JobT job)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Jobs.push_back(std::move(job));
+  }
+  this->JobAvailable.notify_one();
+}
+
+void cmWorkerPool::WaitForQueueSize(size_t count)
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->JobTaken.wait(lock,
+                      [this, count] { return this->Jobs.size() <= count; });
+}
+
+void cmWorkerPool::WaitForJobs()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  this->JobsFinished.wait(
+    lock, [this] { return this->Jobs.empty() && this->RunningJobs == 0; });
+}
+
+unsigned int cmWorkerPool::GetHardwareThreadCount()
+{
+  unsigned int count = std::thread::hardware_concurrency();
+  return count > 0 ? count : 1;
+}
+
+void cmWorkerPool::Work()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;) {
+    this->JobAvailable.wait(
+      lock, [this] { return this->Stop || !this->Jobs.empty(); });
+    if (this->Jobs.empty()) {
+      // Stop was requested and there is nothing left to do.
+      break;
+    }
+    JobT job = std::move(this->Jobs.front());
+    this->Jobs.pop_front();
+    ++this->RunningJobs;
+    this->JobTaken.notify_all();
+    lock.unlock();
+    job();
+    lock.lock();
+    --this->RunningJobs;
+    if (this->Jobs.empty() && this->RunningJobs == 0) {
+      this->JobsFinished.notify_all();
+    }
+  }
+}
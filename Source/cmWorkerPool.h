@@ -0,0 +1,69 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#ifndef cmWorkerPool_h
+#define cmWorkerPool_h
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+/** \class cmWorkerPool
+ * \brief A fixed-size pool of threads processing a queue of jobs.
+ *
+ * Jobs are started in the order they were pushed.  Jobs must not
+ * touch cmMakefile, cmState or other non thread-safe objects; they
+ * typically compute a result that is consumed later by the main thread.
+ */
+class cmWorkerPool
+{
+public:
+  typedef std::function<void()> JobT;
+
+  /** Start \a threadCount worker threads.  A count of zero selects
+      the number of hardware threads.  */
+  explicit cmWorkerPool(unsigned int threadCount);
+
+  /** Wait for all queued jobs to finish and join the threads.  */
+  ~cmWorkerPool();
+
+  CM_DISABLE_COPY(cmWorkerPool)
+
+  /** Queue a job for execution on one of the worker threads.  */
+  void PushJob(JobT job);
+
+  /** Block until at most \a count jobs wait in the queue.  Jobs that
+      are already running do not count.  */
+  void WaitForQueueSize(size_t count);
+
+  /** Block until the queue is empty and no job is running.  */
+  void WaitForJobs();
+
+  /** Number of worker threads in this pool.  */
+  unsigned int GetThreadCount() const
+  {
+    return static_cast<unsigned int>(this->Threads.size());
+  }
+
+  /** Number of hardware threads, at least one.  */
+  static unsigned int GetHardwareThreadCount();
+
+private:
+  void Work();
+
+  std::mutex Mutex;
+  std::condition_variable JobAvailable;
+  std::condition_variable JobTaken;
+  std::condition_variable JobsFinished;
+  std::deque<JobT> Jobs;
+  unsigned int RunningJobs;
+  bool Stop;
+  std::vector<std::thread> Threads;
+};
+
+#endif
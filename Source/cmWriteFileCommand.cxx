@@ -4,6 +4,8 @@
 
 #include "cmsys/FStream.hxx"
 
+#include "cmDirectoryListingCache.h"
+#include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmSystemTools.h"
 #include "cm_sys_stat.h"
@@ -41,6 +43,8 @@ bool cmWriteFileCommand::InitialPass(std::vector<std::string> const& args,
     return false;
   }
 
+  this->Makefile->GetGlobalGenerator()->GetDirectoryListingCache().Invalidate(
+    fileName);
   std::string dir = cmSystemTools::GetFilenamePath(fileName);
   cmSystemTools::MakeDirectory(dir);
 
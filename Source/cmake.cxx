@@ -3,6 +3,7 @@
 #include "cmake.h"
 
 #include "cmAlgorithms.h"
+#include "cmCheckBuildSystemManifest.h"
 #include "cmCommands.h"
 #include "cmDocumentation.h"
 #include "cmDocumentationEntry.h"
@@ -30,8 +31,11 @@
 #if defined(CMAKE_BUILD_WITH_CMAKE)
 #  include "cm_jsoncpp_writer.h"
 
+#  include "cmCryptoHash.h"
 #  include "cmGraphVizWriter.h"
+#  include "cmMakefileProfilingData.h"
 #  include "cmVariableWatch.h"
+#  include "cmWorkerPool.h"
 #  include <unordered_map>
 #endif
 
@@ -133,6 +137,8 @@ cmake::cmake(Role role)
   this->WarnUnused = false;
   this->WarnUnusedCli = true;
   this->CheckSystemVars = false;
+  this->ConfigureJobs = -1;
+  this->GenerateCommitJobs = 0;
   this->DebugOutput = false;
   this->DebugTryCompile = false;
   this->ClearBuildSystem = false;
@@ -730,6 +736,24 @@ void cmake::SetArgs(const std::vector<std::string>& args,
       std::cout << "Running with trace output on.\n";
       this->SetTrace(true);
       this->SetTraceExpand(false);
+    } else if (arg.find("--profile=", 0) == 0) {
+      std::string path = arg.substr(strlen("--profile="));
+      if (path.empty()) {
+        cmSystemTools::Error("No file specified for --profile");
+        return;
+      }
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+      path = cmSystemTools::CollapseFullPath(path);
+      this->ProfilingOutput = cm::make_unique<cmMakefileProfilingData>(path);
+      if (!this->ProfilingOutput->IsOpen()) {
+        cmSystemTools::Error("Cannot open file for write: ", path.c_str());
+        this->ProfilingOutput.reset();
+        return;
+      }
+#else
+      cmSystemTools::Error("CMake was built without support for --profile");
+      return;
+#endif
     } else if (arg.find("--warn-uninitialized", 0) == 0) {
       std::cout << "Warn about uninitialized values.\n";
       this->SetWarnUninitialized(true);
@@ -740,6 +764,36 @@ void cmake::SetArgs(const std::vector<std::string>& args,
       std::cout << "Not searching for unused variables given on the "
                 << "command line.\n";
       this->SetWarnUnusedCli(false);
+    } else if (arg.find("--configure-jobs", 0) == 0) {
+      std::string value = arg.substr(strlen("--configure-jobs"));
+      unsigned long jobs = 0;
+      if (value.empty()) {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+        jobs = cmWorkerPool::GetHardwareThreadCount();
+#endif
+      } else if (value[0] != '=' ||
+                 !cmSystemTools::StringToULong(value.c_str() + 1, &jobs) ||
+                 jobs > 1024) {
+        cmSystemTools::Error("Invalid value for --configure-jobs: ",
+                             value.c_str());
+        return;
+      }
+      this->SetConfigureJobs(static_cast<int>(jobs));
+    } else if (arg.find("--generate-commit-jobs", 0) == 0) {
+      std::string value = arg.substr(strlen("--generate-commit-jobs"));
+      unsigned long jobs = 0;
+      if (value.empty()) {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+        jobs = cmWorkerPool::GetHardwareThreadCount();
+#endif
+      } else if (value[0] != '=' ||
+                 !cmSystemTools::StringToULong(value.c_str() + 1, &jobs) ||
+                 jobs > 1024) {
+        cmSystemTools::Error("Invalid value for --generate-commit-jobs: ",
+                             value.c_str());
+        return;
+      }
+      this->SetGenerateCommitJobs(static_cast<int>(jobs));
     } else if (arg.find("--check-system-vars", 0) == 0) {
       std::cout << "Also check system files when warning about unused and "
                 << "uninitialized variables.\n";
@@ -1822,6 +1876,11 @@ bool cmake::LoadCache(const std::string& path, bool internal,
                       std::set<std::string>& includes)
 {
   bool result = this->State->LoadCache(path, internal, excludes, includes);
+  if (result && this->GetDebugOutput() &&
+      this->State->IsCacheLoadedFromMirror()) {
+    std::cout << "Loaded cache entries of " << path
+              << "/CMakeCache.txt from its binary mirror.\n";
+  }
   static const char* entries[] = { "CMAKE_CACHE_MAJOR_VERSION",
                                    "CMAKE_CACHE_MINOR_VERSION" };
   for (const char* const* nameIt = cm::cbegin(entries);
@@ -1837,7 +1896,9 @@ bool cmake::SaveCache(const std::string& path)
   static const char* entries[] = { "CMAKE_CACHE_MAJOR_VERSION",
                                    "CMAKE_CACHE_MINOR_VERSION",
                                    "CMAKE_CACHE_PATCH_VERSION",
-                                   "CMAKE_CACHEFILE_DIR" };
+                                   "CMAKE_CACHEFILE_DIR",
+                                   "CMAKE_CACHE_BINARY_MIRROR",
+                                   "CMAKE_LISTFILE_CACHE" };
   for (const char* const* nameIt = cm::cbegin(entries);
        nameIt != cm::cend(entries); ++nameIt) {
     this->UnwatchUnusedCli(*nameIt);
@@ -1942,6 +2003,33 @@ void cmake::UpdateConversionPathTable()
   }
 }
 
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+// Check whether every dependency newer than the output still has the
+// content recorded in the manifest when the build system was generated.
+static bool cmakeCheckDependsContent(
+  cmCheckBuildSystemManifest const& manifest, std::string const& output,
+  cmFileTimeComparison* ftc)
+{
+  if (manifest.DependHashes.size() != manifest.Depends.size()) {
+    return false;
+  }
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  for (size_t i = 0; i < manifest.Depends.size(); ++i) {
+    std::string const& dep = manifest.Depends[i];
+    int result = 0;
+    if (!ftc->FileTimeCompare(output.c_str(), dep.c_str(), &result)) {
+      return false;
+    }
+    if (result < 0 &&
+        (manifest.DependHashes[i].empty() ||
+         hasher.HashFile(dep) != manifest.DependHashes[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
 int cmake::CheckBuildSystem()
 {
   // We do not need to rerun CMake.  Check dependency integrity.
@@ -1973,49 +2061,70 @@ int cmake::CheckBuildSystem()
   }
 
   // Read the rerun check file and use it to decide whether to do the
-  // global generate.
-  cmake cm(RoleScript); // Actually, all we need is the `set` command.
-  cm.SetHomeDirectory("");
-  cm.SetHomeOutputDirectory("");
-  cm.GetCurrentSnapshot().SetDefaultDefinitions();
-  cmGlobalGenerator gg(&cm);
-  cmMakefile mf(&gg, cm.GetCurrentSnapshot());
-  if (!mf.ReadListFile(this->CheckBuildSystemArgument.c_str()) ||
-      cmSystemTools::GetErrorOccuredFlag()) {
+  // global generate.  The manifest written next to it by the generator
+  // holds the same lists and is read without a CMake language interpreter.
+  cmCheckBuildSystemManifest manifest;
+  if (!this->ClearBuildSystem &&
+      manifest.Read(this->CheckBuildSystemArgument)) {
     if (verbose) {
       std::ostringstream msg;
-      msg << "Re-run cmake error reading : " << this->CheckBuildSystemArgument
-          << "\n";
+      msg << "Read build system check manifest of: "
+          << this->CheckBuildSystemArgument << "\n";
       cmSystemTools::Stdout(msg.str().c_str());
     }
-    // There was an error reading the file.  Just rerun.
-    return 1;
-  }
+  } else {
+    cmake cm(RoleScript); // Actually, all we need is the `set` command.
+    cm.SetHomeDirectory("");
+    cm.SetHomeOutputDirectory("");
+    cm.GetCurrentSnapshot().SetDefaultDefinitions();
+    cmGlobalGenerator gg(&cm);
+    cmMakefile mf(&gg, cm.GetCurrentSnapshot());
+    if (!mf.ReadListFile(this->CheckBuildSystemArgument.c_str()) ||
+        cmSystemTools::GetErrorOccuredFlag()) {
+      if (verbose) {
+        std::ostringstream msg;
+        msg << "Re-run cmake error reading : "
+            << this->CheckBuildSystemArgument << "\n";
+        cmSystemTools::Stdout(msg.str().c_str());
+      }
+      // There was an error reading the file.  Just rerun.
+      return 1;
+    }
 
-  if (this->ClearBuildSystem) {
-    // Get the generator used for this build system.
-    const char* genName = mf.GetDefinition("CMAKE_DEPENDS_GENERATOR");
-    if (!genName || genName[0] == '\0') {
-      genName = "Unix Makefiles";
+    if (this->ClearBuildSystem) {
+      // Get the generator used for this build system.
+      const char* genName = mf.GetDefinition("CMAKE_DEPENDS_GENERATOR");
+      if (!genName || genName[0] == '\0') {
+        genName = "Unix Makefiles";
+      }
+
+      // Create the generator and use it to clear the dependencies.
+      std::unique_ptr<cmGlobalGenerator> ggd(
+        this->CreateGlobalGenerator(genName));
+      if (ggd) {
+        cm.GetCurrentSnapshot().SetDefaultDefinitions();
+        cmMakefile mfd(ggd.get(), cm.GetCurrentSnapshot());
+        std::unique_ptr<cmLocalGenerator> lgd(
+          ggd->CreateLocalGenerator(&mfd));
+        lgd->ClearDependencies(&mfd, verbose);
+      }
     }
 
-    // Create the generator and use it to clear the dependencies.
-    std::unique_ptr<cmGlobalGenerator> ggd(
-      this->CreateGlobalGenerator(genName));
-    if (ggd) {
-      cm.GetCurrentSnapshot().SetDefaultDefinitions();
-      cmMakefile mfd(ggd.get(), cm.GetCurrentSnapshot());
-      std::unique_ptr<cmLocalGenerator> lgd(ggd->CreateLocalGenerator(&mfd));
-      lgd->ClearDependencies(&mfd, verbose);
+    // Get the set of byproducts, dependencies and outputs.
+    if (const char* productStr =
+          mf.GetDefinition("CMAKE_MAKEFILE_PRODUCTS")) {
+      cmSystemTools::ExpandListArgument(productStr, manifest.Products);
+    }
+    const char* dependsStr = mf.GetDefinition("CMAKE_MAKEFILE_DEPENDS");
+    const char* outputsStr = mf.GetDefinition("CMAKE_MAKEFILE_OUTPUTS");
+    if (dependsStr && outputsStr) {
+      cmSystemTools::ExpandListArgument(dependsStr, manifest.Depends);
+      cmSystemTools::ExpandListArgument(outputsStr, manifest.Outputs);
     }
   }
 
   // If any byproduct of makefile generation is missing we must re-run.
-  std::vector<std::string> products;
-  if (const char* productStr = mf.GetDefinition("CMAKE_MAKEFILE_PRODUCTS")) {
-    cmSystemTools::ExpandListArgument(productStr, products);
-  }
-  for (std::string const& p : products) {
+  for (std::string const& p : manifest.Products) {
     if (!(cmSystemTools::FileExists(p) || cmSystemTools::FileIsSymlink(p))) {
       if (verbose) {
         std::ostringstream msg;
@@ -2026,15 +2135,8 @@ int cmake::CheckBuildSystem()
     }
   }
 
-  // Get the set of dependencies and outputs.
-  std::vector<std::string> depends;
-  std::vector<std::string> outputs;
-  const char* dependsStr = mf.GetDefinition("CMAKE_MAKEFILE_DEPENDS");
-  const char* outputsStr = mf.GetDefinition("CMAKE_MAKEFILE_OUTPUTS");
-  if (dependsStr && outputsStr) {
-    cmSystemTools::ExpandListArgument(dependsStr, depends);
-    cmSystemTools::ExpandListArgument(outputsStr, outputs);
-  }
+  std::vector<std::string>& depends = manifest.Depends;
+  std::vector<std::string>& outputs = manifest.Outputs;
   if (depends.empty() || outputs.empty()) {
     // Not enough information was provided to do the test.  Just rerun.
     if (verbose) {
@@ -2092,6 +2194,24 @@ int cmake::CheckBuildSystem()
     if (!this->FileComparison->FileTimeCompare(out_oldest.c_str(),
                                                dep_newest.c_str(), &result) ||
         result < 0) {
+#if defined(CMAKE_BUILD_WITH_CMAKE)
+      // The dependencies may have only been touched, e.g. by a checkout
+      // of another branch and back.  The outputs are then up to date.
+      if (result < 0 &&
+          cmakeCheckDependsContent(manifest, out_oldest,
+                                   this->FileComparison)) {
+        if (verbose) {
+          std::ostringstream msg;
+          msg << "Content of build system dependencies unchanged, "
+                 "updating time stamps of outputs\n";
+          cmSystemTools::Stdout(msg.str().c_str());
+        }
+        for (std::string const& o : outputs) {
+          cmSystemTools::Touch(o, false);
+        }
+        return 0;
+      }
+#endif
       if (verbose) {
         std::ostringstream msg;
         msg << "Re-run cmake file: " << out_oldest
@@ -6,6 +6,7 @@
 #include "cmConfigure.h" // IWYU pragma: keep
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -25,6 +26,7 @@ class cmFileTimeComparison;
 class cmGlobalGenerator;
 class cmGlobalGeneratorFactory;
 class cmMakefile;
+class cmMakefileProfilingData;
 class cmMessenger;
 class cmState;
 class cmVariableWatch;
@@ -301,6 +303,12 @@ public:
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   ///! Get the variable watch object
   cmVariableWatch* GetVariableWatch() { return this->VariableWatch; }
+
+  ///! Get the profiler enabled by --profile, or null
+  cmMakefileProfilingData* GetProfilingOutput() const
+  {
+    return this->ProfilingOutput.get();
+  }
 #endif
 
   void GetGeneratorDocumentation(std::vector<cmDocumentationEntry>&);
@@ -369,6 +377,17 @@ public:
   bool GetCheckSystemVars() { return this->CheckSystemVars; }
   void SetCheckSystemVars(bool b) { this->CheckSystemVars = b; }
 
+  // Number of threads parsing listfiles ahead of the configure step.
+  // Zero parses serially, a negative value disables the per-directory
+  // configure time report too.
+  int GetConfigureJobs() const { return this->ConfigureJobs; }
+  void SetConfigureJobs(int jobs) { this->ConfigureJobs = jobs; }
+
+  // Number of threads replacing generated files during the generate
+  // step.  Zero replaces them on the generating thread.
+  int GetGenerateCommitJobs() const { return this->GenerateCommitJobs; }
+  void SetGenerateCommitJobs(int jobs) { this->GenerateCommitJobs = jobs; }
+
   void MarkCliAsUsed(const std::string& variable);
 
   /** Get the list of configurations (in upper case) considered to be
@@ -508,6 +527,8 @@ private:
   bool WarnUnused;
   bool WarnUnusedCli;
   bool CheckSystemVars;
+  int ConfigureJobs;
+  int GenerateCommitJobs;
   std::map<std::string, bool> UsedCliVariables;
   std::string CMakeEditCommand;
   std::string CXXEnvironment;
@@ -528,6 +549,7 @@ private:
 
 #if defined(CMAKE_BUILD_WITH_CMAKE)
   cmVariableWatch* VariableWatch;
+  std::unique_ptr<cmMakefileProfilingData> ProfilingOutput;
 #endif
 
   cmState* State;
@@ -97,6 +97,15 @@ static const char* cmDocumentationOptions[][2] = {
   { "--check-system-vars",
     "Find problems with variable usage in system "
     "files." },
+  { "--profile=<file>",
+    "Write the time spent in each command to <file> in Chrome trace "
+    "format." },
+  { "--configure-jobs[=<jobs>]",
+    "Parse listfiles ahead of the configure step on <jobs> threads and "
+    "report the time spent configuring each directory." },
+  { "--generate-commit-jobs[=<jobs>]",
+    "Replace the generated files on <jobs> threads while the generate "
+    "step writes the next ones." },
   { nullptr, nullptr }
 };
 
@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory> // IWYU pragma: keep
 #include <sstream>
 #include <stdio.h>
@@ -1027,6 +1028,12 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       std::vector<std::string> files;
       std::string mtime;
       std::string format;
+      bool zstd = false;
+      unsigned long compressionLevel = 0;
+      unsigned long numThreads = 1;
+      // Both are passed on as int.
+      unsigned long const maxIntArg =
+        static_cast<unsigned long>(std::numeric_limits<int>::max());
       bool doing_options = true;
       for (std::string::size_type cc = 4; cc < args.size(); cc++) {
         std::string const& arg = args[cc];
@@ -1040,6 +1047,25 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
             if (!cmTarFilesFrom(files_from, files)) {
               return 1;
             }
+          } else if (arg == "--zstd") {
+            zstd = true;
+          } else if (cmHasLiteralPrefix(arg, "--compression-level=")) {
+            if (!cmSystemTools::StringToULong(arg.c_str() + 20,
+                                              &compressionLevel) ||
+                compressionLevel > maxIntArg) {
+              cmSystemTools::Error(
+                "Invalid -E tar --compression-level= argument: ",
+                arg.c_str() + 20);
+              return 1;
+            }
+          } else if (cmHasLiteralPrefix(arg, "--threads=")) {
+            if (!cmSystemTools::StringToULong(arg.c_str() + 10,
+                                              &numThreads) ||
+                numThreads > maxIntArg) {
+              cmSystemTools::Error("Invalid -E tar --threads= argument: ",
+                                   arg.c_str() + 10);
+              return 1;
+            }
           } else if (cmHasLiteralPrefix(arg, "--format=")) {
             format = arg.substr(9);
             bool isKnown =
@@ -1075,6 +1101,10 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
         compress = cmSystemTools::TarCompressGZip;
         ++nCompress;
       }
+      if (zstd) {
+        compress = cmSystemTools::TarCompressZstd;
+        ++nCompress;
+      }
       if ((format == "7zip" || format == "zip") && nCompress > 0) {
         cmSystemTools::Error("Can not use compression flags with format: ",
                              format.c_str());
@@ -1082,7 +1112,8 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
       }
       if (nCompress > 1) {
         cmSystemTools::Error("Can only compress a tar file one way; "
-                             "at most one flag of z, j, or J may be used");
+                             "at most one flag of z, j, J, or --zstd "
+                             "may be used");
         return 1;
       }
       if (flags.find_first_of('v') != std::string::npos) {
@@ -1095,8 +1126,10 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string>& args)
           return 1;
         }
       } else if (flags.find_first_of('c') != std::string::npos) {
-        if (!cmSystemTools::CreateTar(outFile.c_str(), files, compress,
-                                      verbose, mtime, format)) {
+        if (!cmSystemTools::CreateTar(
+              outFile.c_str(), files, compress, verbose, mtime, format,
+              static_cast<int>(compressionLevel),
+              static_cast<int>(numThreads))) {
           cmSystemTools::Error("Problem creating tar: ", outFile.c_str());
           return 1;
         }
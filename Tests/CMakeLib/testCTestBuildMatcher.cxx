@@ -0,0 +1,76 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+
+#include <cmConfigure.h> // IWYU pragma: keep
+
+#include <iostream>
+#include <string>
+
+#include "CTest/cmCTestBuildMatcher.h"
+
+#define cmPassed(m) std::cout << "Passed: " << (m) << "\n"
+#define cmFailed(m)                                                           \
+  std::cout << "FAILED: " << (m) << "\n";                                     \
+  failed = 1
+
+struct testCTestBuildMatcherEntry
+{
+  const char* Regex;
+  const char* Literal;
+  const char* Line;
+};
+
+static testCTestBuildMatcherEntry const testEntries[] = {
+  // Plain text and anchors.
+  { "^warning: (.*)$", "warning: ", "warning: unused variable" },
+  // Alternation at the top level has no common literal.
+  { "abc|def", "", "xdefx" },
+  { "(abc|def)ghi", "ghi", "abcghi" },
+  // Optional and repeated characters end a run.
+  { "colou?r", "colo", "color" },
+  { "ab*cd", "cd", "acd" },
+  { "xy+z", "x", "xyyz" },
+  { "a.*bcd", "bcd", "a bcd" },
+  // Character classes, including ']' as the first member.
+  { "x[abc]yz", "yz", "xbyz" },
+  { "[]]abc", "abc", "]abc" },
+  { "[^]x]warning", "warning", "-warning" },
+  // Escaped characters are literal, unless repeated.
+  { "error\\.c", "error.c", "error.c: 1" },
+  { "\\(x\\)", "(x)", "f(x)" },
+  { "ab\\*+", "ab", "ab**" },
+  { nullptr, nullptr, nullptr }
+};
+
+int testCTestBuildMatcher(int /*unused*/, char* /*unused*/ [])
+{
+  int failed = 0;
+
+  // ----------------------------------------------------------------------
+  // Test cmCTestBuildMatcher::RequiredLiteral
+  for (testCTestBuildMatcherEntry const* e = testEntries; e->Regex; ++e) {
+    std::string const literal =
+      cmCTestBuildMatcher::RequiredLiteral(e->Regex);
+    if (literal != e->Literal) {
+      cmFailed("RequiredLiteral(\"" + std::string(e->Regex) + "\") is \"" +
+               literal + "\", expected \"" + e->Literal + "\"");
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Test that the literal never rejects a matching line
+  for (testCTestBuildMatcherEntry const* e = testEntries; e->Regex; ++e) {
+    cmCTestBuildMatcher matcher;
+    matcher.Add("^never matched$");
+    matcher.Add(e->Regex);
+    if (matcher.Find(cmCTestBuildMatcher::Line(e->Line)) != 1) {
+      cmFailed("\"" + std::string(e->Regex) + "\" not found in \"" +
+               e->Line + "\"");
+    }
+  }
+
+  if (!failed) {
+    cmPassed("cmCTestBuildMatcher working");
+  }
+  return failed;
+}
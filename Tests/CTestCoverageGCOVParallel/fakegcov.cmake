@@ -0,0 +1,29 @@
+# Write a .gcov file for the source named in the fake .gcda file and
+# report it in the style of gcov 4 and later.
+foreach(I RANGE 0 ${CMAKE_ARGC})
+  if("${CMAKE_ARGV${I}}" MATCHES ".*\\.gcda")
+    set(gcda_file "${CMAKE_ARGV${I}}")
+  endif()
+endforeach()
+
+file(STRINGS "${gcda_file}" source_file LIMIT_COUNT 1 ENCODING UTF-8)
+get_filename_component(source_name "${source_file}" NAME)
+set(gcov_name "${source_name}.gcov")
+
+# Count every line of the source as executed once.
+file(READ "${source_file}" source)
+string(REGEX REPLACE "[^\n]" "" newlines "${source}")
+string(LENGTH "${newlines}" count)
+set(gcov "        -:    0:Source:${source_file}\n")
+foreach(line RANGE 1 ${count})
+  set(number "    ${line}")
+  string(LENGTH "${number}" length)
+  math(EXPR start "${length} - 5")
+  string(SUBSTRING "${number}" ${start} 5 number)
+  string(APPEND gcov "        1:${number}:\n")
+endforeach()
+file(WRITE "${CMAKE_SOURCE_DIR}/${gcov_name}" "${gcov}")
+
+execute_process(COMMAND "${CMAKE_COMMAND}" -E echo "File '${source_file}'")
+execute_process(COMMAND "${CMAKE_COMMAND}" -E echo "Lines executed:100.00% of ${count}")
+execute_process(COMMAND "${CMAKE_COMMAND}" -E echo "Creating '${gcov_name}'")
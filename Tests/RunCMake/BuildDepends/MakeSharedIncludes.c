@@ -0,0 +1,6 @@
+#include "MakeSharedIncludes.h"
+
+int main(void)
+{
+  return MakeSharedIncludes();
+}
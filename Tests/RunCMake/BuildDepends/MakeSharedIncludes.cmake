@@ -0,0 +1,26 @@
+enable_language(C)
+include_directories("${CMAKE_CURRENT_BINARY_DIR}")
+add_executable(MakeSharedIncludes1 MakeSharedIncludes.c)
+add_executable(MakeSharedIncludes2 MakeSharedIncludes.c)
+# Scan the second target after the first so it finds the headers in
+# the include cache shared by all targets.
+add_dependencies(MakeSharedIncludes2 MakeSharedIncludes1)
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_exes
+  \"$<TARGET_FILE:MakeSharedIncludes1>\"
+  \"$<TARGET_FILE:MakeSharedIncludes2>\"
+  )
+# The include cache shared by the targets forgets a header removed in
+# step 2.
+file(GLOB caches \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/CMakeIncludeCache/*.txt\")
+if(NOT caches)
+  string(APPEND RunCMake_TEST_FAILED \"No shared include cache found.\\n\")
+endif()
+foreach(cache IN LISTS caches)
+  if(check_step EQUAL 1)
+    list(APPEND check_contains \"\${cache}|MakeSharedIncludesValue.h\")
+  else()
+    list(APPEND check_not_contains \"\${cache}|MakeSharedIncludesValue.h\")
+  endif()
+endforeach()
+")
@@ -0,0 +1,6 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludes.h" [[
+#include "MakeSharedIncludesValue.h"
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesValue.h" [[
+static int MakeSharedIncludes(void) { return 1; }
+]])
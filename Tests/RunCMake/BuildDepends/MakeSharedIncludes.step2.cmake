@@ -0,0 +1,7 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludes.h" [[
+#include "MakeSharedIncludesNew.h"
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesNew.h" [[
+static int MakeSharedIncludes(void) { return 2; }
+]])
+file(REMOVE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesValue.h")
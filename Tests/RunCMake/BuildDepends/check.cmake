@@ -26,6 +26,28 @@ if(EXISTS ${RunCMake_TEST_BINARY_DIR}/check-debug.cmake)
       elseif(NOT "${lhs}" IS_NEWER_THAN "${rhs}")
         string(APPEND RunCMake_TEST_FAILED "
  '${lhs}' is not newer than '${rhs}'
+")
+      endif()
+    endif()
+  endforeach()
+  foreach(p IN LISTS check_contains)
+    if("${p}" MATCHES "^(.*)\\|(.*)$")
+      file(READ "${CMAKE_MATCH_1}" content)
+      string(FIND "${content}" "${CMAKE_MATCH_2}" pos)
+      if(pos EQUAL -1)
+        string(APPEND RunCMake_TEST_FAILED "
+ '${CMAKE_MATCH_1}' does not contain '${CMAKE_MATCH_2}'
+")
+      endif()
+    endif()
+  endforeach()
+  foreach(p IN LISTS check_not_contains)
+    if("${p}" MATCHES "^(.*)\\|(.*)$")
+      file(READ "${CMAKE_MATCH_1}" content)
+      string(FIND "${content}" "${CMAKE_MATCH_2}" pos)
+      if(NOT pos EQUAL -1)
+        string(APPEND RunCMake_TEST_FAILED "
+ '${CMAKE_MATCH_1}' contains '${CMAKE_MATCH_2}'
 ")
       endif()
     endif()
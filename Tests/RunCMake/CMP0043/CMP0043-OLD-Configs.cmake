@@ -0,0 +1,26 @@
+cmake_policy(SET CMP0043 OLD)
+
+# The usage requirements of these targets differ between configurations
+# only through a transitive link item, a per-configuration property or
+# the file of another target.
+add_library(debug_iface INTERFACE)
+target_compile_definitions(debug_iface INTERFACE FROM_DEBUG_LINK)
+add_library(dep INTERFACE)
+target_link_libraries(dep INTERFACE $<$<CONFIG:Debug>:debug_iface>)
+
+add_library(link_item STATIC configs.cpp)
+target_compile_definitions(link_item PRIVATE EXPECT_LINK)
+target_link_libraries(link_item PRIVATE dep)
+
+add_library(config_property STATIC configs.cpp)
+target_compile_definitions(config_property PRIVATE EXPECT_PROPERTY)
+set_property(TARGET config_property
+  PROPERTY COMPILE_DEFINITIONS_DEBUG FROM_DEBUG_PROPERTY
+)
+
+add_library(named STATIC configs.cpp)
+set_property(TARGET named PROPERTY DEBUG_POSTFIX _d)
+add_library(artifact STATIC configs.cpp)
+target_compile_definitions(artifact PRIVATE
+  "ARTIFACT_NAME=\"$<TARGET_FILE_NAME:named>\""
+)
@@ -5,3 +5,30 @@ list(APPEND RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug)
 run_cmake(CMP0043-OLD)
 run_cmake(CMP0043-NEW)
 run_cmake(CMP0043-WARN)
+
+# Multi-configuration generators share the usage requirements found to
+# be the same in all configurations.  Build each configuration to check
+# that those of the other configurations are not used.
+function(run_Configs)
+  if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CMP0043-OLD-Configs-build)
+    set(RunCMake_TEST_OPTIONS "-DCMAKE_CONFIGURATION_TYPES=Debug\;Release")
+    run_cmake(CMP0043-OLD-Configs)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    foreach(config Debug Release)
+      run_cmake_command(CMP0043-OLD-Configs-build
+        ${CMAKE_COMMAND} --build . --config ${config})
+    endforeach()
+  else()
+    foreach(config Debug Release)
+      set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CMP0043-OLD-Configs-${config}-build)
+      set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=${config})
+      run_cmake(CMP0043-OLD-Configs)
+      set(RunCMake_TEST_NO_CLEAN 1)
+      run_cmake_command(CMP0043-OLD-Configs-build
+        ${CMAKE_COMMAND} --build . --config ${config})
+      unset(RunCMake_TEST_NO_CLEAN)
+    endforeach()
+  endif()
+endfunction()
+run_Configs()
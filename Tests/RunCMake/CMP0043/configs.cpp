@@ -0,0 +1,33 @@
+#ifdef NDEBUG
+#if defined(FROM_DEBUG_LINK) || defined(FROM_DEBUG_PROPERTY)
+#error "Debug definition in another configuration"
+#endif
+#else
+#if defined(EXPECT_LINK) && !defined(FROM_DEBUG_LINK)
+#error "FROM_DEBUG_LINK not defined in the Debug configuration"
+#endif
+#if defined(EXPECT_PROPERTY) && !defined(FROM_DEBUG_PROPERTY)
+#error "FROM_DEBUG_PROPERTY not defined in the Debug configuration"
+#endif
+#endif
+
+#ifdef ARTIFACT_NAME
+constexpr bool hasDebugPostfix(const char* s)
+{
+  return *s == 0 ? false
+                 : (s[0] == '_' && s[1] == 'd' && s[2] == '.') ||
+      hasDebugPostfix(s + 1);
+}
+#ifdef NDEBUG
+static_assert(!hasDebugPostfix(ARTIFACT_NAME),
+              "Debug file name in another configuration");
+#else
+static_assert(hasDebugPostfix(ARTIFACT_NAME),
+              "File name without the Debug postfix");
+#endif
+#endif
+
+int configs()
+{
+  return 0;
+}
@@ -0,0 +1,10 @@
+install(FILES CMakeLists.txt DESTINATION foo)
+
+if(RunCMake_SUBTEST_SUFFIX STREQUAL "threads")
+  set(CPACK_THREADS 0)
+elseif(RunCMake_SUBTEST_SUFFIX STREQUAL "level")
+  set(CPACK_COMPRESSION_LEVEL 9)
+  set(CPACK_THREADS 2)
+else()
+  set(CPACK_THREADS ${RunCMake_SUBTEST_SUFFIX})
+endif()
@@ -78,6 +78,30 @@ endfunction()
 
 run_LabelCount()
 
+function(run_CriticalPath)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CriticalPath)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  # The dependency levels would start 'short' first, but 'long' is the
+  # longest chain of dependent tests.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+add_test(short \"${CMAKE_COMMAND}\" -E echo \"short\")
+set_tests_properties(short PROPERTIES COST 1)
+
+add_test(after_short \"${CMAKE_COMMAND}\" -E echo \"after_short\")
+set_tests_properties(after_short PROPERTIES COST 1 DEPENDS short)
+
+add_test(long \"${CMAKE_COMMAND}\" -E echo \"long\")
+set_tests_properties(long PROPERTIES COST 10)
+")
+
+  run_cmake_command(CriticalPath ${CMAKE_CTEST_COMMAND} -j2)
+  # With cost data of a previous run the schedule is also predicted.
+  run_cmake_command(CriticalPath-verbose ${CMAKE_CTEST_COMMAND} -j2 -V)
+endfunction()
+run_CriticalPath()
+
 function(run_SerialFailed)
   set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SerialFailed)
   set(RunCMake_TEST_NO_CLEAN 1)
@@ -0,0 +1,3 @@
+include(CheckBatch)
+check_batch_begin()
+check_batch_begin()
@@ -0,0 +1,19 @@
+if(NOT actual_stdout MATCHES
+    "try_compile results taken from check batches: ([0-9]+) of ([0-9]+)")
+  set(RunCMake_TEST_FAILED "No try_compile results taken from the batch.")
+  return()
+endif()
+if(CMAKE_MATCH_1 EQUAL 0 OR NOT CMAKE_MATCH_1 EQUAL CMAKE_MATCH_2)
+  set(RunCMake_TEST_FAILED
+    "${CMAKE_MATCH_1} of ${CMAKE_MATCH_2} queued results taken.")
+  return()
+endif()
+
+# Taken test projects are cleaned up by their check, and the others
+# are removed at the end of the configure step.
+file(GLOB_RECURSE files
+  "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeTmpBatch/*")
+if(files)
+  string(REPLACE ";" "\n  " files "${files}")
+  set(RunCMake_TEST_FAILED "Batch test project files left:\n  ${files}")
+endif()
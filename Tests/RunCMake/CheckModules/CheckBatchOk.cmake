@@ -0,0 +1,46 @@
+enable_language(C)
+enable_language(CXX)
+include(CheckBatch)
+include(CheckCSourceCompiles)
+include(CheckCXXSourceCompiles)
+include(CheckFunctionExists)
+include(CheckIncludeFile)
+include(CheckIncludeFileCXX)
+include(CheckSymbolExists)
+include(CheckTypeSize)
+
+macro(run_checks prefix)
+  check_include_file(stdio.h ${prefix}_STDIO_H)
+  check_include_file(does_not_exist.h ${prefix}_DOES_NOT_EXIST_H)
+  check_include_file_cxx(cstdio ${prefix}_CSTDIO)
+  check_function_exists(printf ${prefix}_PRINTF)
+  check_symbol_exists(printf stdio.h ${prefix}_PRINTF_SYMBOL)
+  set(CMAKE_REQUIRED_DEFINITIONS -DCHECK_BATCH_VALUE=0)
+  check_c_source_compiles("int main(void) { return CHECK_BATCH_VALUE; }"
+    ${prefix}_DEFINED_VALUE)
+  unset(CMAKE_REQUIRED_DEFINITIONS)
+  check_c_source_compiles("int main(void) { return CHECK_BATCH_VALUE; }"
+    ${prefix}_UNDEFINED_VALUE)
+  check_cxx_source_compiles("int main() { return 0; }" ${prefix}_CXX)
+  check_type_size(int ${prefix}_SIZEOF_INT)
+endmacro()
+
+run_checks(SERIAL)
+check_batch_begin()
+run_checks(BATCH)
+if(DEFINED BATCH_STDIO_H)
+  message(SEND_ERROR "Queued check has a result before check_batch_end().")
+endif()
+check_batch_end()
+
+foreach(v STDIO_H DOES_NOT_EXIST_H CSTDIO PRINTF PRINTF_SYMBOL DEFINED_VALUE
+          UNDEFINED_VALUE CXX SIZEOF_INT)
+  if(NOT "${BATCH_${v}}" STREQUAL "${SERIAL_${v}}")
+    message(SEND_ERROR "BATCH_${v} is \"${BATCH_${v}}\" "
+      "but SERIAL_${v} is \"${SERIAL_${v}}\".")
+  endif()
+endforeach()
+if(NOT BATCH_STDIO_H OR BATCH_DOES_NOT_EXIST_H OR NOT BATCH_DEFINED_VALUE
+    OR BATCH_UNDEFINED_VALUE)
+  message(SEND_ERROR "Unexpected check results.")
+endif()
@@ -2,6 +2,9 @@ include(RunCMake)
 
 run_cmake(CMP0075)
 
+run_cmake(CheckBatchOk)
+run_cmake(CheckBatchNested)
+
 run_cmake(CheckStructHasMemberOk)
 run_cmake(CheckStructHasMemberUnknownLanguage)
 run_cmake(CheckStructHasMemberMissingLanguage)
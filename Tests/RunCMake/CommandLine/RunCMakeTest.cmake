@@ -356,6 +356,34 @@ set(RunCMake_TEST_OPTIONS --debug-trycompile)
 run_cmake(debug-trycompile)
 unset(RunCMake_TEST_OPTIONS)
 
+set(RunCMake_TEST_OPTIONS --configure-jobs=2)
+run_cmake(configure-jobs)
+unset(RunCMake_TEST_OPTIONS)
+
+function(run_generate_commit_jobs)
+  # Generate the same tree serially and with --generate-commit-jobs in
+  # the same directory, so that paths in the generated files match.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/generate-commit-jobs-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}" "${RunCMake_TEST_BINARY_DIR}-serial")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(generate-commit-jobs)
+  file(RENAME "${RunCMake_TEST_BINARY_DIR}" "${RunCMake_TEST_BINARY_DIR}-serial")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(RunCMake_TEST_OPTIONS --generate-commit-jobs=2)
+  set(RunCMake-check-file generate-commit-jobs-compare.cmake)
+  run_cmake(generate-commit-jobs)
+endfunction()
+run_generate_commit_jobs()
+
+set(RunCMake_TEST_OPTIONS --generate-commit-jobs=x)
+run_cmake(generate-commit-jobs-bad)
+unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_OPTIONS "--profile=${RunCMake_BINARY_DIR}/profile-build/profile.json")
+run_cmake(profile)
+unset(RunCMake_TEST_OPTIONS)
+
 function(run_cmake_depends)
   set(RunCMake_TEST_SOURCE_DIR "${RunCMake_SOURCE_DIR}/cmake_depends")
   set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/cmake_depends-build")
@@ -0,0 +1,2 @@
+add_subdirectory(configure-jobs)
+include(${CMAKE_CURRENT_LIST_DIR}/configure-jobs/include.cmake)
@@ -0,0 +1 @@
+set(configure_jobs_included 1)
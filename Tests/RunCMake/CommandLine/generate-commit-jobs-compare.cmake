@@ -0,0 +1,22 @@
+# The generated tree must not depend on whether files were replaced on
+# worker threads.  The build system check manifest records a time stamp.
+set(serial_dir "${RunCMake_TEST_BINARY_DIR}-serial")
+file(GLOB_RECURSE serial_files RELATIVE "${serial_dir}" "${serial_dir}/*")
+file(GLOB_RECURSE jobs_files RELATIVE "${RunCMake_TEST_BINARY_DIR}" "${RunCMake_TEST_BINARY_DIR}/*")
+list(FILTER serial_files EXCLUDE REGEX "\\.manifest$")
+list(FILTER jobs_files EXCLUDE REGEX "\\.manifest$")
+list(SORT serial_files)
+list(SORT jobs_files)
+if(NOT serial_files STREQUAL jobs_files)
+  string(REPLACE ";" "\n  " serial_files "${serial_files}")
+  string(REPLACE ";" "\n  " jobs_files "${jobs_files}")
+  set(RunCMake_TEST_FAILED "Generated files differ.  Serial:\n  ${serial_files}\nWith --generate-commit-jobs:\n  ${jobs_files}")
+  return()
+endif()
+foreach(f IN LISTS jobs_files)
+  file(SHA256 "${serial_dir}/${f}" serial_hash)
+  file(SHA256 "${RunCMake_TEST_BINARY_DIR}/${f}" jobs_hash)
+  if(NOT serial_hash STREQUAL jobs_hash)
+    string(APPEND RunCMake_TEST_FAILED "Generated file differs: ${f}\n")
+  endif()
+endforeach()
@@ -0,0 +1,3 @@
+add_custom_target(top ALL COMMAND ${CMAKE_COMMAND} -E echo top)
+add_subdirectory(generate-commit-jobs/sub1)
+add_subdirectory(generate-commit-jobs/sub2)
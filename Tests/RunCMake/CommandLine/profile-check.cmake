@@ -0,0 +1,24 @@
+set(profile "${RunCMake_TEST_BINARY_DIR}/profile.json")
+if(NOT EXISTS "${profile}")
+  set(RunCMake_TEST_FAILED "Profile file\n  ${profile}\nnot written.")
+  return()
+endif()
+file(READ "${profile}" content)
+foreach(expect
+    "^\\[.*\\]\n$"
+    "\"cat\":\"function\"[^}]*\"name\":\"profiled_function\""
+    "\"cat\":\"macro\"[^}]*\"name\":\"profiled_macro\""
+    "\"cat\":\"include\"[^}]*\"name\":\"include\""
+    "\"cat\":\"find\"[^}]*\"name\":\"find_program\""
+    "\"name\":\"set\""
+    "\"backtrace\":\\[\"[^\"]*/profile/include.cmake:1 \\(set\\)\",\"[^\"]*/profile/include.cmake\",\"[^\"]*/profile.cmake:5 \\(include\\)\",\"[^\"]*/profile.cmake:2 \\(profiled_macro\\)\",\"[^\"]*/profile.cmake:7 \\(profiled_function\\)\""
+    "\"location\":\"[^\"]*/profile/include.cmake:1\""
+    "\"ph\":\"X\""
+    )
+  if(NOT content MATCHES "${expect}")
+    string(APPEND RunCMake_TEST_FAILED "Profile does not match\n  ${expect}\n")
+  endif()
+endforeach()
+if(RunCMake_TEST_FAILED)
+  string(APPEND RunCMake_TEST_FAILED "Actual profile:\n${content}\n")
+endif()
@@ -0,0 +1,8 @@
+function(profiled_function)
+  profiled_macro()
+endfunction()
+macro(profiled_macro)
+  include(${CMAKE_CURRENT_LIST_DIR}/profile/include.cmake)
+endmacro()
+profiled_function()
+find_program(PROFILE_PROGRAM NAMES cmake-profile-not-found)
@@ -0,0 +1 @@
+set(PROFILE_INCLUDED 1)
@@ -17,12 +17,26 @@ external_command_test(mtime      tar cvf bad.tar "--mtime=1970-01-01 00:00:00 UT
 external_command_test(bad-format tar cvf bad.tar "--format=bad-format")
 external_command_test(zip-bz2    tar cvjf bad.tar "--format=zip")
 external_command_test(7zip-gz    tar cvzf bad.tar "--format=7zip")
+external_command_test(zip-zstd   tar cvf bad.tar --zstd "--format=zip")
+external_command_test(gz-zstd    tar cvzf bad.tar --zstd)
+external_command_test(bad-level1 tar cvJf bad.tar --compression-level=bad)
+external_command_test(bad-level2 tar cvJf bad.tar --compression-level=42 .)
+external_command_test(bad-level3 tar cvJf bad.tar --compression-level=2147483648)
+external_command_test(bad-threads1 tar cvJf bad.tar --threads=bad)
+external_command_test(bad-threads2 tar cvJf bad.tar --threads=2147483648)
 
 run_cmake(7zip)
 run_cmake(gnutar)
 run_cmake(gnutar-gz)
 run_cmake(pax)
 run_cmake(pax-xz)
+run_cmake(pax-xz-threads)
 run_cmake(paxr)
 run_cmake(paxr-bz2)
 run_cmake(zip)
+
+# Zstd compression runs the zstd program unless CMake uses libzstd.
+find_program(ZSTD_EXECUTABLE zstd)
+if(ZSTD_EXECUTABLE)
+  run_cmake(paxr-zstd)
+endif()
@@ -0,0 +1,10 @@
+set(OUTPUT_NAME "test.tar.zst")
+
+set(COMPRESSION_FLAGS cvf)
+set(COMPRESSION_OPTIONS --format=paxr --zstd --compression-level=19)
+
+set(DECOMPRESSION_FLAGS xvf)
+
+include(${CMAKE_CURRENT_LIST_DIR}/roundtrip.cmake)
+
+check_magic("28b52ffd" LIMIT 4 HEX)
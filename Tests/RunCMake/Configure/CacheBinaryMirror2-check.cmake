@@ -0,0 +1,4 @@
+set(mirror "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeCache.bin")
+if(NOT EXISTS "${mirror}")
+  set(RunCMake_TEST_FAILED "Cache mirror\n  ${mirror}\nwas not written.")
+endif()
@@ -0,0 +1 @@
+message(STATUS "CacheBinaryMirrorValue='${CacheBinaryMirrorValue}'")
@@ -0,0 +1,4 @@
+set(cache "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/ListFileCache.bin")
+if(NOT EXISTS "${cache}")
+  set(RunCMake_TEST_FAILED "Listfile cache\n  ${cache}\nwas not written.")
+endif()
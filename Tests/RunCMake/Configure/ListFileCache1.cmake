@@ -0,0 +1 @@
+include(${CMAKE_BINARY_DIR}/ListFileCacheInput.cmake)
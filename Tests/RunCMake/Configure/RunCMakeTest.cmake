@@ -33,3 +33,46 @@ file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
 run_cmake(RemoveCache)
 file(REMOVE "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt")
 run_cmake(RemoveCache)
+
+# Use a single build tree for the listfile cache without cleaning.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ListFileCache-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+set(RunCMake_TEST_OPTIONS -DCMAKE_LISTFILE_CACHE=ON)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(input "${RunCMake_TEST_BINARY_DIR}/ListFileCacheInput.cmake")
+file(WRITE "${input}" "message(STATUS \"ListFileCache input 1\")\n")
+run_cmake(ListFileCache1)
+# Same size and possibly the same time stamp, so only the hash differs.
+file(WRITE "${input}" "message(STATUS \"ListFileCache input 2\")\n")
+run_cmake(ListFileCache2)
+# A file whose parsing warns is not cached, so the warning repeats.
+run_cmake(ListFileCacheWarning)
+run_cmake(ListFileCacheWarning)
+unset(RunCMake_TEST_OPTIONS)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
+
+# Use a single build tree for the cache mirror without cleaning.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CacheBinaryMirror-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(RunCMake_TEST_OPTIONS -DCMAKE_CACHE_BINARY_MIRROR=ON -DCacheBinaryMirrorValue=1)
+run_cmake(CacheBinaryMirror1)
+unset(RunCMake_TEST_OPTIONS)
+# The mirror is written when loading a cache, which changes with the
+# test name, so it is used only from the third run of the same test.
+run_cmake(CacheBinaryMirror2)
+run_cmake(CacheBinaryMirror2)
+run_cmake(CacheBinaryMirror2)
+run_cmake_command(CacheBinaryMirrorLoad ${CMAKE_COMMAND} --debug-output .)
+# Edit the cache by hand, as the mirror is not the source of truth.
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt" cache)
+string(REPLACE "CacheBinaryMirrorValue:UNINITIALIZED=1" "CacheBinaryMirrorValue:UNINITIALIZED=2" cache "${cache}")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt" "${cache}")
+run_cmake(CacheBinaryMirror3)
+run_cmake_command(CacheBinaryMirrorOff
+  ${CMAKE_COMMAND} -DCMAKE_CACHE_BINARY_MIRROR=OFF .)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
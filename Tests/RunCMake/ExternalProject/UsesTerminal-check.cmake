@@ -66,8 +66,8 @@ if(RunCMake_GENERATOR STREQUAL Ninja)
     return() # console pool not supported on Ninja < 1.5
   endif()
 
-  # Read the Ninja build file
-  set(_build_file "${RunCMake_TEST_BINARY_DIR}/build.ninja")
+  # Read the Ninja build statements of the top directory
+  set(_build_file "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/build.ninja")
 
   if(NOT EXISTS "${_build_file}")
     set(RunCMake_TEST_FAILED "Ninja build file not created")
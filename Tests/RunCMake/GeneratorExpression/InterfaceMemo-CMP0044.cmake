@@ -0,0 +1,24 @@
+enable_language(C)
+
+string(TOLOWER ${CMAKE_C_COMPILER_ID} lc_test)
+if (lc_test STREQUAL CMAKE_C_COMPILER_ID)
+  string(TOUPPER ${CMAKE_C_COMPILER_ID} lc_test)
+endif()
+
+add_library(dep INTERFACE)
+target_compile_definitions(dep INTERFACE Result=$<C_COMPILER_ID:${lc_test}>)
+add_library(mid INTERFACE)
+target_link_libraries(mid INTERFACE dep)
+
+# The value of dep issues a policy warning, so it is not remembered and
+# the warning appears for every use by every consumer, as without the
+# memo.
+add_library(consumer1 STATIC empty.c)
+target_link_libraries(consumer1 PRIVATE mid)
+add_library(consumer2 STATIC empty.c)
+target_link_libraries(consumer2 PRIVATE mid)
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-CMP0044.txt" CONTENT
+"$<TARGET_PROPERTY:consumer1,COMPILE_DEFINITIONS>
+$<TARGET_PROPERTY:consumer2,COMPILE_DEFINITIONS>
+")
@@ -0,0 +1,27 @@
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(configs Debug Release)
+else()
+  set(configs Debug)
+endif()
+
+foreach(config IN LISTS configs)
+  if(config STREQUAL "Debug")
+    set(defs "DEP_DEBUG")
+    set(linked ";DEBUG_ONLY")
+  else()
+    set(defs "DEP_OTHER")
+    set(linked "")
+  endif()
+  foreach(lang C CXX)
+    set(file "${RunCMake_TEST_BINARY_DIR}/InterfaceMemo-Config-${config}-${lang}.txt")
+    if(NOT EXISTS "${file}")
+      string(APPEND RunCMake_TEST_FAILED "Missing\n ${file}\n")
+      continue()
+    endif()
+    file(READ "${file}" content)
+    set(expected "${defs};DEP_${lang}${linked}\n${defs};DEP_${lang}${linked}\n")
+    if(NOT content STREQUAL expected)
+      string(APPEND RunCMake_TEST_FAILED "${file} has content:\n [[${content}]]\nbut expected:\n [[${expected}]]\n")
+    endif()
+  endforeach()
+endforeach()
@@ -0,0 +1,26 @@
+enable_language(C CXX)
+
+add_library(debug INTERFACE)
+target_compile_definitions(debug INTERFACE DEBUG_ONLY)
+
+# The value and the link interface of dep depend on the configuration,
+# and the value also on the language.
+add_library(dep INTERFACE)
+target_compile_definitions(dep INTERFACE
+  "$<$<CONFIG:Debug>:DEP_DEBUG>"
+  "$<$<NOT:$<CONFIG:Debug>>:DEP_OTHER>"
+  "DEP_$<COMPILE_LANGUAGE>"
+  )
+target_link_libraries(dep INTERFACE "$<$<CONFIG:Debug>:debug>")
+add_library(mid INTERFACE)
+target_link_libraries(mid INTERFACE dep)
+
+add_library(consumer1 STATIC empty.c)
+target_link_libraries(consumer1 PRIVATE mid)
+add_library(consumer2 STATIC empty.c)
+target_link_libraries(consumer2 PRIVATE dep)
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-Config-$<CONFIG>-$<COMPILE_LANGUAGE>.txt"
+  CONTENT "$<TARGET_PROPERTY:consumer1,COMPILE_DEFINITIONS>
+$<TARGET_PROPERTY:consumer2,COMPILE_DEFINITIONS>
+")
@@ -0,0 +1,16 @@
+add_library(dep INTERFACE)
+set_property(TARGET dep PROPERTY INTERFACE_COMPILE_DEFINITIONS
+  "$<TARGET_PROPERTY:dep,INTERFACE_COMPILE_DEFINITIONS>")
+add_library(mid INTERFACE)
+target_link_libraries(mid INTERFACE dep)
+
+# Each consumer reports the loop, not only the first.
+add_library(consumer1 INTERFACE)
+target_link_libraries(consumer1 INTERFACE mid)
+add_library(consumer2 INTERFACE)
+target_link_libraries(consumer2 INTERFACE mid)
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-Cycle.txt" CONTENT
+"$<TARGET_PROPERTY:consumer1,INTERFACE_COMPILE_DEFINITIONS>
+$<TARGET_PROPERTY:consumer2,INTERFACE_COMPILE_DEFINITIONS>
+")
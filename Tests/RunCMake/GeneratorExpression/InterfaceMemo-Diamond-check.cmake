@@ -0,0 +1,12 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/InterfaceMemo-Diamond.txt" content)
+
+# The base library is reached on two paths but appears once, where the
+# first path reaches it.
+set(expected "1: TOP;LEFT;BASE;RIGHT
+2: RIGHT;BASE;LEFT
+3: BASE;TOP;LEFT;RIGHT
+4: TOP;LEFT;BASE;RIGHT
+")
+if(NOT content STREQUAL expected)
+  set(RunCMake_TEST_FAILED "actual content:\n [[${content}]]\nbut expected:\n [[${expected}]]")
+endif()
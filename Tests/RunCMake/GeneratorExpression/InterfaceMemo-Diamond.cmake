@@ -0,0 +1,27 @@
+enable_language(C)
+
+add_library(base INTERFACE)
+target_compile_definitions(base INTERFACE BASE)
+add_library(left INTERFACE)
+target_compile_definitions(left INTERFACE LEFT)
+target_link_libraries(left INTERFACE base)
+add_library(right INTERFACE)
+target_compile_definitions(right INTERFACE RIGHT)
+target_link_libraries(right INTERFACE base)
+add_library(top INTERFACE)
+target_compile_definitions(top INTERFACE TOP)
+target_link_libraries(top INTERFACE left right)
+
+add_library(consumer1 STATIC empty.c)
+target_link_libraries(consumer1 PRIVATE top)
+add_library(consumer2 STATIC empty.c)
+target_link_libraries(consumer2 PRIVATE right left)
+add_library(consumer3 STATIC empty.c)
+target_link_libraries(consumer3 PRIVATE base top)
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-Diamond.txt" CONTENT
+"1: $<TARGET_PROPERTY:consumer1,COMPILE_DEFINITIONS>
+2: $<TARGET_PROPERTY:consumer2,COMPILE_DEFINITIONS>
+3: $<TARGET_PROPERTY:consumer3,COMPILE_DEFINITIONS>
+4: $<TARGET_PROPERTY:consumer1,COMPILE_DEFINITIONS>
+")
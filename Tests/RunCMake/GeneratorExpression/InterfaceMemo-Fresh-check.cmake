@@ -0,0 +1,28 @@
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(configs Debug Release)
+else()
+  set(configs Debug)
+endif()
+
+foreach(config IN LISTS configs)
+  set(file "${RunCMake_TEST_BINARY_DIR}/InterfaceMemo-Fresh-${config}.txt")
+  if(NOT EXISTS "${file}")
+    string(APPEND RunCMake_TEST_FAILED "Missing\n ${file}\n")
+    continue()
+  endif()
+  file(STRINGS "${file}" lines)
+  foreach(line IN LISTS lines)
+    if(NOT line MATCHES "^([^:]*): ([^|]*)\\|(.*)$")
+      string(APPEND RunCMake_TEST_FAILED "${file} has bad line:\n ${line}\n")
+      continue()
+    endif()
+    set(consumer "${CMAKE_MATCH_1}")
+    set(remembered "${CMAKE_MATCH_2}")
+    set(fresh "${CMAKE_MATCH_3}")
+    # Without pruning, a target reached again adds its value again.
+    list(REMOVE_DUPLICATES fresh)
+    if(NOT remembered STREQUAL fresh)
+      string(APPEND RunCMake_TEST_FAILED "${consumer} in ${config} has\n [[${remembered}]]\nbut a fresh evaluation gives\n [[${fresh}]]\n")
+    endif()
+  endforeach()
+endforeach()
@@ -0,0 +1,43 @@
+enable_language(C)
+
+# Each library links to the two before it, so the later ones are reached
+# on many paths through diamonds.  Some values and links depend on the
+# configuration or on the consumer.
+foreach(i RANGE 11)
+  add_library(t${i} INTERFACE)
+  target_compile_definitions(t${i} INTERFACE T${i})
+  if(i GREATER 1)
+    math(EXPR a "${i} - 1")
+    math(EXPR b "${i} - 2")
+    target_link_libraries(t${i} INTERFACE t${a} t${b})
+  elseif(i EQUAL 1)
+    target_link_libraries(t${i} INTERFACE t0)
+  endif()
+endforeach()
+target_compile_definitions(t3 INTERFACE $<$<CONFIG:Debug>:T3_DEBUG>)
+target_compile_definitions(t5 INTERFACE
+  $<$<BOOL:$<TARGET_PROPERTY:HEAD_FLAG>>:T5_HEAD>)
+add_library(debug_only INTERFACE)
+target_compile_definitions(debug_only INTERFACE DEBUG_ONLY)
+target_link_libraries(t7 INTERFACE $<$<CONFIG:Debug>:debug_only>)
+
+# A consumer's COMPILE_DEFINITIONS are evaluated through the memo.  Its
+# FRESH property evaluates the same closure under $<TARGET_GENEX_EVAL>,
+# which does not prune the targets seen before and so skips the memo.
+set(lines "")
+foreach(top 11 10 7 4 11)
+  foreach(flag 0 1)
+    set(c consumer_${top}_${flag})
+    if(NOT TARGET ${c})
+      add_library(${c} STATIC empty.c)
+      target_link_libraries(${c} PRIVATE t${top})
+      set_property(TARGET ${c} PROPERTY HEAD_FLAG ${flag})
+      set_property(TARGET ${c} PROPERTY FRESH
+        "$<TARGET_PROPERTY:t${top},INTERFACE_COMPILE_DEFINITIONS>")
+    endif()
+    string(APPEND lines "${c}: $<TARGET_PROPERTY:${c},COMPILE_DEFINITIONS>|$<TARGET_GENEX_EVAL:${c},$<TARGET_PROPERTY:${c},FRESH>>\n")
+  endforeach()
+endforeach()
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-Fresh-$<CONFIG>.txt"
+  CONTENT "${lines}")
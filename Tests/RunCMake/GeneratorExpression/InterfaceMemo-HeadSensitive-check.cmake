@@ -0,0 +1,9 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/InterfaceMemo-HeadSensitive.txt" content)
+
+set(expected "1: FLAVOR_one;CMP0065_1;ONE
+2: FLAVOR_two;CMP0065_0;TWO
+3: FLAVOR_one;CMP0065_0;ONE
+")
+if(NOT content STREQUAL expected)
+  set(RunCMake_TEST_FAILED "actual content:\n [[${content}]]\nbut expected:\n [[${expected}]]")
+endif()
@@ -0,0 +1,37 @@
+enable_language(C)
+
+add_library(one INTERFACE)
+target_compile_definitions(one INTERFACE ONE)
+add_library(two INTERFACE)
+target_compile_definitions(two INTERFACE TWO)
+
+# The value and the link interface of dep depend on the consumer.
+add_library(dep INTERFACE)
+target_compile_definitions(dep INTERFACE
+  "FLAVOR_$<TARGET_PROPERTY:FLAVOR>"
+  "CMP0065_$<TARGET_POLICY:CMP0065>"
+  )
+target_link_libraries(dep INTERFACE
+  "$<$<STREQUAL:$<TARGET_PROPERTY:FLAVOR>,one>:one>"
+  "$<$<STREQUAL:$<TARGET_PROPERTY:FLAVOR>,two>:two>"
+  )
+add_library(mid INTERFACE)
+target_link_libraries(mid INTERFACE dep)
+
+cmake_policy(SET CMP0065 NEW)
+add_library(consumer1 STATIC empty.c)
+set_property(TARGET consumer1 PROPERTY FLAVOR one)
+target_link_libraries(consumer1 PRIVATE mid)
+cmake_policy(SET CMP0065 OLD)
+add_library(consumer2 STATIC empty.c)
+set_property(TARGET consumer2 PROPERTY FLAVOR two)
+target_link_libraries(consumer2 PRIVATE mid)
+add_library(consumer3 STATIC empty.c)
+set_property(TARGET consumer3 PROPERTY FLAVOR one)
+target_link_libraries(consumer3 PRIVATE mid)
+
+file(GENERATE OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/InterfaceMemo-HeadSensitive.txt" CONTENT
+"1: $<TARGET_PROPERTY:consumer1,COMPILE_DEFINITIONS>
+2: $<TARGET_PROPERTY:consumer2,COMPILE_DEFINITIONS>
+3: $<TARGET_PROPERTY:consumer3,COMPILE_DEFINITIONS>
+")
@@ -61,3 +61,16 @@ if(LINKER_SUPPORTS_PDB)
 else()
   run_cmake(NonValidCompiler-TARGET_PDB_FILE)
 endif()
+
+run_cmake(InterfaceMemo-Diamond)
+run_cmake(InterfaceMemo-HeadSensitive)
+run_cmake(InterfaceMemo-Cycle)
+run_cmake(InterfaceMemo-CMP0044)
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(RunCMake_TEST_OPTIONS "-DCMAKE_CONFIGURATION_TYPES=Debug\;Release")
+else()
+  set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug)
+endif()
+run_cmake(InterfaceMemo-Config)
+run_cmake(InterfaceMemo-Fresh)
+unset(RunCMake_TEST_OPTIONS)
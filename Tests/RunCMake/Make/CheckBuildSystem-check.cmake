@@ -0,0 +1,4 @@
+set(manifest "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake.manifest")
+if(NOT EXISTS "${manifest}")
+  set(RunCMake_TEST_FAILED "Manifest not written:\n  ${manifest}")
+endif()
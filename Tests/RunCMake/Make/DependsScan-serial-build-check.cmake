@@ -0,0 +1,20 @@
+# The dependencies scanned on worker threads are the same as those
+# scanned one object file after another.
+foreach(f depend.make depend.internal)
+  set(parallel "${RunCMake_BINARY_DIR}/DependsScan-build/CMakeFiles/DependsScan.dir/${f}")
+  set(serial "${RunCMake_BINARY_DIR}/DependsScan-serial-build/CMakeFiles/DependsScan.dir/${f}")
+  if(NOT EXISTS "${parallel}" OR NOT EXISTS "${serial}")
+    string(APPEND RunCMake_TEST_FAILED "Missing ${f}\n")
+    continue()
+  endif()
+  file(READ "${parallel}" parallel_content)
+  file(READ "${serial}" serial_content)
+  if(NOT parallel_content STREQUAL serial_content)
+    string(APPEND RunCMake_TEST_FAILED
+      "${f} differs:\n [[${parallel_content}]]\nserial:\n [[${serial_content}]]\n")
+  endif()
+  if(NOT serial_content MATCHES "sub/leaf\\.h")
+    string(APPEND RunCMake_TEST_FAILED
+      "${f} does not list sub/leaf.h:\n [[${serial_content}]]\n")
+  endif()
+endforeach()
@@ -0,0 +1,8 @@
+enable_language(C)
+add_library(DependsScan STATIC
+  DependsScan/a.c
+  DependsScan/b.c
+  DependsScan/c.c
+  DependsScan/d.c
+  )
+target_include_directories(DependsScan PRIVATE DependsScan/sub)
@@ -0,0 +1,5 @@
+#include "common.h"
+int a(void)
+{
+  return DEPENDS_SCAN_LEAF;
+}
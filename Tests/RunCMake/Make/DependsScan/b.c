@@ -0,0 +1,5 @@
+#include "nested.h"
+int b(void)
+{
+  return DEPENDS_SCAN_LEAF;
+}
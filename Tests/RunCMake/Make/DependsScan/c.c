@@ -0,0 +1,6 @@
+#include "common.h"
+#include "sub/leaf.h"
+int c(void)
+{
+  return DEPENDS_SCAN_LEAF;
+}
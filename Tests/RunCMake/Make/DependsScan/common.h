@@ -0,0 +1,2 @@
+#include "sub/nested.h"
+#include <stddef.h>
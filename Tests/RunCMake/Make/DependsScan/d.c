@@ -0,0 +1,4 @@
+int d(void)
+{
+  return 0;
+}
@@ -0,0 +1 @@
+#define DEPENDS_SCAN_LEAF 1
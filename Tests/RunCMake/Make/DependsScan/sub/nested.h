@@ -0,0 +1 @@
+#include "leaf.h"
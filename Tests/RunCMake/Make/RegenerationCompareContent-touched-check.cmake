@@ -0,0 +1,3 @@
+if(actual_stdout MATCHES "Generating done")
+  set(RunCMake_TEST_FAILED "Build system regenerated for a dependency whose content did not change.")
+endif()
@@ -0,0 +1,2 @@
+include(${CMAKE_BINARY_DIR}/input.cmake)
+add_custom_target(CustomTarget ALL)
@@ -16,5 +16,70 @@ run_TargetMessages(OFF)
 run_TargetMessages(VAR-ON -DCMAKE_TARGET_MESSAGES=ON)
 run_TargetMessages(VAR-OFF -DCMAKE_TARGET_MESSAGES=OFF)
 
+function(run_CheckBuildSystem)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CheckBuildSystem-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(CheckBuildSystem)
+  run_cmake_command(CheckBuildSystem-build ${CMAKE_COMMAND} --build .)
+
+  # The check reads the manifest instead of the file it was written for.
+  run_cmake_command(CheckBuildSystem-manifest ${CMAKE_COMMAND} -E env VERBOSE=1
+    ${CMAKE_COMMAND} -H${RunCMake_SOURCE_DIR} -B${RunCMake_TEST_BINARY_DIR}
+    --check-build-system CMakeFiles/Makefile.cmake 0)
+
+  # A missing byproduct is found through the manifest.
+  file(REMOVE "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeDirectoryInformation.cmake")
+  run_cmake_command(CheckBuildSystem-missing ${CMAKE_COMMAND} --build .)
+
+  # The manifest is not used once the file it was written for changes.
+  file(APPEND "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/Makefile.cmake"
+    "set(CMAKE_MAKEFILE_PRODUCTS \"missing\")\n")
+  run_cmake_command(CheckBuildSystem-edited ${CMAKE_COMMAND} --build .)
+endfunction()
+run_CheckBuildSystem()
+
+function(run_RegenerationCompareContent)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/RegenerationCompareContent-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  set(RunCMake_TEST_OPTIONS -DCMAKE_REGENERATION_COMPARE_CONTENT=ON)
+  set(input "${RunCMake_TEST_BINARY_DIR}/input.cmake")
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${input}" "set(input 1)\n")
+  run_cmake(RegenerationCompareContent)
+  run_cmake_command(RegenerationCompareContent-build ${CMAKE_COMMAND} --build .)
+
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.125) # handle 1s resolution
+  file(TOUCH "${input}")
+  run_cmake_command(RegenerationCompareContent-touched ${CMAKE_COMMAND} --build .)
+
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.125)
+  file(APPEND "${input}" "set(input 2)\n")
+  run_cmake_command(RegenerationCompareContent-modified ${CMAKE_COMMAND} --build .)
+endfunction()
+run_RegenerationCompareContent()
+
+function(run_DependsScan)
+  set(RunCMake_TEST_NO_CLEAN 1)
+
+  # Without a parallel make each object file may be scanned on a thread.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/DependsScan-build)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(DependsScan)
+  run_cmake_command(DependsScan-build ${CMAKE_COMMAND} --build .)
+
+  # With a parallel make each scan runs serially.
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/DependsScan-serial-build)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  run_cmake(DependsScan)
+  run_cmake_command(DependsScan-serial-build ${CMAKE_COMMAND} --build . -- -j2)
+endfunction()
+if(RunCMake_GENERATOR MATCHES "Unix Makefiles")
+  run_DependsScan()
+endif()
+
 run_cmake(CustomCommandDepfile-ERROR)
 run_cmake(IncludeRegexSubdir)
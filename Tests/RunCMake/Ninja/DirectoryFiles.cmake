@@ -0,0 +1,3 @@
+enable_language(C)
+add_subdirectory(DirectoryFiles/edited edited)
+add_subdirectory(DirectoryFiles/unchanged unchanged)
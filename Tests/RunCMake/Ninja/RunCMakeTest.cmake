@@ -118,6 +118,7 @@ ${ninja_stderr}
     message(FATAL_ERROR
       "top ninja build failed exited with status ${ninja_result}")
   endif()
+  set(ninja_stdout "${ninja_stdout}" PARENT_SCOPE)
 endfunction(run_ninja)
 
 function (run_LooseObjectDepends)
@@ -266,6 +267,46 @@ build build.ninja: RERUN ${escaped_build_ninja_dep} || ${escaped_ninja_output_pa
 
 endfunction(run_sub_cmake)
 
+function(run_DirectoryFiles)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/DirectoryFiles-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(edited_cmake "${RunCMake_TEST_BINARY_DIR}/edited.cmake")
+  set(edited_build_ninja
+    "${RunCMake_TEST_BINARY_DIR}/edited/CMakeFiles/build.ninja")
+  set(unchanged_build_ninja
+    "${RunCMake_TEST_BINARY_DIR}/unchanged/CMakeFiles/build.ninja")
+  set(fs_delay 3) # We assume the system as 1 sec timestamp resolution.
+
+  file(WRITE "${edited_cmake}" "set(EDITED 1)\n")
+  run_cmake(DirectoryFiles)
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+  file(TIMESTAMP "${edited_build_ninja}" mtime_edited_before UTC)
+  file(TIMESTAMP "${unchanged_build_ninja}" mtime_unchanged_before UTC)
+
+  # Regenerate after editing one directory.
+  sleep(${fs_delay})
+  file(WRITE "${edited_cmake}" "set(EDITED 2)\n")
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+  file(TIMESTAMP "${edited_build_ninja}" mtime_edited_after UTC)
+  file(TIMESTAMP "${unchanged_build_ninja}" mtime_unchanged_after UTC)
+
+  if(NOT mtime_edited_after STRGREATER mtime_edited_before)
+    message(FATAL_ERROR
+      "edited/CMakeFiles/build.ninja not regenerated:
+  before = ${mtime_edited_before}
+  after  = ${mtime_edited_after}")
+  endif()
+  if(NOT mtime_unchanged_after STREQUAL mtime_unchanged_before)
+    message(FATAL_ERROR
+      "unchanged/CMakeFiles/build.ninja rewritten:
+  before = ${mtime_unchanged_before}
+  after  = ${mtime_unchanged_after}")
+  endif()
+endfunction()
+run_DirectoryFiles()
+
 if("${ninja_version}" VERSION_LESS 1.6)
   message(WARNING "Ninja is too old; skipping rest of test.")
   return()
@@ -286,3 +327,60 @@ function (run_PreventTargetAliasesDupBuildRule)
   run_ninja("${RunCMake_TEST_BINARY_DIR}" -w dupbuild=err)
 endfunction ()
 run_PreventTargetAliasesDupBuildRule()
+
+if("${ninja_version}" VERSION_LESS 1.8)
+  message(WARNING "Ninja is too old; skipping rest of test.")
+  return()
+endif()
+
+function(run_DirectoryFilesDeleted)
+  set(RunCMake_TEST_BINARY_DIR
+    ${RunCMake_BINARY_DIR}/DirectoryFilesDeleted-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(edited_cmake "${RunCMake_TEST_BINARY_DIR}/edited.cmake")
+  set(unchanged_build_ninja "unchanged/CMakeFiles/build.ninja")
+  set(fs_delay 3) # We assume the system as 1 sec timestamp resolution.
+
+  file(WRITE "${edited_cmake}" "set(EDITED 1)\n")
+  run_cmake(DirectoryFiles)
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+
+  # The directory files are outputs of the statement re-running CMake.
+  execute_process(
+    COMMAND "${RunCMake_MAKE_PROGRAM}" -t query "${unchanged_build_ninja}"
+    WORKING_DIRECTORY "${RunCMake_TEST_BINARY_DIR}"
+    OUTPUT_VARIABLE query_stdout
+    )
+  if(NOT query_stdout MATCHES "input: RERUN_CMAKE")
+    message(FATAL_ERROR
+      "${unchanged_build_ninja} is not an output of RERUN_CMAKE:\n"
+      "${query_stdout}")
+  endif()
+
+  # Ninja cannot load the manifest without it, so re-run CMake.
+  file(REMOVE "${RunCMake_TEST_BINARY_DIR}/${unchanged_build_ninja}")
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} .
+    WORKING_DIRECTORY "${RunCMake_TEST_BINARY_DIR}"
+    OUTPUT_QUIET
+    RESULT_VARIABLE cmake_result
+    )
+  if(NOT cmake_result EQUAL 0 OR
+      NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/${unchanged_build_ninja}")
+    message(FATAL_ERROR "${unchanged_build_ninja} not generated again")
+  endif()
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+
+  # Regenerating from ninja keeps the unchanged directory file older than
+  # the edited input.  That must not re-run CMake on the next build.
+  sleep(${fs_delay})
+  file(WRITE "${edited_cmake}" "set(EDITED 2)\n")
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+  run_ninja("${RunCMake_TEST_BINARY_DIR}")
+  if(NOT ninja_stdout MATCHES "no work to do")
+    message(FATAL_ERROR "Second build not up to date:\n${ninja_stdout}")
+  endif()
+endfunction()
+run_DirectoryFilesDeleted()
@@ -0,0 +1,13 @@
+cmake_policy(SET CMP0053 NEW)
+
+# Arguments evaluated repeatedly must see the current values.
+set(ENV{CMP0053_REPEATED} "env")
+set(CMP0053_REPEATED "cache" CACHE STRING "")
+function(show i)
+  set(name_${i} "n${i}")
+  message("${i}:${name_${i}}:\${i}\t$ENV{CMP0053_REPEATED}:$CACHE{CMP0053_REPEATED}
+line ${CMAKE_CURRENT_LIST_LINE}:${undefined}")
+endfunction()
+foreach(i 1 2 3)
+  show(${i})
+endforeach()
@@ -113,6 +113,7 @@ run_cmake(CMP0053-NameWithEscapedSpacesQuoted)
 run_cmake(CMP0053-NameWithEscapedTabsQuoted)
 run_cmake(CMP0053-Dollar-OLD)
 run_cmake(CMP0053-Dollar-NEW)
+run_cmake(CMP0053-Repeated)
 
 # Variable special types
 run_cmake(QueryCache)
@@ -0,0 +1,33 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/ConfigCache")
+file(REMOVE_RECURSE "${dir}")
+file(MAKE_DIRECTORY "${dir}/prefix/p1")
+file(WRITE "${dir}/prefix/p2/lib/cmake/Foo/FooConfig.cmake" "")
+
+# Directories modified too recently to tell later changes apart are
+# never cached, so date the new ones back.
+file(GLOB_RECURSE dirs LIST_DIRECTORIES true "${dir}/prefix/*")
+list(FILTER dirs EXCLUDE REGEX "\\.cmake$")
+execute_process(COMMAND touch -t 200001010000 "${dir}/prefix" ${dirs}
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Cannot set the time stamps of '${dir}/prefix'.")
+endif()
+
+set(CMAKE_FIND_PACKAGE_CACHE_DIR "${dir}/cache")
+set(CMAKE_PREFIX_PATH "${dir}/prefix/p1" "${dir}/prefix/p2")
+
+find_package(Foo CONFIG)
+message(STATUS "Foo_DIR='${Foo_DIR}'")
+
+# The same search again is answered from the cache.
+unset(Foo_DIR CACHE)
+set(CMAKE_FIND_DEBUG_MODE 1)
+find_package(Foo CONFIG)
+set(CMAKE_FIND_DEBUG_MODE 0)
+message(STATUS "Foo_DIR='${Foo_DIR}'")
+
+# A configuration file added to an earlier prefix is found.
+unset(Foo_DIR CACHE)
+file(WRITE "${dir}/prefix/p1/FooConfig.cmake" "")
+find_package(Foo CONFIG)
+message(STATUS "Foo_DIR='${Foo_DIR}'")
@@ -0,0 +1,20 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/ListingInvalidate")
+file(REMOVE_RECURSE "${dir}")
+file(MAKE_DIRECTORY "${dir}/include")
+
+# A miss reads the directory listing.
+find_path(ListingInvalidate_MISS NAMES written.h touched.h
+  PATHS "${dir}/include" NO_DEFAULT_PATH)
+message(STATUS "ListingInvalidate_MISS='${ListingInvalidate_MISS}'")
+
+# A file written by the configure step must be found afterwards.
+file(WRITE "${dir}/include/written.h" "")
+find_path(ListingInvalidate_WRITTEN NAMES written.h
+  PATHS "${dir}/include" NO_DEFAULT_PATH)
+message(STATUS "ListingInvalidate_WRITTEN='${ListingInvalidate_WRITTEN}'")
+
+# So must a file created by a child process.
+execute_process(COMMAND ${CMAKE_COMMAND} -E touch "${dir}/include/touched.h")
+find_path(ListingInvalidate_TOUCHED NAMES touched.h
+  PATHS "${dir}/include" NO_DEFAULT_PATH)
+message(STATUS "ListingInvalidate_TOUCHED='${ListingInvalidate_TOUCHED}'")
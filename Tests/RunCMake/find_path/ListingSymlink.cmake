@@ -0,0 +1,17 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/ListingSymlink")
+file(REMOVE_RECURSE "${dir}")
+file(MAKE_DIRECTORY "${dir}/inc" "${dir}/real/sub" "${dir}/real/inc")
+file(WRITE "${dir}/real/inc/found.h" "")
+execute_process(COMMAND ${CMAKE_COMMAND} -E create_symlink
+  "${dir}/real/sub" "${dir}/link")
+
+# Read the listing of the directory that "link/../inc" names lexically.
+find_path(ListingSymlink_LEXICAL NAMES inc/found.h
+  PATHS "${dir}" NO_DEFAULT_PATH)
+message(STATUS "ListingSymlink_LEXICAL='${ListingSymlink_LEXICAL}'")
+
+# The search paths are collapsed, but a name may still lead out of a
+# symlink, into the parent of its target rather than the lexical parent.
+find_path(ListingSymlink_PHYSICAL NAMES ../inc/found.h
+  PATHS "${dir}/link" NO_DEFAULT_PATH)
+message(STATUS "ListingSymlink_PHYSICAL='${ListingSymlink_PHYSICAL}'")
@@ -0,0 +1,22 @@
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/ListingSymlinkAlias")
+file(REMOVE_RECURSE "${dir}")
+file(MAKE_DIRECTORY "${dir}/real")
+execute_process(COMMAND ${CMAKE_COMMAND} -E create_symlink
+  "${dir}/real" "${dir}/alias")
+
+# Misses read the listing of the directory through both of its paths.
+find_path(ListingSymlinkAlias_MISS1 NAMES via_real.h
+  PATHS "${dir}/alias" NO_DEFAULT_PATH)
+find_path(ListingSymlinkAlias_MISS2 NAMES via_alias.h
+  PATHS "${dir}/real" NO_DEFAULT_PATH)
+
+# A file written through one path must be found through the other.
+file(WRITE "${dir}/real/via_real.h" "")
+find_path(ListingSymlinkAlias_VIA_REAL NAMES via_real.h
+  PATHS "${dir}/alias" NO_DEFAULT_PATH)
+message(STATUS "ListingSymlinkAlias_VIA_REAL='${ListingSymlinkAlias_VIA_REAL}'")
+
+file(WRITE "${dir}/alias/via_alias.h" "")
+find_path(ListingSymlinkAlias_VIA_ALIAS NAMES via_alias.h
+  PATHS "${dir}/real" NO_DEFAULT_PATH)
+message(STATUS "ListingSymlinkAlias_VIA_ALIAS='${ListingSymlinkAlias_VIA_ALIAS}'")
@@ -1,5 +1,12 @@
 include(RunCMake)
 
+run_cmake(ListingInvalidate)
+
+if(UNIX)
+  run_cmake(ListingSymlink)
+  run_cmake(ListingSymlinkAlias)
+endif()
+
 if(WIN32 OR CYGWIN)
   run_cmake(PrefixInPATH)
 endif()
@@ -0,0 +1,33 @@
+# Check the libraries on the link line of each target.
+function(check_link tgt)
+  cmake_parse_arguments(check "" "" "HAS;LACKS" ${ARGN})
+  set(link_txt "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/${tgt}.dir/link.txt")
+  file(READ "${link_txt}" line)
+  # Drop the output and the object files.
+  string(REGEX REPLACE "^.* -o [^ ]+ " "" libs "${line}")
+  string(REGEX REPLACE "CMakeFiles/[^ ]+" "" libs "${libs}")
+  foreach(lib IN LISTS check_HAS)
+    if(NOT libs MATCHES "${lib}")
+      string(APPEND RunCMake_TEST_FAILED
+        "Target ${tgt} does not link ${lib}:\n  ${libs}\n")
+    endif()
+  endforeach()
+  foreach(lib IN LISTS check_LACKS)
+    if(libs MATCHES "${lib}")
+      string(APPEND RunCMake_TEST_FAILED
+        "Target ${tgt} links ${lib}:\n  ${libs}\n")
+    endif()
+  endforeach()
+  set(RunCMake_TEST_FAILED "${RunCMake_TEST_FAILED}" PARENT_SCOPE)
+endfunction()
+
+check_link(self1 HAS cyc1 LACKS self1)
+check_link(other1 HAS "cyc1.*self1")
+check_link(self2 HAS cyc2 LACKS self2)
+check_link(other2 HAS "cyc2.*self2")
+check_link(head_use1 HAS "head.*extra1" LACKS extra2)
+check_link(head_use2 HAS "head.*extra2" LACKS extra1)
+check_link(old_self HAS plain LACKS old_self)
+check_link(old_other HAS "plain.*old_self")
+check_link(path_use1 HAS "out/libversioned")
+check_link(path_use2 HAS "out/libversioned")
@@ -0,0 +1,51 @@
+cmake_policy(SET CMP0022 NEW)
+enable_language(C)
+
+# Targets in one directory that link the same items share their link
+# dependencies unless the result depends on the target being linked.
+
+# A target skips itself among the items it follows.  Define the target
+# named by the link interface both before and after the other one.
+add_library(cyc1 STATIC empty.c)
+set_property(TARGET cyc1 PROPERTY INTERFACE_LINK_LIBRARIES self1)
+add_library(self1 SHARED empty.c)
+target_link_libraries(self1 PRIVATE cyc1)
+add_library(other1 SHARED empty.c)
+target_link_libraries(other1 PRIVATE cyc1)
+
+add_library(cyc2 STATIC empty.c)
+set_property(TARGET cyc2 PROPERTY INTERFACE_LINK_LIBRARIES self2)
+add_library(other2 SHARED empty.c)
+target_link_libraries(other2 PRIVATE cyc2)
+add_library(self2 SHARED empty.c)
+target_link_libraries(self2 PRIVATE cyc2)
+
+# A link interface depends on a property of the target being linked.
+add_library(extra1 SHARED empty.c)
+add_library(extra2 SHARED empty.c)
+add_library(head STATIC empty.c)
+set_property(TARGET head PROPERTY
+  INTERFACE_LINK_LIBRARIES "$<TARGET_PROPERTY:HEAD_EXTRA>")
+add_library(head_use1 SHARED empty.c)
+set_property(TARGET head_use1 PROPERTY HEAD_EXTRA extra1)
+target_link_libraries(head_use1 PRIVATE head)
+add_library(head_use2 SHARED empty.c)
+set_property(TARGET head_use2 PROPERTY HEAD_EXTRA extra2)
+target_link_libraries(head_use2 PRIVATE head)
+
+# An item that is not a target has old-style dependencies.
+set(plain_LIB_DEPENDS "general;old_self;")
+add_library(old_self SHARED empty.c)
+target_link_libraries(old_self PRIVATE plain)
+add_library(old_other SHARED empty.c)
+target_link_libraries(old_other PRIVATE plain)
+
+# The linked file and the file built have different names.
+add_library(versioned SHARED empty.c)
+set_target_properties(versioned PROPERTIES
+  VERSION 1.2 SOVERSION 1
+  LIBRARY_OUTPUT_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/out")
+add_library(path_use1 SHARED empty.c)
+target_link_libraries(path_use1 PRIVATE versioned)
+add_library(path_use2 SHARED empty.c)
+target_link_libraries(path_use2 PRIVATE versioned)
@@ -13,6 +13,9 @@ run_cmake(CMP0079-link-NEW)
 run_cmake(CMP0079-link-NEW-bogus)
 run_cmake(ImportedTarget)
 run_cmake(ImportedTargetFailure)
+if(RunCMake_GENERATOR STREQUAL "Unix Makefiles")
+  run_cmake(LinkDependsShared)
+endif()
 run_cmake(MixedSignature)
 run_cmake(Separate-PRIVATE-LINK_PRIVATE-uses)
 run_cmake(SharedDepNotTarget)
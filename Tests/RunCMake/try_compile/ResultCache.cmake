@@ -0,0 +1,59 @@
+enable_language(C)
+set(CMAKE_TRY_COMPILE_CACHE_DIR "${CMAKE_CURRENT_BINARY_DIR}/cache")
+file(REMOVE_RECURSE "${CMAKE_TRY_COMPILE_CACHE_DIR}")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/bad.c" "#error bad\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/run.c" [[
+#include <stdio.h>
+int main(void)
+{
+  printf("run output\n");
+  return 3;
+}
+]])
+
+# The second call of each pair finds the result of the first.
+foreach(i 1 2)
+  try_compile(good_${i} ${CMAKE_CURRENT_BINARY_DIR}
+    ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+    OUTPUT_VARIABLE out
+    COPY_FILE ${CMAKE_CURRENT_BINARY_DIR}/copy_${i}
+    )
+  if(NOT good_${i} OR NOT EXISTS "${CMAKE_CURRENT_BINARY_DIR}/copy_${i}")
+    message(FATAL_ERROR "try_compile ${i} of src.c failed:\n${out}")
+  endif()
+
+  try_compile(bad_${i} ${CMAKE_CURRENT_BINARY_DIR}
+    ${CMAKE_CURRENT_BINARY_DIR}/bad.c
+    OUTPUT_VARIABLE out
+    )
+  if(bad_${i} OR NOT out MATCHES "bad")
+    message(FATAL_ERROR "try_compile ${i} of bad.c succeeded:\n${out}")
+  endif()
+
+  try_run(run_${i} compile_${i} ${CMAKE_CURRENT_BINARY_DIR}
+    ${CMAKE_CURRENT_BINARY_DIR}/run.c
+    RUN_OUTPUT_VARIABLE run_out
+    )
+  if(NOT compile_${i} OR NOT run_${i} EQUAL 3 OR
+      NOT run_out STREQUAL "run output\n")
+    message(FATAL_ERROR "try_run ${i} of run.c failed: ${run_${i}}")
+  endif()
+endforeach()
+
+# An entry whose output size runs past its end is not found.
+file(GLOB entries "${CMAKE_TRY_COMPILE_CACHE_DIR}/*")
+foreach(entry IN LISTS entries)
+  if(NOT entry MATCHES "\\.bin$")
+    file(READ "${entry}" content)
+    string(REGEX REPLACE "^(([^\n]*\n)[^\n]*\n[^\n]*\n)[0-9]+\n"
+      "\\14294967295\n" content "${content}")
+    file(WRITE "${entry}" "${content}")
+  endif()
+endforeach()
+try_compile(good_3 ${CMAKE_CURRENT_BINARY_DIR}
+  ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out
+  )
+if(NOT good_3)
+  message(FATAL_ERROR "try_compile 3 of src.c failed:\n${out}")
+endif()
@@ -21,6 +21,7 @@ run_cmake(PlatformVariables)
 run_cmake(WarnDeprecated)
 unset(RunCMake_TEST_OPTIONS)
 
+run_cmake(ResultCache)
 run_cmake(TargetTypeExe)
 run_cmake(TargetTypeInvalid)
 run_cmake(TargetTypeStatic)
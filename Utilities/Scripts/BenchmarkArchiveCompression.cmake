@@ -0,0 +1,164 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Compare the throughput and the compression ratio of the compressions
+# of "cmake -E tar".  A synthetic tree of text and binary files is
+# written to a work directory, compressed once for each mode, and the
+# time taken and the size of each archive are reported.  Time is
+# measured in whole seconds, so choose a SIZE large enough for each mode
+# to take several seconds:
+#
+#   cmake -DSIZE=256 -DTHREADS=0 -P BenchmarkArchiveCompression.cmake
+#
+# WORK    - work directory (default BenchmarkArchiveCompression in the
+#           current directory), removed before the files are written
+# SIZE    - approximate size of the tree in MiB (default 64)
+# MODES   - list of modes among none, gzip, bzip2, xz and zstd (default
+#           all of them; zstd is skipped if no zstd program is found)
+# LEVEL   - compression level, 0 for the default (default 0)
+# THREADS - list of thread counts to run xz with, 0 meaning one per
+#           processor core (default "1;0"); more than one thread needs
+#           a liblzma with the multithreaded encoder
+
+cmake_minimum_required(VERSION 3.12)
+
+if(NOT WORK)
+  set(WORK "${CMAKE_CURRENT_BINARY_DIR}/BenchmarkArchiveCompression")
+endif()
+if(NOT SIZE)
+  set(SIZE 64)
+endif()
+if(NOT MODES)
+  set(MODES none gzip bzip2 xz zstd)
+endif()
+if(NOT LEVEL)
+  set(LEVEL 0)
+endif()
+if(NOT THREADS)
+  set(THREADS 1 0)
+endif()
+
+# Get the size of a file by searching for the last byte.
+function(get_file_size path var)
+  set(high 1)
+  while(1)
+    file(READ "${path}" byte OFFSET ${high} LIMIT 1 HEX)
+    if(byte STREQUAL "")
+      break()
+    endif()
+    math(EXPR high "${high} * 2")
+  endwhile()
+  set(low 0)
+  while(high GREATER low)
+    math(EXPR mid "(${low} + ${high}) / 2")
+    file(READ "${path}" byte OFFSET ${mid} LIMIT 1 HEX)
+    if(byte STREQUAL "")
+      set(high ${mid})
+    else()
+      math(EXPR low "${mid} + 1")
+    endif()
+  endwhile()
+  set(${var} ${low} PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE "${WORK}")
+set(tree "${WORK}/tree")
+
+# Text that compresses well, like sources, and random characters that
+# compress poorly, like object code.  Each file holds 64 KiB.
+set(text "")
+foreach(l RANGE 1 1400)
+  math(EXPR m "${l} % 7")
+  string(APPEND text "  value_${m} = compute(value_${l}, \"line ${l}\");\n")
+endforeach()
+string(SUBSTRING "${text}" 0 65536 text)
+
+math(EXPR files "${SIZE} * 16")
+foreach(f RANGE 1 ${files})
+  math(EXPR d "${f} % 32")
+  math(EXPR binary "${f} % 3")
+  if(binary EQUAL 0)
+    string(RANDOM LENGTH 65536 RANDOM_SEED ${f} data)
+    file(WRITE "${tree}/dir${d}/file${f}.bin" "${data}")
+  else()
+    file(WRITE "${tree}/dir${d}/file${f}.txt" "// file ${f}\n${text}")
+  endif()
+endforeach()
+
+# Measure the uncompressed size with an uncompressed archive.
+execute_process(COMMAND ${CMAKE_COMMAND} -E tar cf "${WORK}/tree.tar" tree
+  WORKING_DIRECTORY "${WORK}")
+get_file_size("${WORK}/tree.tar" total)
+
+find_program(ZSTD_EXECUTABLE zstd)
+
+message(STATUS "mode        threads   seconds   MiB/s    ratio")
+foreach(mode IN LISTS MODES)
+  set(counts 1)
+  set(options "")
+  if(mode STREQUAL "none")
+    set(flags cf)
+  elseif(mode STREQUAL "gzip")
+    set(flags czf)
+  elseif(mode STREQUAL "bzip2")
+    set(flags cjf)
+  elseif(mode STREQUAL "xz")
+    set(flags cJf)
+    set(counts ${THREADS})
+  elseif(mode STREQUAL "zstd")
+    if(NOT ZSTD_EXECUTABLE)
+      message(STATUS "zstd program not found, skipping zstd")
+      continue()
+    endif()
+    set(flags cf)
+    set(options --zstd)
+  else()
+    message(FATAL_ERROR "Unknown mode: ${mode}")
+  endif()
+  if(NOT mode STREQUAL "none" AND LEVEL)
+    list(APPEND options --compression-level=${LEVEL})
+  endif()
+
+  foreach(n IN LISTS counts)
+    set(archive "${WORK}/tree-${mode}-${n}.tar")
+    string(TIMESTAMP start "%s" UTC)
+    execute_process(
+      COMMAND ${CMAKE_COMMAND} -E tar ${flags} "${archive}" ${options}
+              --threads=${n} tree
+      WORKING_DIRECTORY "${WORK}"
+      RESULT_VARIABLE result
+      )
+    string(TIMESTAMP stop "%s" UTC)
+    if(result)
+      message(FATAL_ERROR "Compressing with ${mode} failed: ${result}")
+    endif()
+    get_file_size("${archive}" size)
+
+    math(EXPR sec "${stop} - ${start}")
+    if(sec EQUAL 0)
+      set(rate "-")
+    else()
+      math(EXPR rate "${total} / ${sec} / 1048576")
+    endif()
+    # Print the ratio with two decimals without floating point math.
+    math(EXPR ratio "${total} * 100 / ${size}")
+    math(EXPR ratio_int "${ratio} / 100")
+    math(EXPR ratio_frac "${ratio} % 100")
+    if(ratio_frac LESS 10)
+      set(ratio_frac "0${ratio_frac}")
+    endif()
+    set(line "")
+    foreach(col "${mode}:12" "${n}:10" "${sec}:10" "${rate}:9")
+      string(REGEX REPLACE ":[0-9]+$" "" value "${col}")
+      string(REGEX REPLACE "^.*:" "" width "${col}")
+      string(LENGTH "${value}" len)
+      while(len LESS width)
+        string(APPEND value " ")
+        math(EXPR len "${len} + 1")
+      endwhile()
+      string(APPEND line "${value}")
+    endforeach()
+    string(APPEND line "${ratio_int}.${ratio_frac}")
+    message(STATUS "${line}")
+  endforeach()
+endforeach()
@@ -0,0 +1,50 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure variable lookup through a deep stack of function() scopes.
+# Each call defines a few local variables, reads variables defined at
+# every level of the stack above it, and then recurses.  The innermost
+# call reads all of them repeatedly.  Time the script as a whole:
+#
+#   time cmake -DDEPTH=200 -DREPEAT=10 -P BenchmarkFunctionScopes.cmake
+#
+# DEPTH  - depth of the function() call stack (default 100)
+# REPEAT - number of times the stack is built (default 5)
+# LOOKUPS - variable reads in the innermost scope (default 2000)
+
+cmake_minimum_required(VERSION 3.12)
+
+if(NOT DEPTH)
+  set(DEPTH 100)
+endif()
+if(NOT REPEAT)
+  set(REPEAT 5)
+endif()
+if(NOT LOOKUPS)
+  set(LOOKUPS 2000)
+endif()
+
+# Some globals as a project would have them.
+foreach(i RANGE 200)
+  set(GLOBAL_SETTING_${i} "value of global setting number ${i}")
+endforeach()
+
+function(descend level)
+  set(local_a_${level} "a${level}")
+  set(local_b_${level} "${GLOBAL_SETTING_${level}}")
+  set(sum "${sum}${local_a_${level}}")
+  if(level LESS DEPTH)
+    math(EXPR next "${level} + 1")
+    descend(${next})
+  else()
+    foreach(i RANGE ${LOOKUPS})
+      math(EXPR l "${i} % ${DEPTH}")
+      set(v "${local_a_${l}}${local_b_${l}}${GLOBAL_SETTING_100}${undefined_${l}}")
+    endforeach()
+  endif()
+  set(result_${level} "${sum}" PARENT_SCOPE)
+endfunction()
+
+foreach(r RANGE 1 ${REPEAT})
+  descend(0)
+endforeach()
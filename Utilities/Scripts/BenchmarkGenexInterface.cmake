@@ -0,0 +1,92 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure the evaluation of transitive usage requirements.  A project is
+# written to a work directory with a graph of INTERFACE libraries that
+# link to each other, each with its own include directory and compile
+# definition, and a few libraries whose sources link to the top of the
+# graph.  The project is configured and generated, which evaluates the
+# usage requirements of the graph for every consumer and language:
+#
+#   time cmake -DTARGETS=5000 -P BenchmarkGenexInterface.cmake
+#
+# WORK      - work directory (default BenchmarkGenexInterface in the
+#             current directory), removed before the files are written
+# TARGETS   - number of INTERFACE libraries (default 5000)
+# LINKS     - number of libraries each of them links to (default 3)
+# CONSUMERS - number of libraries with sources (default 20)
+# GENERATOR - generator to use (default Unix Makefiles)
+
+cmake_minimum_required(VERSION 3.12)
+
+if(NOT WORK)
+  set(WORK "${CMAKE_CURRENT_BINARY_DIR}/BenchmarkGenexInterface")
+endif()
+if(NOT TARGETS)
+  set(TARGETS 5000)
+endif()
+if(NOT LINKS)
+  set(LINKS 3)
+endif()
+if(NOT CONSUMERS)
+  set(CONSUMERS 20)
+endif()
+if(NOT GENERATOR)
+  set(GENERATOR "Unix Makefiles")
+endif()
+
+file(REMOVE_RECURSE "${WORK}")
+set(src "${WORK}/src")
+set(bin "${WORK}/bin")
+
+# Library i links to LINKS of the 64 libraries before it, so the graph
+# has no cycles but shares most of its nodes between many paths.
+# Some of the requirements use generator expressions.
+set(content "cmake_minimum_required(VERSION 3.12)
+project(BenchmarkGenexInterface C)
+")
+math(EXPR last "${TARGETS} - 1")
+foreach(i RANGE ${last})
+  string(APPEND content "add_library(iface${i} INTERFACE)
+target_include_directories(iface${i} INTERFACE \${CMAKE_CURRENT_SOURCE_DIR}/include/${i})
+target_compile_definitions(iface${i} INTERFACE IFACE_${i} $<$<CONFIG:Debug>:IFACE_DEBUG_${i}>)
+")
+  set(deps "")
+  foreach(l RANGE 1 ${LINKS})
+    if(i GREATER 0)
+      set(window ${i})
+      if(window GREATER 64)
+        set(window 64)
+      endif()
+      math(EXPR d "${i} - 1 - (${i} * 31 + ${l} * 17) % ${window}")
+      list(APPEND deps iface${d})
+    endif()
+  endforeach()
+  if(deps)
+    list(REMOVE_DUPLICATES deps)
+    string(REPLACE ";" " " deps "${deps}")
+    string(APPEND content
+      "target_link_libraries(iface${i} INTERFACE ${deps})\n")
+  endif()
+endforeach()
+
+math(EXPR last "${CONSUMERS} - 1")
+foreach(c RANGE ${last})
+  math(EXPR top "${TARGETS} - 1 - ${c}")
+  file(WRITE "${src}/consumer${c}.c" "int consumer${c}(void) { return 0; }\n")
+  string(APPEND content "add_library(consumer${c} STATIC consumer${c}.c)
+target_link_libraries(consumer${c} PRIVATE iface${top})
+")
+endforeach()
+file(WRITE "${src}/CMakeLists.txt" "${content}")
+
+file(MAKE_DIRECTORY "${bin}")
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -G "${GENERATOR}" "${src}"
+  WORKING_DIRECTORY "${bin}"
+  OUTPUT_QUIET
+  RESULT_VARIABLE result
+  )
+if(result)
+  message(FATAL_ERROR "Configuring the benchmark project failed: ${result}")
+endif()
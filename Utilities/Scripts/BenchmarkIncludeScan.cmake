@@ -0,0 +1,108 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure the include dependency scanning of the Makefile generators.
+# A synthetic set of large headers that include each other is written
+# to a work directory together with a project whose sources include
+# them.  The project is configured once, and then the dependencies of
+# its target are scanned repeatedly from scratch.  Time the script as a
+# whole and subtract the time taken with REPEAT=0:
+#
+#   time cmake -DHEADERS=1000 -DREPEAT=10 -P BenchmarkIncludeScan.cmake
+#
+# WORK    - work directory (default BenchmarkIncludeScan in the current
+#           directory), removed before the files are written
+# HEADERS - number of headers (default 500)
+# LINES   - lines of code in each header (default 1000)
+# SOURCES - number of sources (default 50)
+# REPEAT  - number of times the dependencies are scanned (default 5)
+
+cmake_minimum_required(VERSION 3.12)
+
+if(NOT WORK)
+  set(WORK "${CMAKE_CURRENT_BINARY_DIR}/BenchmarkIncludeScan")
+endif()
+if(NOT HEADERS)
+  set(HEADERS 500)
+endif()
+if(NOT LINES)
+  set(LINES 1000)
+endif()
+if(NOT SOURCES)
+  set(SOURCES 50)
+endif()
+if(NOT DEFINED REPEAT)
+  set(REPEAT 5)
+endif()
+
+file(REMOVE_RECURSE "${WORK}")
+set(src "${WORK}/src")
+set(bin "${WORK}/bin")
+
+# The body shared by all headers looks like typical code.  Only a few
+# of its lines start with a preprocessor directive.
+set(body "")
+foreach(l RANGE 1 ${LINES})
+  math(EXPR m "${l} % 50")
+  if(m EQUAL 0)
+    string(APPEND body "#define VALUE_${l} ${l} /* # not a directive */\n")
+  else()
+    string(APPEND body "  int value_${l} = compute(\"#${l}\", ${l}); // %d\n")
+  endif()
+endforeach()
+
+math(EXPR last "${HEADERS} - 1")
+foreach(h RANGE ${last})
+  set(content "#ifndef HEADER_${h}_H\n#define HEADER_${h}_H\n")
+  foreach(step 1 7 31)
+    math(EXPR i "(${h} * 13 + ${step}) % ${HEADERS}")
+    string(APPEND content "#include \"header${i}.h\"\n")
+  endforeach()
+  string(APPEND content "#include <stdio.h>\n${body}#endif\n")
+  math(EXPR d "${h} % 10")
+  file(WRITE "${src}/include${d}/header${h}.h" "${content}")
+endforeach()
+
+set(sources "")
+math(EXPR last "${SOURCES} - 1")
+foreach(s RANGE ${last})
+  math(EXPR i "(${s} * 17) % ${HEADERS}")
+  file(WRITE "${src}/source${s}.c"
+    "#include \"header${i}.h\"\nint source${s}(void) { return 0; }\n")
+  list(APPEND sources source${s}.c)
+endforeach()
+
+string(REPLACE ";" " " sources "${sources}")
+file(WRITE "${src}/CMakeLists.txt" "cmake_minimum_required(VERSION 3.12)
+project(BenchmarkIncludeScan C)
+foreach(d RANGE 9)
+  include_directories(include\${d})
+endforeach()
+add_library(bench STATIC ${sources})
+")
+
+file(MAKE_DIRECTORY "${bin}")
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -G "Unix Makefiles" "${src}"
+  WORKING_DIRECTORY "${bin}"
+  OUTPUT_QUIET
+  RESULT_VARIABLE result
+  )
+if(result)
+  message(FATAL_ERROR "Configuring the benchmark project failed: ${result}")
+endif()
+
+set(dir "${bin}/CMakeFiles/bench.dir")
+foreach(r RANGE 1 ${REPEAT})
+  file(REMOVE "${dir}/depend.internal" "${dir}/C.includecache")
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} -E cmake_depends "Unix Makefiles"
+            "${src}" "${src}" "${bin}" "${bin}" "${dir}/DependInfo.cmake"
+    WORKING_DIRECTORY "${bin}"
+    OUTPUT_QUIET
+    RESULT_VARIABLE result
+    )
+  if(result)
+    message(FATAL_ERROR "Scanning dependencies failed: ${result}")
+  endif()
+endforeach()
@@ -0,0 +1,98 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+# Measure the computation of link dependencies.  A project is written to
+# a work directory with a graph of STATIC libraries that link to each
+# other and to a few outside libraries, and with executables that link
+# to the top of the graph.  The project is configured and generated,
+# which computes the full link line of every executable:
+#
+#   time cmake -DLIBRARIES=2000 -P BenchmarkLinkDepends.cmake
+#
+# WORK        - work directory (default BenchmarkLinkDepends in the
+#               current directory), removed before the files are written
+# LIBRARIES   - number of STATIC libraries (default 1000)
+# LINKS       - number of libraries each of them links to (default 3)
+# EXTERNALS   - number of outside libraries linked by name (default 10)
+# EXECUTABLES - number of executables (default 20)
+# GENERATOR   - generator to use (default Unix Makefiles)
+
+cmake_minimum_required(VERSION 3.12)
+
+if(NOT WORK)
+  set(WORK "${CMAKE_CURRENT_BINARY_DIR}/BenchmarkLinkDepends")
+endif()
+if(NOT LIBRARIES)
+  set(LIBRARIES 1000)
+endif()
+if(NOT LINKS)
+  set(LINKS 3)
+endif()
+if(NOT EXTERNALS)
+  set(EXTERNALS 10)
+endif()
+if(NOT EXECUTABLES)
+  set(EXECUTABLES 20)
+endif()
+if(NOT GENERATOR)
+  set(GENERATOR "Unix Makefiles")
+endif()
+
+file(REMOVE_RECURSE "${WORK}")
+set(src "${WORK}/src")
+set(bin "${WORK}/bin")
+
+# Library i links to LINKS of the 64 libraries before it, so the graph
+# has no cycles but shares most of its nodes between many paths.  Every
+# 100th library also links to an outside library, whose dependencies
+# are not known and must be inferred.
+file(WRITE "${src}/lib.c" "int lib(void) { return 0; }\n")
+file(WRITE "${src}/main.c" "int main(void) { return 0; }\n")
+set(content "cmake_minimum_required(VERSION 3.12)
+project(BenchmarkLinkDepends C)
+")
+math(EXPR last "${LIBRARIES} - 1")
+foreach(i RANGE ${last})
+  string(APPEND content "add_library(lib${i} STATIC lib.c)\n")
+  set(deps "")
+  foreach(l RANGE 1 ${LINKS})
+    if(i GREATER 0)
+      set(window ${i})
+      if(window GREATER 64)
+        set(window 64)
+      endif()
+      math(EXPR d "${i} - 1 - (${i} * 31 + ${l} * 17) % ${window}")
+      list(APPEND deps lib${d})
+    endif()
+  endforeach()
+  math(EXPR external "${i} % 100")
+  if(external EQUAL 0 AND EXTERNALS GREATER 0)
+    math(EXPR e "${i} / 100 % ${EXTERNALS}")
+    list(APPEND deps ext${e})
+  endif()
+  if(deps)
+    list(REMOVE_DUPLICATES deps)
+    string(REPLACE ";" " " deps "${deps}")
+    string(APPEND content "target_link_libraries(lib${i} ${deps})\n")
+  endif()
+endforeach()
+
+math(EXPR last "${EXECUTABLES} - 1")
+foreach(x RANGE ${last})
+  math(EXPR top "${LIBRARIES} - 1 - ${x}")
+  string(APPEND content "add_executable(exe${x} main.c)
+target_link_libraries(exe${x} lib${top})
+")
+endforeach()
+file(WRITE "${src}/CMakeLists.txt" "${content}")
+
+file(MAKE_DIRECTORY "${bin}")
+execute_process(
+  COMMAND ${CMAKE_COMMAND} -G "${GENERATOR}" "${src}"
+  WORKING_DIRECTORY "${bin}"
+  OUTPUT_QUIET
+  RESULT_VARIABLE result
+  )
+if(result)
+  message(FATAL_ERROR "Configuring the benchmark project failed: ${result}")
+endif()